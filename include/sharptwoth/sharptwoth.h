@@ -13,12 +13,16 @@
 #ifndef SHARP2TH_H
 #define SHARP2TH_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Scatter/gather segment (declared by <sys/uio.h> on POSIX systems)
+struct iovec;
+
 // ShaType
 // Enum indicating which secure hash algorithm to compute for master sha() function
 //
@@ -52,6 +56,11 @@ typedef enum {
 //   UNSUPPORTED_DATA_SIZE  Input data too large (SHA-1/SHA-256/SHA-224)
 //   NULL_MESSAGE_POINTER   Pointer to input data is NULL (length indicated as > 0)
 //   NULL_DIGEST_POINTER    Pointer to output buffer is NULL
+//   NULL_CONTEXT_POINTER   Pointer to streaming context is NULL
+//   UNSUPPORTED_BACKEND    Unrecognized backend, or one the host CPU cannot run
+//   INVALID_CONTEXT_STATE  Exported context is malformed, from another format version, or for another algorithm
+//   DIGEST_MISMATCH        Computed digest differs from the expected one passed to a verify function
+//   MALFORMED_ENCODING     Encoded digest passed to sha_decode() is not valid in the given format
 
 typedef enum {
 
@@ -60,7 +69,12 @@ typedef enum {
     INVALID_DIGEST_FORMAT   = 2,
     UNSUPPORTED_DATA_SIZE   = 3,
     NULL_MESSAGE_POINTER    = 4,
-    NULL_DIGEST_POINTER     = 5
+    NULL_DIGEST_POINTER     = 5,
+    NULL_CONTEXT_POINTER    = 6,
+    UNSUPPORTED_BACKEND     = 7,
+    INVALID_CONTEXT_STATE   = 8,
+    DIGEST_MISMATCH         = 9,
+    MALFORMED_ENCODING      = 10
 
 } ShaComputationResult;
 
@@ -71,15 +85,43 @@ typedef enum {
 //   OCTET_ARRAY        Digest represented without encoding
 //   HEX_STRING_LOWER   Lowercase hex encoding of digest (null-terminated)
 //   HEX_STRING_UPPER   Uppercase hex encoding of digest (null-terminated)
+//   BASE64             Base64 encoding of digest with '=' padding, as in SRI strings (null-terminated)
+//   BASE64URL          URL-safe base64 encoding of digest without padding, as in tokens (null-terminated)
+//
+// Text formats need sha_encoded_size() bytes per digest, terminator included
 
 typedef enum {
 
     OCTET_ARRAY         = 0,
     HEX_STRING_LOWER    = 1,
-    HEX_STRING_UPPER    = 2
+    HEX_STRING_UPPER    = 2,
+    BASE64              = 3,
+    BASE64URL           = 4
 
 } ShaDigestFormat;
 
+// ShaBackend
+// Enum naming a set of compression kernels for sha_set_backend()
+//
+// Values:
+//   BACKEND_AUTO       Fastest kernels the host supports (default)
+//   BACKEND_SCALAR     Portable C kernels only
+//   BACKEND_SSSE3      SSSE3 message schedule for SHA-1/SHA-224/SHA-256
+//   BACKEND_AVX2       AVX2 message schedule for the SHA-512 family, 8-lane SHA-1/SHA-224/SHA-256 batches
+//   BACKEND_AVX512     8-lane SHA-512 family batches
+//   BACKEND_SHA_NI     Intel SHA extensions for SHA-1/SHA-224/SHA-256
+
+typedef enum {
+
+    BACKEND_AUTO        = 0,
+    BACKEND_SCALAR      = 1,
+    BACKEND_SSSE3       = 2,
+    BACKEND_AVX2        = 3,
+    BACKEND_AVX512      = 4,
+    BACKEND_SHA_NI      = 5
+
+} ShaBackend;
+
 // hasher_t
 // Function-pointer type that matches the non-generic hashing functions' signatures
 typedef ShaComputationResult (* hasher_t)(
@@ -99,7 +141,7 @@ typedef ShaComputationResult (* hasher_t)(
 //     digest       Pointer to destination buffer for hash digest
 //     message      Pointer to input data
 //     message_len  Number of bytes in input data (cannot be greater than 2^61)
-//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
 
 ShaComputationResult
 sha1(
@@ -119,7 +161,7 @@ sha1(
 //     digest       Pointer to destination buffer for hash digest
 //     message      Pointer to input data
 //     message_len  Number of bytes in input data (cannot be greater than 2^61)
-//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
 
 ShaComputationResult
 sha224(
@@ -139,7 +181,7 @@ sha224(
 //     digest       Pointer to destination buffer for hash digest
 //     message      Pointer to input data
 //     message_len  Number of bytes in input data (cannot be greater than 2^61)
-//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
 
 ShaComputationResult
 sha256(
@@ -159,7 +201,7 @@ sha256(
 //     digest       Pointer to destination buffer for hash digest
 //     message      Pointer to input data
 //     message_len  Number of bytes in input data
-//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
 
 ShaComputationResult
 sha384(
@@ -179,7 +221,7 @@ sha384(
 //     digest       Pointer to destination buffer for hash digest
 //     message      Pointer to input data
 //     message_len  Number of bytes in input data
-//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
 
 ShaComputationResult
 sha512(
@@ -199,7 +241,7 @@ sha512(
 //     digest       Pointer to destination buffer for hash digest
 //     message      Pointer to input data
 //     message_len  Number of bytes in input data
-//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
 
 ShaComputationResult
 sha512_224(
@@ -219,7 +261,7 @@ sha512_224(
 //     digest       Pointer to destination buffer for hash digest
 //     message      Pointer to input data
 //     message_len  Number of bytes in input data
-//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
 
 ShaComputationResult
 sha512_256(
@@ -239,7 +281,7 @@ sha512_256(
 //     digest       Pointer to destination buffer for hash digest
 //     message      Pointer to input data
 //     message_len  Number of bytes in input data
-//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
 
 ShaComputationResult
 sha(
@@ -263,6 +305,15 @@ sha(
 #define SHA512_224_DIGEST_LEN   28
 #define SHA512_256_DIGEST_LEN   32
 
+// Message-block lengths in bytes
+#define SHA1_BLOCK_LEN          64
+#define SHA224_BLOCK_LEN        64
+#define SHA256_BLOCK_LEN        64
+#define SHA384_BLOCK_LEN        128
+#define SHA512_BLOCK_LEN        128
+#define SHA512_224_BLOCK_LEN    128
+#define SHA512_256_BLOCK_LEN    128
+
 // Data size limits (roughly 16,777,215 TiB for SHA-1/SHA-224/SHA-256)
 // Can't possibly reach this limit with in-memory buffer
 // (But a bad length calculation may still be caught)
@@ -270,12 +321,2667 @@ sha(
 #define SHA224_MAX_MSG_LEN  UINT64_C(0x1fffffffffffffff)
 #define SHA256_MAX_MSG_LEN  UINT64_C(0x1fffffffffffffff)
 
+// Exported streaming-context lengths in bytes (see Checkpoint Interface)
+#define SHA1_STATE_LEN          100
+#define SHA224_STATE_LEN        112
+#define SHA256_STATE_LEN        112
+#define SHA384_STATE_LEN        208
+#define SHA512_STATE_LEN        208
+#define SHA512_224_STATE_LEN    208
+#define SHA512_256_STATE_LEN    208
+
 // Note:
 // Limitations on memory apply even more so to max lengths for SHA-384, SHA-512, and SHA-512/T
 // Max data length for these algorithms is 2^128 - 1 bits
 // This library handles data lengths with unsigned 64-bit integers (max value = 2^64-1)
 // So there is no need to define data limits for these algorithms
 
+//=====================//
+// Streaming Interface //
+//=====================//
+
+// sha1_ctx
+// Caller-allocated state for an in-progress SHA-1 computation
+//
+// Members:
+//   hash_words   Chaining value after the last compressed block
+//   message_len  Total number of bytes passed to sha1_update() so far
+//   buffer       Bytes of a partial block awaiting more input
+
+typedef struct sha1_ctx
+{
+    uint32_t hash_words[5];
+    uint64_t message_len;
+    uint8_t buffer[SHA1_BLOCK_LEN];
+
+} sha1_ctx;
+
+// sha256_ctx
+// Caller-allocated state for an in-progress SHA-224 or SHA-256 computation
+//
+// Members:
+//   hash_words   Chaining value after the last compressed block
+//   message_len  Total number of bytes passed to the update function so far
+//   buffer       Bytes of a partial block awaiting more input
+//   digest_len   Number of digest bytes produced by the final function
+
+typedef struct sha256_ctx
+{
+    uint32_t hash_words[8];
+    uint64_t message_len;
+    uint8_t buffer[SHA256_BLOCK_LEN];
+    uint8_t digest_len;
+
+} sha256_ctx;
+
+// sha512_ctx
+// Caller-allocated state for an in-progress SHA-384, SHA-512 or SHA-512/t computation
+//
+// Members:
+//   hash_words   Chaining value after the last compressed block
+//   message_len  Total number of bytes passed to the update function so far
+//   buffer       Bytes of a partial block awaiting more input
+//   digest_len   Number of digest bytes produced by the final function
+
+typedef struct sha512_ctx
+{
+    uint64_t hash_words[8];
+    uint64_t message_len;
+    uint8_t buffer[SHA512_BLOCK_LEN];
+    uint8_t digest_len;
+
+} sha512_ctx;
+
+// Algorithms that share a compression function share a context layout
+typedef sha256_ctx sha224_ctx;
+typedef sha512_ctx sha384_ctx;
+typedef sha512_ctx sha512_224_ctx;
+typedef sha512_ctx sha512_256_ctx;
+
+// sha1_init()
+// Prepares a context for a new SHA-1 computation
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER if context is NULL
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+
+ShaComputationResult
+sha1_init(sha1_ctx * context);
+
+// sha1_update()
+// Absorbs the next chunk of message input into a SHA-1 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha1_init()
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk (total cannot be greater than 2^61)
+
+ShaComputationResult
+sha1_update(
+    sha1_ctx * context,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha1_final()
+// Pads the absorbed input and writes the SHA-1 hash digest
+// (The context must be passed to sha1_init() again before reuse)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha1_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha1_final(
+    sha1_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha224_init()
+// Prepares a context for a new SHA-224 computation
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER if context is NULL
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+
+ShaComputationResult
+sha224_init(sha224_ctx * context);
+
+// sha224_update()
+// Absorbs the next chunk of message input into a SHA-224 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha224_init()
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk (total cannot be greater than 2^61)
+
+ShaComputationResult
+sha224_update(
+    sha224_ctx * context,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha224_final()
+// Pads the absorbed input and writes the SHA-224 hash digest
+// (The context must be passed to sha224_init() again before reuse)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha224_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha224_final(
+    sha224_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha256_init()
+// Prepares a context for a new SHA-256 computation
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER if context is NULL
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+
+ShaComputationResult
+sha256_init(sha256_ctx * context);
+
+// sha256_update()
+// Absorbs the next chunk of message input into a SHA-256 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha256_init()
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk (total cannot be greater than 2^61)
+
+ShaComputationResult
+sha256_update(
+    sha256_ctx * context,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha256_final()
+// Pads the absorbed input and writes the SHA-256 hash digest
+// (The context must be passed to sha256_init() again before reuse)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha256_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha256_final(
+    sha256_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha384_init()
+// Prepares a context for a new SHA-384 computation
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER if context is NULL
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+
+ShaComputationResult
+sha384_init(sha384_ctx * context);
+
+// sha384_update()
+// Absorbs the next chunk of message input into a SHA-384 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha384_init()
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk
+
+ShaComputationResult
+sha384_update(
+    sha384_ctx * context,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha384_final()
+// Pads the absorbed input and writes the SHA-384 hash digest
+// (The context must be passed to sha384_init() again before reuse)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha384_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha384_final(
+    sha384_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha512_init()
+// Prepares a context for a new SHA-512 computation
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER if context is NULL
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+
+ShaComputationResult
+sha512_init(sha512_ctx * context);
+
+// sha512_update()
+// Absorbs the next chunk of message input into a SHA-512 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_init()
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk
+
+ShaComputationResult
+sha512_update(
+    sha512_ctx * context,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha512_final()
+// Pads the absorbed input and writes the SHA-512 hash digest
+// (The context must be passed to sha512_init() again before reuse)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_final(
+    sha512_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha512_224_init()
+// Prepares a context for a new SHA-512/224 computation
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER if context is NULL
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+
+ShaComputationResult
+sha512_224_init(sha512_224_ctx * context);
+
+// sha512_224_update()
+// Absorbs the next chunk of message input into a SHA-512/224 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_224_init()
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk
+
+ShaComputationResult
+sha512_224_update(
+    sha512_224_ctx * context,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha512_224_final()
+// Pads the absorbed input and writes the SHA-512/224 hash digest
+// (The context must be passed to sha512_224_init() again before reuse)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_224_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_224_final(
+    sha512_224_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha512_256_init()
+// Prepares a context for a new SHA-512/256 computation
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER if context is NULL
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+
+ShaComputationResult
+sha512_256_init(sha512_256_ctx * context);
+
+// sha512_256_update()
+// Absorbs the next chunk of message input into a SHA-512/256 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_256_init()
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk
+
+ShaComputationResult
+sha512_256_update(
+    sha512_256_ctx * context,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha512_256_final()
+// Pads the absorbed input and writes the SHA-512/256 hash digest
+// (The context must be passed to sha512_256_init() again before reuse)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_256_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_256_final(
+    sha512_256_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+//=================//
+// Batch Interface //
+//=================//
+
+// sha1_batch()
+// Computes SHA-1 hash digests for many independent messages at once
+// (messages are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA1_DIGEST_LEN, format) bytes each)
+//     messages     Array of count pointers to input data
+//     message_lens Array of count input lengths in bytes (each cannot be greater than 2^61)
+//     count        Number of messages
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha1_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha224_batch()
+// Computes SHA-224 hash digests for many independent messages at once
+// (messages are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA224_DIGEST_LEN, format) bytes each)
+//     messages     Array of count pointers to input data
+//     message_lens Array of count input lengths in bytes (each cannot be greater than 2^61)
+//     count        Number of messages
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha224_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha256_batch()
+// Computes SHA-256 hash digests for many independent messages at once
+// (messages are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA256_DIGEST_LEN, format) bytes each)
+//     messages     Array of count pointers to input data
+//     message_lens Array of count input lengths in bytes (each cannot be greater than 2^61)
+//     count        Number of messages
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha256_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha384_batch()
+// Computes SHA-384 hash digests for many independent messages at once
+// (messages are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA384_DIGEST_LEN, format) bytes each)
+//     messages     Array of count pointers to input data
+//     message_lens Array of count input lengths in bytes
+//     count        Number of messages
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha384_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha512_batch()
+// Computes SHA-512 hash digests for many independent messages at once
+// (messages are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA512_DIGEST_LEN, format) bytes each)
+//     messages     Array of count pointers to input data
+//     message_lens Array of count input lengths in bytes
+//     count        Number of messages
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha512_224_batch()
+// Computes SHA-512/224 hash digests for many independent messages at once
+// (messages are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA512_224_DIGEST_LEN, format) bytes each)
+//     messages     Array of count pointers to input data
+//     message_lens Array of count input lengths in bytes
+//     count        Number of messages
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_224_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha512_256_batch()
+// Computes SHA-512/256 hash digests for many independent messages at once
+// (messages are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA512_256_DIGEST_LEN, format) bytes each)
+//     messages     Array of count pointers to input data
+//     message_lens Array of count input lengths in bytes
+//     count        Number of messages
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_256_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha_batch()
+// Generic batch function for which the caller specifies the SHA-X algorithm to compute,
+// with a status per message (messages are grouped by length so SIMD lanes stay full;
+// digests still land in message order)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (with statuses, the status of the first message that failed; messages that
+//     fail leave their digest slot untouched and do not stop the others)
+//
+// Parameters:
+//     algorithm    Enum indicating the algorithm to compute
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(digest length, format) bytes each)
+//     messages     Array of count pointers to input data
+//     message_lens Array of count input lengths in bytes
+//     count        Number of messages
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+//     statuses     Array receiving count per-message results (NULL to validate the whole
+//                  batch up front, as the per-algorithm batch functions do)
+
+ShaComputationResult
+sha_batch(
+    ShaType algorithm,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format,
+    ShaComputationResult * statuses
+);
+
+//======================//
+// Checkpoint Interface //
+//======================//
+
+// Exported context layout (version 1; multi-byte fields big-endian)
+//
+//   Offset  Length      Field
+//   0       4           Magic bytes "S2TH"
+//   4       1           Format version (SHA_STATE_VERSION)
+//   5       1           ShaType of the algorithm
+//   6       2           Reserved (zero)
+//   8       8           Total number of bytes absorbed so far
+//   16      4 or 8 * n  Chaining value, one big-endian word at a time
+//   ...     block len   Partial block awaiting more input (zero past its end)
+//
+// The layout does not depend on the host's byte order or struct padding, so a
+// context exported on one machine can be imported on any other
+
+#define SHA_STATE_VERSION 1
+
+// sha1_peek()
+// Writes the SHA-1 hash digest of the input absorbed so far without finalizing
+// (the context is left as it was, so updates may continue afterwards)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha1_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha1_peek(
+    const sha1_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha1_export()
+// Serializes an in-progress SHA-1 context so it can be resumed later
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER or NULL_DIGEST_POINTER for NULL arguments
+//
+// Parameters:
+//     context      Pointer to context prepared by sha1_init()
+//     state        Pointer to destination buffer of SHA1_STATE_LEN bytes
+
+ShaComputationResult
+sha1_export(
+    const sha1_ctx * context,
+    uint8_t * state
+);
+
+// sha1_import()
+// Restores a SHA-1 context from the output of sha1_export()
+// (on failure the context is left untouched)
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+//     state        Pointer to exported context
+//     state_len    Number of bytes in exported context (must be SHA1_STATE_LEN)
+
+ShaComputationResult
+sha1_import(
+    sha1_ctx * context,
+    const uint8_t * state,
+    const size_t state_len
+);
+
+// sha224_peek()
+// Writes the SHA-224 hash digest of the input absorbed so far without finalizing
+// (the context is left as it was, so updates may continue afterwards)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha224_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha224_peek(
+    const sha224_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha224_export()
+// Serializes an in-progress SHA-224 context so it can be resumed later
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER or NULL_DIGEST_POINTER for NULL arguments
+//
+// Parameters:
+//     context      Pointer to context prepared by sha224_init()
+//     state        Pointer to destination buffer of SHA224_STATE_LEN bytes
+
+ShaComputationResult
+sha224_export(
+    const sha224_ctx * context,
+    uint8_t * state
+);
+
+// sha224_import()
+// Restores a SHA-224 context from the output of sha224_export()
+// (on failure the context is left untouched)
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+//     state        Pointer to exported context
+//     state_len    Number of bytes in exported context (must be SHA224_STATE_LEN)
+
+ShaComputationResult
+sha224_import(
+    sha224_ctx * context,
+    const uint8_t * state,
+    const size_t state_len
+);
+
+// sha256_peek()
+// Writes the SHA-256 hash digest of the input absorbed so far without finalizing
+// (the context is left as it was, so updates may continue afterwards)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha256_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha256_peek(
+    const sha256_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha256_export()
+// Serializes an in-progress SHA-256 context so it can be resumed later
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER or NULL_DIGEST_POINTER for NULL arguments
+//
+// Parameters:
+//     context      Pointer to context prepared by sha256_init()
+//     state        Pointer to destination buffer of SHA256_STATE_LEN bytes
+
+ShaComputationResult
+sha256_export(
+    const sha256_ctx * context,
+    uint8_t * state
+);
+
+// sha256_import()
+// Restores a SHA-256 context from the output of sha256_export()
+// (on failure the context is left untouched)
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+//     state        Pointer to exported context
+//     state_len    Number of bytes in exported context (must be SHA256_STATE_LEN)
+
+ShaComputationResult
+sha256_import(
+    sha256_ctx * context,
+    const uint8_t * state,
+    const size_t state_len
+);
+
+// sha384_peek()
+// Writes the SHA-384 hash digest of the input absorbed so far without finalizing
+// (the context is left as it was, so updates may continue afterwards)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha384_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha384_peek(
+    const sha384_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha384_export()
+// Serializes an in-progress SHA-384 context so it can be resumed later
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER or NULL_DIGEST_POINTER for NULL arguments
+//
+// Parameters:
+//     context      Pointer to context prepared by sha384_init()
+//     state        Pointer to destination buffer of SHA384_STATE_LEN bytes
+
+ShaComputationResult
+sha384_export(
+    const sha384_ctx * context,
+    uint8_t * state
+);
+
+// sha384_import()
+// Restores a SHA-384 context from the output of sha384_export()
+// (on failure the context is left untouched)
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+//     state        Pointer to exported context
+//     state_len    Number of bytes in exported context (must be SHA384_STATE_LEN)
+
+ShaComputationResult
+sha384_import(
+    sha384_ctx * context,
+    const uint8_t * state,
+    const size_t state_len
+);
+
+// sha512_peek()
+// Writes the SHA-512 hash digest of the input absorbed so far without finalizing
+// (the context is left as it was, so updates may continue afterwards)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_peek(
+    const sha512_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha512_export()
+// Serializes an in-progress SHA-512 context so it can be resumed later
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER or NULL_DIGEST_POINTER for NULL arguments
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_init()
+//     state        Pointer to destination buffer of SHA512_STATE_LEN bytes
+
+ShaComputationResult
+sha512_export(
+    const sha512_ctx * context,
+    uint8_t * state
+);
+
+// sha512_import()
+// Restores a SHA-512 context from the output of sha512_export()
+// (on failure the context is left untouched)
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+//     state        Pointer to exported context
+//     state_len    Number of bytes in exported context (must be SHA512_STATE_LEN)
+
+ShaComputationResult
+sha512_import(
+    sha512_ctx * context,
+    const uint8_t * state,
+    const size_t state_len
+);
+
+// sha512_224_peek()
+// Writes the SHA-512/224 hash digest of the input absorbed so far without finalizing
+// (the context is left as it was, so updates may continue afterwards)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_224_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_224_peek(
+    const sha512_224_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha512_224_export()
+// Serializes an in-progress SHA-512/224 context so it can be resumed later
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER or NULL_DIGEST_POINTER for NULL arguments
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_224_init()
+//     state        Pointer to destination buffer of SHA512_224_STATE_LEN bytes
+
+ShaComputationResult
+sha512_224_export(
+    const sha512_224_ctx * context,
+    uint8_t * state
+);
+
+// sha512_224_import()
+// Restores a SHA-512/224 context from the output of sha512_224_export()
+// (on failure the context is left untouched)
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+//     state        Pointer to exported context
+//     state_len    Number of bytes in exported context (must be SHA512_224_STATE_LEN)
+
+ShaComputationResult
+sha512_224_import(
+    sha512_224_ctx * context,
+    const uint8_t * state,
+    const size_t state_len
+);
+
+// sha512_256_peek()
+// Writes the SHA-512/256 hash digest of the input absorbed so far without finalizing
+// (the context is left as it was, so updates may continue afterwards)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_256_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_256_peek(
+    const sha512_256_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// sha512_256_export()
+// Serializes an in-progress SHA-512/256 context so it can be resumed later
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER or NULL_DIGEST_POINTER for NULL arguments
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_256_init()
+//     state        Pointer to destination buffer of SHA512_256_STATE_LEN bytes
+
+ShaComputationResult
+sha512_256_export(
+    const sha512_256_ctx * context,
+    uint8_t * state
+);
+
+// sha512_256_import()
+// Restores a SHA-512/256 context from the output of sha512_256_export()
+// (on failure the context is left untouched)
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to caller-allocated context
+//     state        Pointer to exported context
+//     state_len    Number of bytes in exported context (must be SHA512_256_STATE_LEN)
+
+ShaComputationResult
+sha512_256_import(
+    sha512_256_ctx * context,
+    const uint8_t * state,
+    const size_t state_len
+);
+
+//====================//
+// Midstate Interface //
+//====================//
+
+// A streaming context that has absorbed a shared prefix (init, then update) serves as a
+// frozen midstate: the functions below hash prefix || suffix from it without reprocessing
+// the prefix and without modifying the context, so any number of threads may use the
+// same midstate at once as long as nobody updates it meanwhile
+
+// sha1_suffix()
+// Computes the SHA-1 hash digest of a midstate's prefix followed by a suffix
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digest       Pointer to destination buffer for hash digest
+//     suffix       Pointer to input data following the prefix
+//     suffix_len   Number of bytes in suffix (prefix plus suffix cannot be greater than 2^61)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha1_suffix(
+    const sha1_ctx * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+);
+
+// sha1_suffix_batch()
+// Computes SHA-1 hash digests of a midstate's prefix followed by each of many suffixes
+// (suffixes are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA1_DIGEST_LEN, format) bytes each)
+//     suffixes     Array of count pointers to input data following the prefix
+//     suffix_lens  Array of count suffix lengths in bytes
+//     count        Number of suffixes
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha1_suffix_batch(
+    const sha1_ctx * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha224_suffix()
+// Computes the SHA-224 hash digest of a midstate's prefix followed by a suffix
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digest       Pointer to destination buffer for hash digest
+//     suffix       Pointer to input data following the prefix
+//     suffix_len   Number of bytes in suffix (prefix plus suffix cannot be greater than 2^61)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha224_suffix(
+    const sha224_ctx * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+);
+
+// sha224_suffix_batch()
+// Computes SHA-224 hash digests of a midstate's prefix followed by each of many suffixes
+// (suffixes are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA224_DIGEST_LEN, format) bytes each)
+//     suffixes     Array of count pointers to input data following the prefix
+//     suffix_lens  Array of count suffix lengths in bytes
+//     count        Number of suffixes
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha224_suffix_batch(
+    const sha224_ctx * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha256_suffix()
+// Computes the SHA-256 hash digest of a midstate's prefix followed by a suffix
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digest       Pointer to destination buffer for hash digest
+//     suffix       Pointer to input data following the prefix
+//     suffix_len   Number of bytes in suffix (prefix plus suffix cannot be greater than 2^61)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha256_suffix(
+    const sha256_ctx * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+);
+
+// sha256_suffix_batch()
+// Computes SHA-256 hash digests of a midstate's prefix followed by each of many suffixes
+// (suffixes are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA256_DIGEST_LEN, format) bytes each)
+//     suffixes     Array of count pointers to input data following the prefix
+//     suffix_lens  Array of count suffix lengths in bytes
+//     count        Number of suffixes
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha256_suffix_batch(
+    const sha256_ctx * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha384_suffix()
+// Computes the SHA-384 hash digest of a midstate's prefix followed by a suffix
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digest       Pointer to destination buffer for hash digest
+//     suffix       Pointer to input data following the prefix
+//     suffix_len   Number of bytes in suffix
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha384_suffix(
+    const sha384_ctx * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+);
+
+// sha384_suffix_batch()
+// Computes SHA-384 hash digests of a midstate's prefix followed by each of many suffixes
+// (suffixes are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA384_DIGEST_LEN, format) bytes each)
+//     suffixes     Array of count pointers to input data following the prefix
+//     suffix_lens  Array of count suffix lengths in bytes
+//     count        Number of suffixes
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha384_suffix_batch(
+    const sha384_ctx * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha512_suffix()
+// Computes the SHA-512 hash digest of a midstate's prefix followed by a suffix
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digest       Pointer to destination buffer for hash digest
+//     suffix       Pointer to input data following the prefix
+//     suffix_len   Number of bytes in suffix
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_suffix(
+    const sha512_ctx * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+);
+
+// sha512_suffix_batch()
+// Computes SHA-512 hash digests of a midstate's prefix followed by each of many suffixes
+// (suffixes are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA512_DIGEST_LEN, format) bytes each)
+//     suffixes     Array of count pointers to input data following the prefix
+//     suffix_lens  Array of count suffix lengths in bytes
+//     count        Number of suffixes
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_suffix_batch(
+    const sha512_ctx * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha512_224_suffix()
+// Computes the SHA-512/224 hash digest of a midstate's prefix followed by a suffix
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digest       Pointer to destination buffer for hash digest
+//     suffix       Pointer to input data following the prefix
+//     suffix_len   Number of bytes in suffix
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_224_suffix(
+    const sha512_224_ctx * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+);
+
+// sha512_224_suffix_batch()
+// Computes SHA-512/224 hash digests of a midstate's prefix followed by each of many suffixes
+// (suffixes are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA512_224_DIGEST_LEN, format) bytes each)
+//     suffixes     Array of count pointers to input data following the prefix
+//     suffix_lens  Array of count suffix lengths in bytes
+//     count        Number of suffixes
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_224_suffix_batch(
+    const sha512_224_ctx * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// sha512_256_suffix()
+// Computes the SHA-512/256 hash digest of a midstate's prefix followed by a suffix
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digest       Pointer to destination buffer for hash digest
+//     suffix       Pointer to input data following the prefix
+//     suffix_len   Number of bytes in suffix
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_256_suffix(
+    const sha512_256_ctx * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+);
+
+// sha512_256_suffix_batch()
+// Computes SHA-512/256 hash digests of a midstate's prefix followed by each of many suffixes
+// (suffixes are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     midstate     Pointer to context that has absorbed the prefix
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA512_256_DIGEST_LEN, format) bytes each)
+//     suffixes     Array of count pointers to input data following the prefix
+//     suffix_lens  Array of count suffix lengths in bytes
+//     count        Number of suffixes
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_256_suffix_batch(
+    const sha512_256_ctx * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+//==========================//
+// Scatter/Gather Interface //
+//==========================//
+
+// Each function below hashes the concatenation of count segments (struct iovec, as for
+// readv()/writev()) exactly as the one-shot function would hash one contiguous copy;
+// only the bytes of blocks that straddle segment boundaries are copied. Callers that
+// build segments include <sys/uio.h> (or provide an equivalent struct iovec) themselves
+
+// sha1_iov()
+// Populates a buffer with the SHA-1 hash digest of a message split across segments
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (UNSUPPORTED_DATA_SIZE for a negative count)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     segments     Array of count segments, in message order (total cannot be greater than 2^61)
+//     count        Number of segments
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha1_iov(
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+);
+
+// sha224_iov()
+// Populates a buffer with the SHA-224 hash digest of a message split across segments
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (UNSUPPORTED_DATA_SIZE for a negative count)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     segments     Array of count segments, in message order (total cannot be greater than 2^61)
+//     count        Number of segments
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha224_iov(
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+);
+
+// sha256_iov()
+// Populates a buffer with the SHA-256 hash digest of a message split across segments
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (UNSUPPORTED_DATA_SIZE for a negative count)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     segments     Array of count segments, in message order (total cannot be greater than 2^61)
+//     count        Number of segments
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha256_iov(
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+);
+
+// sha384_iov()
+// Populates a buffer with the SHA-384 hash digest of a message split across segments
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (UNSUPPORTED_DATA_SIZE for a negative count)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     segments     Array of count segments, in message order
+//     count        Number of segments
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha384_iov(
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+);
+
+// sha512_iov()
+// Populates a buffer with the SHA-512 hash digest of a message split across segments
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (UNSUPPORTED_DATA_SIZE for a negative count)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     segments     Array of count segments, in message order
+//     count        Number of segments
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_iov(
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+);
+
+// sha512_224_iov()
+// Populates a buffer with the SHA-512/224 hash digest of a message split across segments
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (UNSUPPORTED_DATA_SIZE for a negative count)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     segments     Array of count segments, in message order
+//     count        Number of segments
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_224_iov(
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+);
+
+// sha512_256_iov()
+// Populates a buffer with the SHA-512/256 hash digest of a message split across segments
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (UNSUPPORTED_DATA_SIZE for a negative count)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     segments     Array of count segments, in message order
+//     count        Number of segments
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_256_iov(
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+);
+
+// sha_iov()
+// Generic scatter/gather function for which the caller specifies the SHA-X algorithm to compute
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     algorithm    Enum indicating the algorithm to compute
+//     digest       Pointer to destination buffer for hash digest
+//     segments     Array of count segments, in message order
+//     count        Number of segments
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha_iov(
+    ShaType algorithm,
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+);
+
+//================//
+// Copy Interface //
+//================//
+
+// Each function below copies a message to a destination buffer and hashes it in the same
+// pass: a few blocks at a time are copied, then compressed from the copy while it is still
+// in L1, so the data crosses the memory hierarchy once. The digest matches the one-shot (or
+// update) function's. Source and destination must not overlap
+
+// sha1_copy()
+// Copies a message to a destination buffer and populates a buffer with its SHA-1 hash digest
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (NULL_MESSAGE_POINTER if message or destination is NULL with a nonzero length)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     destination  Pointer to buffer receiving a copy of the message (message_len bytes)
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data (cannot be greater than 2^61)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha1_copy(
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+// sha1_update_copy()
+// Copies the next chunk of message input to a destination buffer and absorbs it into a SHA-1 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha1_init()
+//     destination  Pointer to buffer receiving a copy of the chunk (message_len bytes)
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk (total cannot be greater than 2^61)
+
+ShaComputationResult
+sha1_update_copy(
+    sha1_ctx * context,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha224_copy()
+// Copies a message to a destination buffer and populates a buffer with its SHA-224 hash digest
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (NULL_MESSAGE_POINTER if message or destination is NULL with a nonzero length)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     destination  Pointer to buffer receiving a copy of the message (message_len bytes)
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data (cannot be greater than 2^61)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha224_copy(
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+// sha224_update_copy()
+// Copies the next chunk of message input to a destination buffer and absorbs it into a SHA-224 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha224_init()
+//     destination  Pointer to buffer receiving a copy of the chunk (message_len bytes)
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk (total cannot be greater than 2^61)
+
+ShaComputationResult
+sha224_update_copy(
+    sha224_ctx * context,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha256_copy()
+// Copies a message to a destination buffer and populates a buffer with its SHA-256 hash digest
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (NULL_MESSAGE_POINTER if message or destination is NULL with a nonzero length)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     destination  Pointer to buffer receiving a copy of the message (message_len bytes)
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data (cannot be greater than 2^61)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha256_copy(
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+// sha256_update_copy()
+// Copies the next chunk of message input to a destination buffer and absorbs it into a SHA-256 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha256_init()
+//     destination  Pointer to buffer receiving a copy of the chunk (message_len bytes)
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk (total cannot be greater than 2^61)
+
+ShaComputationResult
+sha256_update_copy(
+    sha256_ctx * context,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha384_copy()
+// Copies a message to a destination buffer and populates a buffer with its SHA-384 hash digest
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (NULL_MESSAGE_POINTER if message or destination is NULL with a nonzero length)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     destination  Pointer to buffer receiving a copy of the message (message_len bytes)
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha384_copy(
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+// sha384_update_copy()
+// Copies the next chunk of message input to a destination buffer and absorbs it into a SHA-384 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha384_init()
+//     destination  Pointer to buffer receiving a copy of the chunk (message_len bytes)
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk
+
+ShaComputationResult
+sha384_update_copy(
+    sha384_ctx * context,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha512_copy()
+// Copies a message to a destination buffer and populates a buffer with its SHA-512 hash digest
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (NULL_MESSAGE_POINTER if message or destination is NULL with a nonzero length)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     destination  Pointer to buffer receiving a copy of the message (message_len bytes)
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_copy(
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+// sha512_update_copy()
+// Copies the next chunk of message input to a destination buffer and absorbs it into a SHA-512 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_init()
+//     destination  Pointer to buffer receiving a copy of the chunk (message_len bytes)
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk
+
+ShaComputationResult
+sha512_update_copy(
+    sha512_ctx * context,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha512_224_copy()
+// Copies a message to a destination buffer and populates a buffer with its SHA-512/224 hash digest
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (NULL_MESSAGE_POINTER if message or destination is NULL with a nonzero length)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     destination  Pointer to buffer receiving a copy of the message (message_len bytes)
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_224_copy(
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+// sha512_224_update_copy()
+// Copies the next chunk of message input to a destination buffer and absorbs it into a SHA-512/224 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_224_init()
+//     destination  Pointer to buffer receiving a copy of the chunk (message_len bytes)
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk
+
+ShaComputationResult
+sha512_224_update_copy(
+    sha512_224_ctx * context,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha512_256_copy()
+// Copies a message to a destination buffer and populates a buffer with its SHA-512/256 hash digest
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (NULL_MESSAGE_POINTER if message or destination is NULL with a nonzero length)
+//
+// Parameters:
+//     digest       Pointer to destination buffer for hash digest
+//     destination  Pointer to buffer receiving a copy of the message (message_len bytes)
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha512_256_copy(
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+// sha512_256_update_copy()
+// Copies the next chunk of message input to a destination buffer and absorbs it into a SHA-512/256 context
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_256_init()
+//     destination  Pointer to buffer receiving a copy of the chunk (message_len bytes)
+//     message      Pointer to next chunk of input data
+//     message_len  Number of bytes in chunk
+
+ShaComputationResult
+sha512_256_update_copy(
+    sha512_256_ctx * context,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha_copy()
+// Generic copy-and-hash function for which the caller specifies the SHA-X algorithm to compute
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     algorithm    Enum indicating the algorithm to compute
+//     digest       Pointer to destination buffer for hash digest
+//     destination  Pointer to buffer receiving a copy of the message (message_len bytes)
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha_copy(
+    ShaType algorithm,
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+//========================//
+// Verification Interface //
+//========================//
+
+// Each function below computes a digest and compares it in constant time with an expected
+// value, returning HASH_COMPUTED on a match and DIGEST_MISMATCH otherwise. The expected value
+// may be raw bytes (OCTET_ARRAY), hex in either case (HEX_STRING_LOWER or HEX_STRING_UPPER),
+// or base64 (BASE64, BASE64URL), with no terminator needed; it is decoded once, and the
+// computed digest is never encoded. An expected value that is malformed for its format
+// counts as a mismatch
+
+// sha1_verify()
+// Computes the SHA-1 hash digest of a message and compares it with an expected digest
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data (cannot be greater than 2^61)
+//     expected     Pointer to expected digest (SHA1_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha1_verify(
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha1_final_verify()
+// Pads the absorbed input like sha1_final(), then compares the SHA-1 digest with an expected digest
+// (The context must be passed to sha1_init() again before reuse)
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha1_init()
+//     expected     Pointer to expected digest (SHA1_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha1_final_verify(
+    sha1_ctx * context,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha224_verify()
+// Computes the SHA-224 hash digest of a message and compares it with an expected digest
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data (cannot be greater than 2^61)
+//     expected     Pointer to expected digest (SHA224_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha224_verify(
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha224_final_verify()
+// Pads the absorbed input like sha224_final(), then compares the SHA-224 digest with an expected digest
+// (The context must be passed to sha224_init() again before reuse)
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha224_init()
+//     expected     Pointer to expected digest (SHA224_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha224_final_verify(
+    sha224_ctx * context,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha256_verify()
+// Computes the SHA-256 hash digest of a message and compares it with an expected digest
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data (cannot be greater than 2^61)
+//     expected     Pointer to expected digest (SHA256_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha256_verify(
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha256_final_verify()
+// Pads the absorbed input like sha256_final(), then compares the SHA-256 digest with an expected digest
+// (The context must be passed to sha256_init() again before reuse)
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha256_init()
+//     expected     Pointer to expected digest (SHA256_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha256_final_verify(
+    sha256_ctx * context,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha384_verify()
+// Computes the SHA-384 hash digest of a message and compares it with an expected digest
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+//     expected     Pointer to expected digest (SHA384_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha384_verify(
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha384_final_verify()
+// Pads the absorbed input like sha384_final(), then compares the SHA-384 digest with an expected digest
+// (The context must be passed to sha384_init() again before reuse)
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha384_init()
+//     expected     Pointer to expected digest (SHA384_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha384_final_verify(
+    sha384_ctx * context,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha512_verify()
+// Computes the SHA-512 hash digest of a message and compares it with an expected digest
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+//     expected     Pointer to expected digest (SHA512_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha512_verify(
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha512_final_verify()
+// Pads the absorbed input like sha512_final(), then compares the SHA-512 digest with an expected digest
+// (The context must be passed to sha512_init() again before reuse)
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_init()
+//     expected     Pointer to expected digest (SHA512_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha512_final_verify(
+    sha512_ctx * context,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha512_224_verify()
+// Computes the SHA-512/224 hash digest of a message and compares it with an expected digest
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+//     expected     Pointer to expected digest (SHA512_224_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha512_224_verify(
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha512_224_final_verify()
+// Pads the absorbed input like sha512_224_final(), then compares the SHA-512/224 digest with an expected digest
+// (The context must be passed to sha512_224_init() again before reuse)
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_224_init()
+//     expected     Pointer to expected digest (SHA512_224_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha512_224_final_verify(
+    sha512_224_ctx * context,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha512_256_verify()
+// Computes the SHA-512/256 hash digest of a message and compares it with an expected digest
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+//     expected     Pointer to expected digest (SHA512_256_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha512_256_verify(
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha512_256_final_verify()
+// Pads the absorbed input like sha512_256_final(), then compares the SHA-512/256 digest with an expected digest
+// (The context must be passed to sha512_256_init() again before reuse)
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     context      Pointer to context prepared by sha512_256_init()
+//     expected     Pointer to expected digest (SHA512_256_DIGEST_LEN bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha512_256_final_verify(
+    sha512_256_ctx * context,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha_verify()
+// Generic verify function for which the caller specifies the SHA-X algorithm to compute
+//
+// Return value:
+//     HASH_COMPUTED if the digests match, DIGEST_MISMATCH if they differ,
+//     or another ShaComputationResult enum indicating the reason for error
+//
+// Parameters:
+//     algorithm    Enum indicating the algorithm to compute
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+//     expected     Pointer to expected digest (digest length bytes, or their encoding in format)
+//     format       Enum indicating how expected is encoded
+
+ShaComputationResult
+sha_verify(
+    ShaType algorithm,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// sha_verify_batch()
+// Verifies many independent messages at once against their expected digests
+// (messages are hashed side by side in SIMD lanes when the host supports it)
+//
+// Return value:
+//     HASH_COMPUTED if every digest matches, otherwise the status of the first message
+//     that failed (DIGEST_MISMATCH or the reason it could not be hashed)
+//
+// Parameters:
+//     algorithm    Enum indicating the algorithm to compute
+//     messages     Array of count pointers to input data
+//     message_lens Array of count input lengths in bytes
+//     count        Number of messages
+//     expected     Pointer to count expected digests stored back to back, as the batch
+//                  functions write them (sha_encoded_size(digest length, format) bytes each)
+//     format       Enum indicating how expected is encoded
+//     statuses     Array receiving count per-message results (may be NULL)
+
+ShaComputationResult
+sha_verify_batch(
+    ShaType algorithm,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const uint8_t * expected,
+    const ShaDigestFormat format,
+    ShaComputationResult * statuses
+);
+
+//====================//
+// Encoding Interface //
+//====================//
+
+// The functions below convert between raw digests and the text formats on their own, for
+// digests that were computed as OCTET_ARRAY (by a batch call, say) and are formatted later.
+// They accept any number of bytes, not only digest lengths
+
+// sha_encoded_size()
+// Bytes needed to hold raw_len bytes in the given format (text formats include the
+// null terminator)
+//
+// Return value:
+//     Buffer size in bytes, or 0 for an unrecognized format
+//
+// Parameters:
+//     raw_len      Number of raw bytes
+//     format       Enum indicating the encoding
+
+size_t
+sha_encoded_size(
+    const size_t raw_len,
+    const ShaDigestFormat format
+);
+
+// sha_encode()
+// Encodes raw bytes in the given format
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     encoded      Pointer to destination buffer (sha_encoded_size(raw_len, format) bytes)
+//     raw          Pointer to the bytes to encode
+//     raw_len      Number of bytes to encode
+//     format       Enum indicating the encoding
+
+ShaComputationResult
+sha_encode(
+    uint8_t * encoded,
+    const uint8_t * raw,
+    const size_t raw_len,
+    const ShaDigestFormat format
+);
+
+// sha_decode()
+// Decodes text in the given format back to raw_len bytes (hex is accepted in either case;
+// base64 must be canonical, with padding for BASE64 and none for BASE64URL)
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//     (MALFORMED_ENCODING if the text is not a valid encoding of raw_len bytes)
+//
+// Parameters:
+//     raw          Pointer to destination buffer (raw_len bytes)
+//     encoded      Pointer to the text to decode (no terminator needed)
+//     raw_len      Number of bytes the text encodes
+//     format       Enum indicating the encoding
+
+ShaComputationResult
+sha_decode(
+    uint8_t * raw,
+    const uint8_t * encoded,
+    const size_t raw_len,
+    const ShaDigestFormat format
+);
+
+// sha_encode_batch()
+// Encodes count raw digests stored back to back, such as those an OCTET_ARRAY batch call
+// writes, into count strings stored back to back
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//
+// Parameters:
+//     encoded      Pointer to destination buffer (sha_encoded_size(digest_len, format) bytes each)
+//     digests      Pointer to count raw digests of digest_len bytes each
+//     count        Number of digests
+//     digest_len   Number of bytes in each digest
+//     format       Enum indicating the encoding
+
+ShaComputationResult
+sha_encode_batch(
+    uint8_t * encoded,
+    const uint8_t * digests,
+    const size_t count,
+    const size_t digest_len,
+    const ShaDigestFormat format
+);
+
+//==========================//
+// Double SHA-256 Interface //
+//==========================//
+
+// SHA-256d is SHA-256 applied to the raw SHA-256 digest of a message, as used for block
+// headers, transaction IDs and checksums. The functions below hand the first digest's
+// words straight to the second compression, which only ever sees a 32-byte message
+
+// sha256d()
+// Populates a buffer with the SHA-256d hash digest, SHA-256(SHA-256(message)), for the
+// given message input
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     digest       Pointer to destination buffer (sha_encoded_size(SHA256_DIGEST_LEN, format) bytes)
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data (cannot be greater than 2^61)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha256d(
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+// sha256d_batch()
+// Computes SHA-256d hash digests for many independent messages at once
+// (both hashes of each message are computed side by side in SIMD lanes when the host
+// supports it)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     digests      Pointer to destination buffer for count digests stored back to back
+//                  (sha_encoded_size(SHA256_DIGEST_LEN, format) bytes each)
+//     messages     Array of count pointers to input data
+//     message_lens Array of count input lengths in bytes (each cannot be greater than 2^61)
+//     count        Number of messages
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha256d_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+//===========================//
+// Multi-Algorithm Interface //
+//===========================//
+
+// sha_multi()
+// Computes several algorithms' digests of one message in a single pass over it
+// (each chunk of input is fed to every algorithm while it is still in cache; IV
+// variants sharing a compression function, such as SHA-224 and SHA-256, share
+// each block's loads through multi-buffer lanes where the host has them)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//     (arguments are fully validated before any digest is written)
+//
+// Parameters:
+//     algorithms   Array of count enums indicating the algorithms to compute (repeats allowed)
+//     count        Number of algorithms
+//     digests      Array of count pointers to destination buffers, one per algorithm
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data (no greater than the smallest limit
+//                  among the algorithms)
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha_multi(
+    const ShaType * algorithms,
+    const size_t count,
+    uint8_t * const * digests,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+//===================//
+// Manager Interface //
+//===================//
+
+// A manager interleaves many streaming contexts of one algorithm through the multi-buffer
+// kernels: each submission that completes at least one block is queued, and once
+// SHA_MANAGER_SLOTS are waiting (or on sha_manager_flush()) the queued chunks are
+// compressed side by side, one stream per SIMD lane. Smaller submissions are buffered
+// in their context at once.
+//
+// Until the manager has run a queued submission, its context must not be passed to
+// any other function and its chunk must stay readable; sha_manager_flush() runs
+// everything queued, so flush before finalizing (a stream's own chunks are always
+// absorbed in the order they were submitted)
+
+// Submissions queued before the manager runs them
+// (two per lane, so lanes freed by short chunks refill from the queue)
+#define SHA_MANAGER_SLOTS 16
+
+// sha_manager_entry
+// One queued submission
+//
+// Members:
+//   context    Streaming context the chunk belongs to
+//   chunk      Pointer to the submitted input data
+//   chunk_len  Number of bytes in chunk
+
+typedef struct sha_manager_entry
+{
+    void * context;
+    const uint8_t * chunk;
+    uint64_t chunk_len;
+
+} sha_manager_entry;
+
+// sha_manager
+// Caller-allocated queue of submissions from many streams of one algorithm
+//
+// Members:
+//   algorithm  Algorithm of every context submitted to the manager
+//   queued     Number of submissions waiting in pending
+//   pending    Submissions not yet compressed, longest chunk first
+
+typedef struct sha_manager
+{
+    ShaType algorithm;
+    size_t queued;
+    sha_manager_entry pending[SHA_MANAGER_SLOTS];
+
+} sha_manager;
+
+// sha_manager_init()
+// Prepares an empty manager for streams of the given algorithm
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER if manager is NULL,
+//     INVALID_ALGORITHM for an unrecognized algorithm
+//
+// Parameters:
+//     manager      Pointer to caller-allocated manager
+//     algorithm    Enum indicating the algorithm of every stream
+
+ShaComputationResult
+sha_manager_init(sha_manager * manager, ShaType algorithm);
+
+// sha_manager_submit()
+// Absorbs the next chunk of one stream's input through the manager, as the algorithm's
+// update function would (may run the queue, compressing earlier submissions)
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//     (NULL_CONTEXT_POINTER if manager or context is NULL)
+//
+// Parameters:
+//     manager      Pointer to manager prepared by sha_manager_init()
+//     context      Pointer to the stream's context, prepared by the algorithm's init function
+//                  (sha1_ctx for SHA1, sha256_ctx for SHA224 and SHA256, sha512_ctx otherwise)
+//     chunk        Pointer to next chunk of input data
+//     chunk_len    Number of bytes in chunk
+
+ShaComputationResult
+sha_manager_submit(
+    sha_manager * manager,
+    void * context,
+    const uint8_t * chunk,
+    const uint64_t chunk_len
+);
+
+// sha_manager_flush()
+// Compresses every queued submission, so their contexts and chunks are free again
+// (call it to bound latency, and before finalizing any stream)
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER if manager is NULL
+//
+// Parameters:
+//     manager      Pointer to manager prepared by sha_manager_init()
+
+ShaComputationResult
+sha_manager_flush(sha_manager * manager);
+
+//================//
+// Step Interface //
+//================//
+
+// A job hashes one in-memory message a bounded number of blocks at a time, so an event
+// loop can interleave a large message with other work: each sha_job_step() compresses
+// at most max_blocks blocks (padding blocks included) and returns. The digest matches
+// sha() for the same message. The message must stay readable until the job is finalized
+
+// sha_job
+// Caller-allocated state for a resumable one-shot computation
+//
+// Members:
+//   algorithm    Algorithm being computed
+//   message      Pointer to input data
+//   message_len  Number of bytes in input data
+//   block_count  Number of blocks the whole computation compresses, padding included
+//   blocks_done  Number of blocks compressed so far
+//   hash_words   Chaining value after blocks_done blocks (32-bit words for SHA-1/SHA-224/SHA-256)
+
+typedef struct sha_job
+{
+    ShaType algorithm;
+    const uint8_t * message;
+    uint64_t message_len;
+    uint64_t block_count;
+    uint64_t blocks_done;
+
+    union
+    {
+        uint32_t words_32[8];
+        uint64_t words_64[8];
+
+    } hash_words;
+
+} sha_job;
+
+// sha_job_init()
+// Prepares a job to hash a message, without compressing anything yet
+//
+// Return value:
+//     ShaComputationResult enum indicating success or reason for error
+//     (NULL_CONTEXT_POINTER if job is NULL)
+//
+// Parameters:
+//     job          Pointer to caller-allocated job
+//     algorithm    Enum indicating the algorithm to compute
+//     message      Pointer to input data
+//     message_len  Number of bytes in input data
+
+ShaComputationResult
+sha_job_init(
+    sha_job * job,
+    ShaType algorithm,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha_job_step()
+// Compresses up to max_blocks more blocks of a job's message
+//
+// Return value:
+//     HASH_COMPUTED on success, NULL_CONTEXT_POINTER if job is NULL
+//
+// Parameters:
+//     job          Pointer to job prepared by sha_job_init()
+//     max_blocks   Most blocks to compress in this step (SHA1_BLOCK_LEN, SHA256_BLOCK_LEN
+//                  or SHA512_BLOCK_LEN bytes each, by algorithm family)
+//     blocks_left  Receives the number of blocks still to compress, 0 once the job is
+//                  complete (may be NULL)
+
+ShaComputationResult
+sha_job_step(
+    sha_job * job,
+    const uint64_t max_blocks,
+    uint64_t * blocks_left
+);
+
+// sha_job_final()
+// Writes the digest of a job's message
+// (any blocks not yet compressed are compressed first, without a bound)
+//
+// Return value:
+//     ShaComputationResult enum indicating successful hash computation or reason for error
+//
+// Parameters:
+//     job          Pointer to job prepared by sha_job_init()
+//     digest       Pointer to destination buffer for hash digest
+//     format       Enum indicating digest format (raw bytes, uppercase/lowercase hexadecimal, base64)
+
+ShaComputationResult
+sha_job_final(
+    sha_job * job,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+//===================//
+// Backend Selection //
+//===================//
+
+// sha_set_backend()
+// Forces every hashing function onto one backend's kernels, for debugging and A/B benchmarks
+// (algorithms the backend has no kernel for use the portable ones; BACKEND_AUTO restores the
+// default. The SHARPTWOTH_BACKEND environment variable (auto, scalar, ssse3, avx2, avx512,
+// shani) does the same at load time. Not safe to call while other threads are hashing)
+//
+// Return value:
+//     HASH_COMPUTED on success, UNSUPPORTED_BACKEND if the host cannot run the backend
+//
+// Parameters:
+//     backend      Enum naming the backend to use
+
+ShaComputationResult
+sha_set_backend(const ShaBackend backend);
+
+// sha_get_backend()
+// Returns the backend the hashing functions are currently bound to
+
+ShaBackend
+sha_get_backend(void);
+
+// sha_autotune()
+// Times every backend the host supports for each algorithm family and message-size
+// bucket, then binds the fastest per bucket for one-shot hashing and for batches
+// (rebinds BACKEND_AUTO first. Decisions are cached in cache_path, one line per CPU
+// model, so later runs on the same model skip measuring. Setting the SHARPTWOTH_AUTOTUNE
+// environment variable to a cache path, or to an empty value for no cache, tunes at
+// load time. Not safe to call while other threads are hashing)
+//
+// Return value:
+//     HASH_COMPUTED (cache files that cannot be read or written only cost a re-measurement)
+//
+// Parameters:
+//     cache_path   Path of the decision cache file (NULL to always measure)
+
+ShaComputationResult
+sha_autotune(const char * cache_path);
+
 #ifdef __cplusplus
 }
 #endif
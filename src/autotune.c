@@ -0,0 +1,250 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/autotune.c                            //
+// Description: Per-host backend selection by measurement //
+//                                                        //
+//********************************************************//
+
+#include <stdio.h>
+#include <time.h>
+#include "sharptwoth/internal.h"
+
+//==================//
+// Tuning Workloads //
+//==================//
+
+// Bytes hashed per timed pass, and passes per measurement (fastest counts)
+#define TUNE_BYTES 65536
+#define TUNE_PASSES 5
+
+// Cache-file line: tag, format version, decisions, CPU model
+#define TUNE_CACHE_TAG "sharptwoth-tune"
+#define TUNE_CACHE_VERSION 1
+#define TUNE_CACHE_LINE_LEN 160
+
+// Representative message length for each size bucket
+static const uint64_t BUCKET_LENGTHS[TUNE_BUCKETS] = { 64, 1024, 16384 };
+
+// Backends worth measuring; the default binding goes first as the baseline
+static const ShaBackend CANDIDATES[6] =
+{
+    BACKEND_AUTO, BACKEND_SCALAR, BACKEND_SSSE3, BACKEND_AVX2, BACKEND_AVX512, BACKEND_SHA_NI
+};
+
+// A candidate replaces the current best only if it is clearly faster, so
+// timing noise between identical kernels never moves a decision
+#define TUNE_MARGIN 0.9
+
+// Functions timed for each family (one member stands in for the family)
+static const hasher_t FAMILY_HASHERS[TUNE_FAMILIES] = { sha1, sha256, sha512 };
+
+static ShaComputationResult (* const FAMILY_BATCHERS[TUNE_FAMILIES])(
+    uint8_t *, const uint8_t * const *, const uint64_t *, const size_t, const ShaDigestFormat
+) = { sha1_batch, sha256_batch, sha512_batch };
+
+// Workload buffers (one pass worth of messages and digests)
+static uint8_t tune_data[TUNE_BYTES];
+static uint8_t tune_digests[TUNE_BYTES];
+static const uint8_t * tune_messages[TUNE_BYTES / 64];
+static uint64_t tune_lens[TUNE_BYTES / 64];
+
+//==================//
+// Static Functions //
+//==================//
+
+static void
+measure(tune_table * table);
+
+static double
+time_pass(const uint8_t family, const uint64_t message_len, const int batched);
+
+static int
+load_cache(const char * cache_path, const char * model, tune_table * table);
+
+static void
+store_cache(const char * cache_path, const char * model, const tune_table * table);
+
+//============//
+// Autotuning //
+//============//
+
+ShaComputationResult
+sha_autotune(const char * cache_path)
+{
+    char model[49];
+    tune_table table;
+
+    cpu_model(model, sizeof(model));
+
+    if (!cache_path || !load_cache(cache_path, model, &table))
+    {
+        measure(&table);
+
+        if (cache_path)
+            store_cache(cache_path, model, &table);
+    }
+
+    apply_tuning(&table);
+
+    return HASH_COMPUTED;
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static void
+measure(tune_table * table)
+{
+    double best_single[TUNE_FAMILIES][TUNE_BUCKETS];
+    double best_batch[TUNE_FAMILIES][TUNE_BUCKETS];
+    double elapsed;
+
+    for (size_t i = 0; i < sizeof(tune_data); ++i)
+        tune_data[i] = (uint8_t)(i * 131 + 7);
+
+    for (uint8_t f = 0; f < TUNE_FAMILIES; ++f)
+    {
+        for (uint8_t b = 0; b < TUNE_BUCKETS; ++b)
+        {
+            table->single[f][b] = table->batch[f][b] = BACKEND_AUTO;
+            best_single[f][b] = best_batch[f][b] = -1.0;
+        }
+    }
+
+    for (size_t c = 0; c < sizeof(CANDIDATES) / sizeof(CANDIDATES[0]); ++c)
+    {
+        if (sha_set_backend(CANDIDATES[c]) != HASH_COMPUTED)
+            continue;
+
+        for (uint8_t f = 0; f < TUNE_FAMILIES; ++f)
+        {
+            for (uint8_t b = 0; b < TUNE_BUCKETS; ++b)
+            {
+                elapsed = time_pass(f, BUCKET_LENGTHS[b], 0);
+
+                if (best_single[f][b] < 0.0 || elapsed < best_single[f][b] * TUNE_MARGIN)
+                {
+                    best_single[f][b] = elapsed;
+                    table->single[f][b] = (uint8_t)CANDIDATES[c];
+                }
+
+                elapsed = time_pass(f, BUCKET_LENGTHS[b], 1);
+
+                if (best_batch[f][b] < 0.0 || elapsed < best_batch[f][b] * TUNE_MARGIN)
+                {
+                    best_batch[f][b] = elapsed;
+                    table->batch[f][b] = (uint8_t)CANDIDATES[c];
+                }
+            }
+        }
+    }
+}
+
+static double
+time_pass(const uint8_t family, const uint64_t message_len, const int batched)
+{
+    size_t count = TUNE_BYTES / (size_t)message_len;
+    struct timespec start, end;
+    double elapsed, best = -1.0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        tune_messages[i] = tune_data + i * message_len;
+        tune_lens[i] = message_len;
+    }
+
+    for (int p = 0; p < TUNE_PASSES; ++p)
+    {
+        timespec_get(&start, TIME_UTC);
+
+        if (batched)
+        {
+            FAMILY_BATCHERS[family](tune_digests, tune_messages, tune_lens, count, OCTET_ARRAY);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+                FAMILY_HASHERS[family](tune_digests + i * 64, tune_messages[i], message_len, OCTET_ARRAY);
+        }
+
+        timespec_get(&end, TIME_UTC);
+        elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+
+        if (best < 0.0 || elapsed < best)
+            best = elapsed;
+    }
+
+    return best;
+}
+
+static int
+load_cache(const char * cache_path, const char * model, tune_table * table)
+{
+    char line[TUNE_CACHE_LINE_LEN], single[16], batch[16];
+    int version, offset, found = 0;
+    FILE * cache = fopen(cache_path, "r");
+
+    if (!cache)
+        return 0;
+
+    // One line per CPU model; the first valid line for this model wins
+    while (!found && fgets(line, sizeof(line), cache))
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+
+        if (sscanf(line, TUNE_CACHE_TAG " %d %15s %15s %n", &version, single, batch, &offset) != 3)
+            continue;
+
+        if (version != TUNE_CACHE_VERSION || strcmp(line + offset, model))
+            continue;
+
+        if (strlen(single) != TUNE_FAMILIES * TUNE_BUCKETS || strlen(batch) != TUNE_FAMILIES * TUNE_BUCKETS)
+            continue;
+
+        found = 1;
+
+        for (uint8_t i = 0; i < TUNE_FAMILIES * TUNE_BUCKETS && found; ++i)
+        {
+            ShaBackend s = (ShaBackend)(single[i] - '0');
+            ShaBackend b = (ShaBackend)(batch[i] - '0');
+
+            // Entries naming a backend this host cannot run are stale
+            if (!backend_supported(s) || !backend_supported(b))
+                found = 0;
+
+            table->single[i / TUNE_BUCKETS][i % TUNE_BUCKETS] = (uint8_t)s;
+            table->batch[i / TUNE_BUCKETS][i % TUNE_BUCKETS] = (uint8_t)b;
+        }
+    }
+
+    fclose(cache);
+
+    return found;
+}
+
+static void
+store_cache(const char * cache_path, const char * model, const tune_table * table)
+{
+    char single[TUNE_FAMILIES * TUNE_BUCKETS + 1], batch[TUNE_FAMILIES * TUNE_BUCKETS + 1];
+    FILE * cache = fopen(cache_path, "a");
+
+    // The cache is an optimization only; an unwritable path just means measuring next time
+    if (!cache)
+        return;
+
+    for (uint8_t i = 0; i < TUNE_FAMILIES * TUNE_BUCKETS; ++i)
+    {
+        single[i] = (char)('0' + table->single[i / TUNE_BUCKETS][i % TUNE_BUCKETS]);
+        batch[i] = (char)('0' + table->batch[i / TUNE_BUCKETS][i % TUNE_BUCKETS]);
+    }
+
+    single[TUNE_FAMILIES * TUNE_BUCKETS] = batch[TUNE_FAMILIES * TUNE_BUCKETS] = '\0';
+
+    fprintf(cache, TUNE_CACHE_TAG " %d %s %s %s\n", TUNE_CACHE_VERSION, single, batch, model);
+    fclose(cache);
+}
@@ -0,0 +1,351 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/batch.c                               //
+// Description: Shared helpers for batch hashing          //
+//                                                        //
+//********************************************************//
+
+#include <stdlib.h>
+#include "sharptwoth/internal.h"
+
+// Jobs handed to the multi-buffer engine at a time (bounds stack use)
+#define BATCH_CHUNK 64
+
+// Messages ordered together before hashing (bounds stack use: callers may run
+// many threads on small stacks, so the order array stays at 1 KB)
+#define BATCH_WINDOW 64
+
+// batch_entry
+// One message of the current window, in hashing order
+//
+// Members:
+//   message_len  Number of bytes in the message
+//   index        Position of the message (and its digest) in the batch
+
+typedef struct batch_entry
+{
+    uint64_t message_len;
+    size_t index;
+
+} batch_entry;
+
+//==================//
+// Static Functions //
+//==================//
+
+static size_t
+order_window(
+    const uint64_t * message_lens,
+    const ShaComputationResult * statuses,
+    const size_t base,
+    const size_t window,
+    batch_entry * order
+);
+
+static int
+longer_first(const void * a, const void * b);
+
+//===============//
+// Batch Helpers //
+//===============//
+
+ShaComputationResult
+validate_batch(
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const uint64_t max_message_len
+)
+{
+    if (!count)
+        return HASH_COMPUTED;
+
+    if (!messages || !message_lens)
+        return NULL_MESSAGE_POINTER;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!messages[i] && message_lens[i])
+            return NULL_MESSAGE_POINTER;
+
+        if (message_lens[i] > max_message_len)
+            return UNSUPPORTED_DATA_SIZE;
+    }
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+validate_each(
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const uint64_t max_message_len,
+    ShaComputationResult * statuses
+)
+{
+    ShaComputationResult first = HASH_COMPUTED;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!messages[i] && message_lens[i])
+            statuses[i] = NULL_MESSAGE_POINTER;
+        else if (message_lens[i] > max_message_len)
+            statuses[i] = UNSUPPORTED_DATA_SIZE;
+        else
+            statuses[i] = HASH_COMPUTED;
+
+        if (first == HASH_COMPUTED)
+            first = statuses[i];
+    }
+
+    return first;
+}
+
+void
+batch_32(
+    const sha_descriptor * algorithm,
+    const sha_midstate * midstate,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format,
+    const ShaComputationResult * statuses
+)
+{
+    batch_rehash_32(algorithm, midstate, digests, messages, message_lens, count, format, statuses, NULL);
+}
+
+void
+batch_rehash_32(
+    const sha_descriptor * algorithm,
+    const sha_midstate * midstate,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format,
+    const ShaComputationResult * statuses,
+    const rehash_32_t rehash
+)
+{
+    size_t stride = digest_stride(algorithm->digest_len, format);
+
+    // Every message starts from the same chaining value
+    const void * start = midstate ? midstate->hash_words : algorithm->initial_hash;
+    uint64_t prefix_len = midstate ? midstate->prefix_len : 0;
+    uint8_t buffered = (uint8_t)(prefix_len % algorithm->block_len);
+
+    batch_entry order[BATCH_WINDOW];
+    uint32_t hash_words[BATCH_CHUNK][8];
+    mb_job jobs[BATCH_CHUNK];
+    size_t window, queued, end, chunk;
+
+    for (size_t base = 0; base < count; base += window)
+    {
+        window = (count - base < BATCH_WINDOW) ? (count - base) : BATCH_WINDOW;
+        queued = order_window(message_lens, statuses, base, window, order);
+
+        // One size bucket at a time, so each gets its own kernel choice
+        for (size_t run = 0; run < queued; run = end)
+        {
+            uint8_t bucket = tune_bucket(order[run].message_len);
+
+            for (end = run + 1; end < queued && tune_bucket(order[end].message_len) == bucket; ++end)
+                ;
+
+            mb_compressor_32_t mb_compress = (end - run >= 2)
+                ? algorithm->mb_compressor_32(order[run].message_len) : NULL;
+
+            // Paired schedule kernel for the padding block of one-block messages
+            word_compressor_32_t mb_sched_compress = algorithm->mb_sched_compressor_32
+                ? algorithm->mb_sched_compressor_32(order[run].message_len) : NULL;
+
+            for (size_t c = run; c < end; c += chunk)
+            {
+                chunk = (end - c < BATCH_CHUNK) ? (end - c) : BATCH_CHUNK;
+
+                for (size_t i = 0; i < chunk; ++i)
+                {
+                    size_t m = order[c + i].index;
+                    memcpy(hash_words[i], start, algorithm->word_count * sizeof(uint32_t));
+
+                    // Without a multi-buffer kernel each message runs through the
+                    // single-stream path on its own
+                    if (!mb_compress)
+                    {
+                        compressor_32_t compress = algorithm->compressor_32(message_lens[m]);
+
+                        if (midstate)
+                            stream_suffix_32(hash_words[i], midstate->buffer, prefix_len, compress, messages[m], message_lens[m]);
+                        else if (!compute_short_32(algorithm, hash_words[i], messages[m], message_lens[m]))
+                            compute_32(compress, hash_words[i], messages[m], message_lens[m]);
+
+                        continue;
+                    }
+
+                    jobs[i].message = messages[m];
+                    jobs[i].message_len = message_lens[m];
+                    jobs[i].hash_words = hash_words[i];
+                    jobs[i].absorbed_len = prefix_len - buffered;
+                    jobs[i].prefix = buffered ? midstate->buffer : NULL;
+                    jobs[i].prefix_len = buffered;
+                    jobs[i].unpadded = 0;
+                }
+
+                if (mb_compress)
+                    mb_compute_32(mb_compress, algorithm->word_count, jobs, chunk, mb_sched_compress, algorithm->pad_schedule);
+
+                if (rehash)
+                    rehash(hash_words, chunk);
+
+                for (size_t i = 0; i < chunk; ++i)
+                    unpack_32(digests + order[c + i].index * stride, hash_words[i], algorithm->digest_len, format);
+            }
+        }
+    }
+}
+
+void
+batch_64(
+    const sha_descriptor * algorithm,
+    const sha_midstate * midstate,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format,
+    const ShaComputationResult * statuses
+)
+{
+    size_t stride = digest_stride(algorithm->digest_len, format);
+
+    // Every message starts from the same chaining value
+    const void * start = midstate ? midstate->hash_words : algorithm->initial_hash;
+    uint64_t prefix_len = midstate ? midstate->prefix_len : 0;
+    uint8_t buffered = (uint8_t)(prefix_len % algorithm->block_len);
+
+    batch_entry order[BATCH_WINDOW];
+    uint64_t hash_words[BATCH_CHUNK][8];
+    mb_job jobs[BATCH_CHUNK];
+    size_t window, queued, end, chunk;
+
+    for (size_t base = 0; base < count; base += window)
+    {
+        window = (count - base < BATCH_WINDOW) ? (count - base) : BATCH_WINDOW;
+        queued = order_window(message_lens, statuses, base, window, order);
+
+        // One size bucket at a time, so each gets its own kernel choice
+        for (size_t run = 0; run < queued; run = end)
+        {
+            uint8_t bucket = tune_bucket(order[run].message_len);
+
+            for (end = run + 1; end < queued && tune_bucket(order[end].message_len) == bucket; ++end)
+                ;
+
+            mb_compressor_64_t mb_compress = (end - run >= 2)
+                ? algorithm->mb_compressor_64(order[run].message_len) : NULL;
+
+            // Paired schedule kernel for the padding block of one-block messages
+            word_compressor_64_t mb_sched_compress = algorithm->mb_sched_compressor_64
+                ? algorithm->mb_sched_compressor_64(order[run].message_len) : NULL;
+
+            // Without a multi-buffer kernel each message runs through the
+            // single-stream path on its own
+            if (!mb_compress)
+            {
+                for (size_t i = run; i < end; ++i)
+                {
+                    size_t m = order[i].index;
+                    compressor_64_t compress = algorithm->compressor_64(message_lens[m]);
+                    memcpy(hash_words[0], start, algorithm->word_count * sizeof(uint64_t));
+
+                    if (midstate)
+                        stream_suffix_64(hash_words[0], midstate->buffer, prefix_len, compress, messages[m], message_lens[m]);
+                    else if (!compute_short_64(algorithm, hash_words[0], messages[m], message_lens[m]))
+                        compute_64(compress, hash_words[0], messages[m], message_lens[m]);
+
+                    unpack_64(digests + m * stride, hash_words[0], algorithm->digest_len, format);
+                }
+
+                continue;
+            }
+
+            for (size_t c = run; c < end; c += chunk)
+            {
+                chunk = (end - c < BATCH_CHUNK) ? (end - c) : BATCH_CHUNK;
+
+                for (size_t i = 0; i < chunk; ++i)
+                {
+                    size_t m = order[c + i].index;
+                    memcpy(hash_words[i], start, algorithm->word_count * sizeof(uint64_t));
+                    jobs[i].message = messages[m];
+                    jobs[i].message_len = message_lens[m];
+                    jobs[i].hash_words = hash_words[i];
+                    jobs[i].absorbed_len = prefix_len - buffered;
+                    jobs[i].prefix = buffered ? midstate->buffer : NULL;
+                    jobs[i].prefix_len = buffered;
+                    jobs[i].unpadded = 0;
+                }
+
+                mb_compute_64(mb_compress, algorithm->word_count, jobs, chunk, mb_sched_compress, algorithm->pad_schedule);
+
+                for (size_t i = 0; i < chunk; ++i)
+                    unpack_64(digests + order[c + i].index * stride, hash_words[i], algorithm->digest_len, format);
+            }
+        }
+    }
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static size_t
+order_window(
+    const uint64_t * message_lens,
+    const ShaComputationResult * statuses,
+    const size_t base,
+    const size_t window,
+    batch_entry * order
+)
+{
+    size_t queued = 0;
+    int uniform = 1;
+
+    for (size_t i = base; i < base + window; ++i)
+    {
+        if (statuses && statuses[i] != HASH_COMPUTED)
+            continue;
+
+        order[queued].message_len = message_lens[i];
+        order[queued].index = i;
+
+        if (queued && message_lens[i] != order[0].message_len)
+            uniform = 0;
+
+        ++queued;
+    }
+
+    // Longest first groups the size buckets and lets short messages fill the
+    // lanes that free up while long ones finish, so lanes stay busy to the end
+    // (equal lengths, the common case, are already in the best order)
+    if (!uniform)
+        qsort(order, queued, sizeof(batch_entry), longer_first);
+
+    return queued;
+}
+
+static int
+longer_first(const void * a, const void * b)
+{
+    uint64_t len_a = ((const batch_entry *)a)->message_len;
+    uint64_t len_b = ((const batch_entry *)b)->message_len;
+
+    return (len_a < len_b) - (len_a > len_b);
+}
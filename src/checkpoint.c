@@ -0,0 +1,126 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/checkpoint.c                          //
+// Description: Streaming-context export and import       //
+//                                                        //
+//********************************************************//
+
+#include <string.h>
+#include "sharptwoth/internal.h"
+
+// Magic bytes opening every exported context
+static const uint8_t STATE_MAGIC[4] = { 'S', '2', 'T', 'H' };
+
+// Offsets of the fixed header fields, and the header length
+#define STATE_VERSION_OFFSET    4
+#define STATE_TYPE_OFFSET       5
+#define STATE_RESERVED_OFFSET   6
+#define STATE_LENGTH_OFFSET     8
+#define STATE_HEADER_LEN        16
+
+//==================//
+// Static Functions //
+//==================//
+
+// exported_len()
+// Bytes in an exported context of the given algorithm
+static inline size_t
+exported_len(const sha_descriptor * algorithm)
+{
+    return STATE_HEADER_LEN
+        + (size_t)algorithm->word_count * algorithm->word_size
+        + algorithm->block_len;
+}
+
+//=============//
+// Checkpoints //
+//=============//
+
+ShaComputationResult
+hash_export(
+    const sha_descriptor * algorithm,
+    const void * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    uint8_t * state
+)
+{
+    if (!state)
+        return NULL_DIGEST_POINTER;
+
+    uint8_t buffered = (uint8_t)(total_len % algorithm->block_len);
+
+    // Header
+    memcpy(state, STATE_MAGIC, sizeof(STATE_MAGIC));
+    state[STATE_VERSION_OFFSET] = SHA_STATE_VERSION;
+    state[STATE_TYPE_OFFSET] = (uint8_t)(algorithm - SHA_DESCRIPTORS);
+    state[STATE_RESERVED_OFFSET] = state[STATE_RESERVED_OFFSET + 1] = 0;
+    store_be64(state + STATE_LENGTH_OFFSET, total_len);
+    state += STATE_HEADER_LEN;
+
+    // Chaining value
+    for (uint8_t w = 0; w < algorithm->word_count; ++w, state += algorithm->word_size)
+    {
+        if (algorithm->word_size == 4)
+            store_be32(state, ((const uint32_t *)hash_words)[w]);
+        else
+            store_be64(state, ((const uint64_t *)hash_words)[w]);
+    }
+
+    // Partial block (stale bytes past its end are zeroed, so equal
+    // contexts always export to equal bytes)
+    memcpy(state, buffer, buffered);
+    memset(state + buffered, 0x00, algorithm->block_len - buffered);
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+hash_import(
+    const sha_descriptor * algorithm,
+    void * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const uint8_t * state,
+    const size_t state_len
+)
+{
+    if (!state)
+        return NULL_MESSAGE_POINTER;
+
+    // Validate everything before the context is touched
+    if (state_len != exported_len(algorithm))
+        return INVALID_CONTEXT_STATE;
+
+    if (memcmp(state, STATE_MAGIC, sizeof(STATE_MAGIC))
+        || state[STATE_VERSION_OFFSET] != SHA_STATE_VERSION
+        || state[STATE_TYPE_OFFSET] != (uint8_t)(algorithm - SHA_DESCRIPTORS)
+        || state[STATE_RESERVED_OFFSET] || state[STATE_RESERVED_OFFSET + 1])
+        return INVALID_CONTEXT_STATE;
+
+    uint64_t message_len = load_be64(state + STATE_LENGTH_OFFSET);
+
+    if (message_len > algorithm->max_message_len)
+        return INVALID_CONTEXT_STATE;
+
+    *total_len = message_len;
+    state += STATE_HEADER_LEN;
+
+    // Chaining value
+    for (uint8_t w = 0; w < algorithm->word_count; ++w, state += algorithm->word_size)
+    {
+        if (algorithm->word_size == 4)
+            ((uint32_t *)hash_words)[w] = load_be32(state);
+        else
+            ((uint64_t *)hash_words)[w] = load_be64(state);
+    }
+
+    // Partial block
+    memcpy(buffer, state, (size_t)(message_len % algorithm->block_len));
+
+    return HASH_COMPUTED;
+}
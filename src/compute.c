@@ -16,13 +16,33 @@
 // Constants //
 //===========//
 
-static const uint32_t SHA1_CONSTANTS[4] =
+const uint32_t SHA1_CONSTANTS[4] =
 {
     UINT32_C(0x5a827999), UINT32_C(0x6ed9eba1),
     UINT32_C(0x8f1bbcdc), UINT32_C(0xca62c1d6)
 };
 
-static const uint64_t SHA2_CONSTANTS[80] =
+const uint32_t SHA256_CONSTANTS[64] =
+{
+    UINT32_C(0x428a2f98), UINT32_C(0x71374491), UINT32_C(0xb5c0fbcf), UINT32_C(0xe9b5dba5),
+    UINT32_C(0x3956c25b), UINT32_C(0x59f111f1), UINT32_C(0x923f82a4), UINT32_C(0xab1c5ed5),
+    UINT32_C(0xd807aa98), UINT32_C(0x12835b01), UINT32_C(0x243185be), UINT32_C(0x550c7dc3),
+    UINT32_C(0x72be5d74), UINT32_C(0x80deb1fe), UINT32_C(0x9bdc06a7), UINT32_C(0xc19bf174),
+    UINT32_C(0xe49b69c1), UINT32_C(0xefbe4786), UINT32_C(0x0fc19dc6), UINT32_C(0x240ca1cc),
+    UINT32_C(0x2de92c6f), UINT32_C(0x4a7484aa), UINT32_C(0x5cb0a9dc), UINT32_C(0x76f988da),
+    UINT32_C(0x983e5152), UINT32_C(0xa831c66d), UINT32_C(0xb00327c8), UINT32_C(0xbf597fc7),
+    UINT32_C(0xc6e00bf3), UINT32_C(0xd5a79147), UINT32_C(0x06ca6351), UINT32_C(0x14292967),
+    UINT32_C(0x27b70a85), UINT32_C(0x2e1b2138), UINT32_C(0x4d2c6dfc), UINT32_C(0x53380d13),
+    UINT32_C(0x650a7354), UINT32_C(0x766a0abb), UINT32_C(0x81c2c92e), UINT32_C(0x92722c85),
+    UINT32_C(0xa2bfe8a1), UINT32_C(0xa81a664b), UINT32_C(0xc24b8b70), UINT32_C(0xc76c51a3),
+    UINT32_C(0xd192e819), UINT32_C(0xd6990624), UINT32_C(0xf40e3585), UINT32_C(0x106aa070),
+    UINT32_C(0x19a4c116), UINT32_C(0x1e376c08), UINT32_C(0x2748774c), UINT32_C(0x34b0bcb5),
+    UINT32_C(0x391c0cb3), UINT32_C(0x4ed8aa4a), UINT32_C(0x5b9cca4f), UINT32_C(0x682e6ff3),
+    UINT32_C(0x748f82ee), UINT32_C(0x78a5636f), UINT32_C(0x84c87814), UINT32_C(0x8cc70208),
+    UINT32_C(0x90befffa), UINT32_C(0xa4506ceb), UINT32_C(0xbef9a3f7), UINT32_C(0xc67178f2)
+};
+
+const uint64_t SHA512_CONSTANTS[80] =
 {
     UINT64_C(0x428a2f98d728ae22), UINT64_C(0x7137449123ef65cd),
     UINT64_C(0xb5c0fbcfec4d3b2f), UINT64_C(0xe9b5dba58189dbbc),
@@ -66,206 +86,426 @@ static const uint64_t SHA2_CONSTANTS[80] =
     UINT64_C(0x5fcb6fab3ad6faec), UINT64_C(0x6c44198c4a475817)
 };
 
-//==================//
-// Static Functions //
-//==================//
+// Schedules (K[t] + W[t]) of the padding block that follows a message of exactly one block:
+// a 0x80 marker, zeros, and a length of 512 or 1024 bits, none of which depends on the message
+const uint32_t SHA256_PAD_SCHEDULE[64] =
+{
+    UINT32_C(0xc28a2f98), UINT32_C(0x71374491), UINT32_C(0xb5c0fbcf), UINT32_C(0xe9b5dba5),
+    UINT32_C(0x3956c25b), UINT32_C(0x59f111f1), UINT32_C(0x923f82a4), UINT32_C(0xab1c5ed5),
+    UINT32_C(0xd807aa98), UINT32_C(0x12835b01), UINT32_C(0x243185be), UINT32_C(0x550c7dc3),
+    UINT32_C(0x72be5d74), UINT32_C(0x80deb1fe), UINT32_C(0x9bdc06a7), UINT32_C(0xc19bf374),
+    UINT32_C(0x649b69c1), UINT32_C(0xf0fe4786), UINT32_C(0x0fe1edc6), UINT32_C(0x240cf254),
+    UINT32_C(0x4fe9346f), UINT32_C(0x6cc984be), UINT32_C(0x61b9411e), UINT32_C(0x16f988fa),
+    UINT32_C(0xf2c65152), UINT32_C(0xa88e5a6d), UINT32_C(0xb019fc65), UINT32_C(0xb9d99ec7),
+    UINT32_C(0x9a1231c3), UINT32_C(0xe70eeaa0), UINT32_C(0xfdb1232b), UINT32_C(0xc7353eb0),
+    UINT32_C(0x3069bad5), UINT32_C(0xcb976d5f), UINT32_C(0x5a0f118f), UINT32_C(0xdc1eeefd),
+    UINT32_C(0x0a35b689), UINT32_C(0xde0b7a04), UINT32_C(0x58f4ca9d), UINT32_C(0xe15d5b16),
+    UINT32_C(0x007f3e86), UINT32_C(0x37088980), UINT32_C(0xa507ea32), UINT32_C(0x6fab9537),
+    UINT32_C(0x17406110), UINT32_C(0x0d8cd6f1), UINT32_C(0xcdaa3b6d), UINT32_C(0xc0bbbe37),
+    UINT32_C(0x83613bda), UINT32_C(0xdb48a363), UINT32_C(0x0b02e931), UINT32_C(0x6fd15ca7),
+    UINT32_C(0x521afaca), UINT32_C(0x31338431), UINT32_C(0x6ed41a95), UINT32_C(0x6d437890),
+    UINT32_C(0xc39c91f2), UINT32_C(0x9eccabbd), UINT32_C(0xb5c9a0e6), UINT32_C(0x532fb63c),
+    UINT32_C(0xd2c741c6), UINT32_C(0x07237ea3), UINT32_C(0xa4954b68), UINT32_C(0x4c191d76)
+};
 
-static uint64_t
-pad_message_to_512(
-    uint8_t * pad,
-    const uint64_t message_len
-);
+// Parts of the schedule W[0..63] of a 32-byte message's only block (the second block of
+// SHA-256d) that do not depend on the message: the padding words at t = 8..15, and from
+// t = 16 the expansion terms that read them (zero elsewhere)
+const uint32_t SHA256_HALF_PAD_WORDS[64] =
+{
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x80000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000100),
+    UINT32_C(0x00000000), UINT32_C(0x00a00000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000100), UINT32_C(0x11002000),
+    UINT32_C(0x80000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00400022), UINT32_C(0x00000100),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000),
+    UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000), UINT32_C(0x00000000)
+};
 
-static uint64_t
-pad_message_to_1024(
-    uint8_t * pad,
-    const uint64_t message_len
-);
-
-static uint32_t
-read_message_word_32(
-    const uint8_t * data,
-    const uint64_t data_length,
-    const uint8_t * pad,
-    const uint64_t block_index,
-    const uint8_t word_index
-);
-
-static uint64_t
-read_message_word_64(
-    const uint8_t * data,
-    const uint64_t data_length,
-    const uint8_t * pad,
-    const uint64_t block_index,
-    const uint8_t word_index
-);
-
-static uint32_t
-wrap_sum_32(int count, ...);
-
-static uint64_t
-wrap_sum_64(int count, ...);
-
-static uint32_t
-pack_32(const uint8_t * bytes);
-
-static uint64_t
-pack_64(const uint8_t * bytes);
+const uint64_t SHA512_PAD_SCHEDULE[80] =
+{
+    UINT64_C(0xc28a2f98d728ae22), UINT64_C(0x7137449123ef65cd),
+    UINT64_C(0xb5c0fbcfec4d3b2f), UINT64_C(0xe9b5dba58189dbbc),
+    UINT64_C(0x3956c25bf348b538), UINT64_C(0x59f111f1b605d019),
+    UINT64_C(0x923f82a4af194f9b), UINT64_C(0xab1c5ed5da6d8118),
+    UINT64_C(0xd807aa98a3030242), UINT64_C(0x12835b0145706fbe),
+    UINT64_C(0x243185be4ee4b28c), UINT64_C(0x550c7dc3d5ffb4e2),
+    UINT64_C(0x72be5d74f27b896f), UINT64_C(0x80deb1fe3b1696b1),
+    UINT64_C(0x9bdc06a725c71235), UINT64_C(0xc19bf174cf692a94),
+    UINT64_C(0x649b69c19ef14ad2), UINT64_C(0xf03e4786384f45f3),
+    UINT64_C(0x11c1adc68b8cd5b9), UINT64_C(0x240ca1dc77ad9c65),
+    UINT64_C(0x3df12c6f5b2b0295), UINT64_C(0x6a74852aaeb0e883),
+    UINT64_C(0xdcb4cbddcd4a0114), UINT64_C(0x36f988da845153c5),
+    UINT64_C(0x9b4761d2eea727cb), UINT64_C(0xad33ee6d37b932c2),
+    UINT64_C(0xc143c7fbb90f6167), UINT64_C(0x577487c7d5ef1fd6),
+    UINT64_C(0xe9250da555d6c804), UINT64_C(0x1652326c7c6f319c),
+    UINT64_C(0x9c73c1308a6abe80), UINT64_C(0xedcb859d96f4174f),
+    UINT64_C(0x05992bbc5302ea46), UINT64_C(0xc0515d8c72d32b21),
+    UINT64_C(0xe27760859b58b01c), UINT64_C(0xbd776eecd97e28bf),
+    UINT64_C(0xfec461e497d05dfb), UINT64_C(0x8c65848a09b42f15),
+    UINT64_C(0x1d93677302646f8d), UINT64_C(0x71d7625be0029f9b),
+    UINT64_C(0xed8c8b143b918647), UINT64_C(0x5813345c6ddd5e95),
+    UINT64_C(0x44837edc639f1da6), UINT64_C(0x65309e51db9245d4),
+    UINT64_C(0xa4de07e39af7c84c), UINT64_C(0xea208293cb3b3d17),
+    UINT64_C(0x33abda924feb6a30), UINT64_C(0x8965f30d8a442337),
+    UINT64_C(0x90808dcdb29ea41b), UINT64_C(0xe2d6d8dad96f92ca),
+    UINT64_C(0xfd690c3258486648), UINT64_C(0xddb95f897e662ce2),
+    UINT64_C(0x6b2b08dcc03f02bc), UINT64_C(0x261c68ddf66cc62c),
+    UINT64_C(0xa4f0eddd57c1364d), UINT64_C(0xe35537ec1f29acd2),
+    UINT64_C(0x27e70659eef7b721), UINT64_C(0xdabbb3bf5db9f4c8),
+    UINT64_C(0x34436c1241ad0e37), UINT64_C(0x0302752801d6306b),
+    UINT64_C(0xbf77d7d65bedd8cd), UINT64_C(0xa9871d46c85cd973),
+    UINT64_C(0x5fdbae1fae40e068), UINT64_C(0x468af1bb676f47b0),
+    UINT64_C(0x809520bd379dac58), UINT64_C(0x2766590af071ca9c),
+    UINT64_C(0xff96fca3577ecade), UINT64_C(0x1c490d6456b3b489),
+    UINT64_C(0xe85734c184192ce6), UINT64_C(0x2ba01930bbb71001),
+    UINT64_C(0xabe1acaf661e43eb), UINT64_C(0x120f3b5f15bf003d),
+    UINT64_C(0xfd7d4cd1515c8209), UINT64_C(0x9cfa18c629a0c327),
+    UINT64_C(0x7e39ff2d2a3f2fae), UINT64_C(0x2ff0a5398e575356),
+    UINT64_C(0xc9117833006d097e), UINT64_C(0x09d40c7849733ff8),
+    UINT64_C(0x774d7c8f5f3aa6bd), UINT64_C(0xe04b4161aa09de75)
+};
+
+// The same for a 64-byte message's only block in the 64-bit family: padding words at
+// t = 8..15 (a 1024-bit block holding a 512-bit message), then the terms that read them
+const uint64_t SHA512_HALF_PAD_WORDS[80] =
+{
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x8000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000200),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0040000000001008),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000200), UINT64_C(0x4180000000000000),
+    UINT64_C(0x8000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000106), UINT64_C(0x0000000000000200),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000),
+    UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000)
+};
 
 //============================//
 // Hash-Computation Functions //
 //============================//
 
 void
-compute_160(
+compute_32(
+    const compressor_32_t compress,
     uint32_t * hash_words, 
     const uint8_t * message, 
     const uint64_t message_len
 )
 {
-    // Data pre-processing
-    uint8_t pad[72] = { 0x00 };
-    uint64_t block_count = pad_message_to_512(pad, message_len);
+    // Complete blocks are compressed straight from the message
+    uint64_t block_count = message_len / UINT64_C(64);
+    compress(hash_words, message, block_count);
+
+    // Trailing bytes and padding make up the final one or two blocks
+    uint8_t tail[128];
+    uint8_t remainder_len = (uint8_t)(message_len % UINT64_C(64));
+    uint8_t tail_blocks = pad_final_512(
+        tail, message + (message_len - remainder_len), remainder_len, message_len);
 
-    // Message-block iteration
-    uint32_t message_schedule[80] = { 0x00 };
-    uint32_t a, b, c, d, e, tmp;
-    uint8_t t;
+    compress(hash_words, tail, tail_blocks);
+}
 
-    for (uint64_t i = 0; i < block_count; ++i)
+void
+compute_64(
+    const compressor_64_t compress,
+    uint64_t * hash_words, 
+    const uint8_t * message, 
+    const uint64_t message_len
+)
+{
+    // Complete blocks are compressed straight from the message
+    uint64_t block_count = message_len / UINT64_C(128);
+    compress(hash_words, message, block_count);
+
+    // Trailing bytes and padding make up the final one or two blocks
+    uint8_t tail[256];
+    uint8_t remainder_len = (uint8_t)(message_len % UINT64_C(128));
+    uint8_t tail_blocks = pad_final_1024(
+        tail, message + (message_len - remainder_len), remainder_len, message_len);
+
+    compress(hash_words, tail, tail_blocks);
+}
+
+int
+compute_short_32(
+    const sha_descriptor * algorithm,
+    uint32_t * hash_words,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    uint8_t block[64];
+    uint32_t words[8];
+
+    // One message block, then a padding block whose schedule is a constant
+    if (message_len == 64 && algorithm->pad_schedule)
     {
-        // Message-schedule preparation
-        // t = 0..16 (32-bit words from message block)
-        for (t = 0; t < 16; ++t)
-        {
-            message_schedule[t] = 
-                read_message_word_32(message, message_len, pad, i, t);
-        }
+        algorithm->compressor_32(message_len)(hash_words, message, 1);
+        algorithm->sched_compressor_32(message_len)(hash_words, algorithm->pad_schedule);
+        return 1;
+    }
 
-        // t = 16..80
-        for (; t < 80; ++t)
-        {
-            tmp = message_schedule[t - 3] 
-                ^ message_schedule[t - 8] 
-                ^ message_schedule[t - 14] 
-                ^ message_schedule[t - 16];
+    // Half a block: the kernel supplies the padding words itself
+    if (message_len == 32 && algorithm->pad_schedule)
+    {
+        for (uint8_t w = 0; w < 8; ++w)
+            words[w] = load_be32(message + (w << 2));
 
-            message_schedule[t] = ROTL(tmp, 1);
-        }
+        algorithm->half_compressor_32(message_len)(hash_words, words);
+        return 1;
+    }
 
-        // Hash calculations
-        a = hash_words[0];
-        b = hash_words[1];
-        c = hash_words[2];
-        d = hash_words[3];
-        e = hash_words[4];
+    if (message_len > 55)
+        return 0;
 
-        for (t = 0; t < 20; ++t)
-        {
-            tmp = wrap_sum_32(5,
-                ROTL(a, 5),
-                CH(b, c, d),
-                e,
-                SHA1_CONSTANTS[0],
-                message_schedule[t]);
-            
-            e = d;
-            d = c;
-            c = ROTL(b, 30);
-            b = a;
-            a = tmp;
-        }
+    // Message, 0x80 marker and length share one block
+    if (message_len)
+        memcpy(block, message, (size_t)message_len);
 
-        for (; t < 40; ++t)
-        {
-            tmp = wrap_sum_32(5,
-                ROTL(a, 5),
-                PARITY(b, c, d),
-                e,
-                SHA1_CONSTANTS[1],
-                message_schedule[t]);
-            
-            e = d;
-            d = c;
-            c = ROTL(b, 30);
-            b = a;
-            a = tmp;
-        }
+    block[message_len] = 0x80;
+    memset(block + message_len + 1, 0x00, 55 - (size_t)message_len);
+    store_be64(block + 56, message_len << 3);
 
-        for (; t < 60; ++t)
-        {
-            tmp = wrap_sum_32(5,
-                ROTL(a, 5),
-                MAJ(b, c, d),
-                e,
-                SHA1_CONSTANTS[2],
-                message_schedule[t]);
-            
-            e = d;
-            d = c;
-            c = ROTL(b, 30);
-            b = a;
-            a = tmp;
-        }
+    algorithm->compressor_32(message_len)(hash_words, block, 1);
+    return 1;
+}
 
-        for (; t < 80; ++t)
-        {
-            tmp = wrap_sum_32(5,
-                ROTL(a, 5),
-                PARITY(b, c, d),
-                e,
-                SHA1_CONSTANTS[3],
-                message_schedule[t]);
-            
-            e = d;
-            d = c;
-            c = ROTL(b, 30);
-            b = a;
-            a = tmp;
-        }
+int
+compute_short_64(
+    const sha_descriptor * algorithm,
+    uint64_t * hash_words,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    uint8_t block[128];
+    uint64_t words[8];
+
+    // One message block, then a padding block whose schedule is a constant
+    if (message_len == 128 && algorithm->pad_schedule)
+    {
+        algorithm->compressor_64(message_len)(hash_words, message, 1);
+        algorithm->sched_compressor_64(message_len)(hash_words, algorithm->pad_schedule);
+        return 1;
+    }
+
+    // Half a block: the kernel supplies the padding words itself
+    if (message_len == 64 && algorithm->pad_schedule)
+    {
+        for (uint8_t w = 0; w < 8; ++w)
+            words[w] = load_be64(message + (w << 3));
 
-        hash_words[0] = wrap_sum_32(2, hash_words[0], a);
-        hash_words[1] = wrap_sum_32(2, hash_words[1], b);
-        hash_words[2] = wrap_sum_32(2, hash_words[2], c);
-        hash_words[3] = wrap_sum_32(2, hash_words[3], d);
-        hash_words[4] = wrap_sum_32(2, hash_words[4], e);
+        algorithm->half_compressor_64(message_len)(hash_words, words);
+        return 1;
     }
+
+    if (message_len > 111)
+        return 0;
+
+    // Message, 0x80 marker and length share one block (the length's high word is zero)
+    if (message_len)
+        memcpy(block, message, (size_t)message_len);
+
+    block[message_len] = 0x80;
+    memset(block + message_len + 1, 0x00, 119 - (size_t)message_len);
+    store_be64(block + 120, message_len << 3);
+
+    algorithm->compressor_64(message_len)(hash_words, block, 1);
+    return 1;
 }
 
+//==============================//
+// Scalar Compression Functions //
+//==============================//
+
+// Message-schedule words live in a 16-word ring: W[t] overwrites W[t - 16]
+#define W(t) message_schedule[(t) & 15]
+
+#define SCHEDULE_160(t) \
+    (W(t) = ROTL(W((t) - 3) ^ W((t) - 8) ^ W((t) - 14) ^ W(t), 1))
+
+#define SCHEDULE_256(t) \
+    (W(t) += LSIGMA1_256(W((t) - 2)) + W((t) - 7) + LSIGMA0_256(W((t) - 15)))
+
+#define SCHEDULE_512(t) \
+    (W(t) += LSIGMA1_512(W((t) - 2)) + W((t) - 7) + LSIGMA0_512(W((t) - 15)))
+
+// Single rounds with the working variables passed in rotated order,
+// so the unrolled sequence never shuffles registers
+// (t is a constant in every expansion, so the t >= 16 test folds away)
+#define ROUND_160(a, b, c, d, e, f, k, t)                                  \
+    do                                                                     \
+    {                                                                      \
+        if ((t) >= 16)                                                     \
+            SCHEDULE_160(t);                                               \
+        (e) += ROTL((a), 5) + f((b), (c), (d)) + (k) + W(t);               \
+        (b) = ROTL((b), 30);                                               \
+    } while (0)
+
+#define ROUND_256(a, b, c, d, e, f, g, h, t)                               \
+    do                                                                     \
+    {                                                                      \
+        if ((t) >= 16)                                                     \
+            SCHEDULE_256(t);                                               \
+        tmp = (h) + SIGMA1_256((e)) + CH((e), (f), (g))                    \
+            + SHA256_CONSTANTS[t] + W(t);                                  \
+        (d) += tmp;                                                        \
+        (h) = tmp + SIGMA0_256((a)) + MAJ((a), (b), (c));                  \
+    } while (0)
+
+#define ROUND_512(a, b, c, d, e, f, g, h, t)                               \
+    do                                                                     \
+    {                                                                      \
+        if ((t) >= 16)                                                     \
+            SCHEDULE_512(t);                                               \
+        tmp = (h) + SIGMA1_512((e)) + CH((e), (f), (g))                    \
+            + SHA512_CONSTANTS[t] + W(t);                                  \
+        (d) += tmp;                                                        \
+        (h) = tmp + SIGMA0_512((a)) + MAJ((a), (b), (c));                  \
+    } while (0)
+
+// Rounds over a precomputed schedule (K[t] + W[t] in one word)
+#define SCHED_ROUND_256(a, b, c, d, e, f, g, h, t)                         \
+    do                                                                     \
+    {                                                                      \
+        tmp = (h) + SIGMA1_256((e)) + CH((e), (f), (g)) + schedule[t];     \
+        (d) += tmp;                                                        \
+        (h) = tmp + SIGMA0_256((a)) + MAJ((a), (b), (c));                  \
+    } while (0)
+
+#define SCHED_ROUND_512(a, b, c, d, e, f, g, h, t)                         \
+    do                                                                     \
+    {                                                                      \
+        tmp = (h) + SIGMA1_512((e)) + CH((e), (f), (g)) + schedule[t];     \
+        (d) += tmp;                                                        \
+        (h) = tmp + SIGMA0_512((a)) + MAJ((a), (b), (c));                  \
+    } while (0)
+
+// Rounds over a half-filled block (a 32-byte message in SHA-256, 64 bytes in the
+// 64-bit family): schedule words 8..15 are padding, so they and the expansion
+// terms that read them are taken precomputed
+// (t is a constant in every expansion, so each HALF_PADDING() test folds away)
+#define HALF_SCHEDULE_256(t)                                               \
+    (W(t) = SHA256_HALF_PAD_WORDS[t]                                       \
+        + (HALF_PADDING((t) - 2) ? 0 : LSIGMA1_256(W((t) - 2)))            \
+        + (HALF_PADDING((t) - 7) ? 0 : W((t) - 7))                         \
+        + (HALF_PADDING((t) - 15) ? 0 : LSIGMA0_256(W((t) - 15)))          \
+        + (HALF_PADDING((t) - 16) ? 0 : W((t) - 16)))
+
+#define HALF_ROUND_256(a, b, c, d, e, f, g, h, t)                          \
+    do                                                                     \
+    {                                                                      \
+        if ((t) >= 16)                                                     \
+            HALF_SCHEDULE_256(t);                                          \
+        tmp = (h) + SIGMA1_256((e)) + CH((e), (f), (g))                    \
+            + SHA256_CONSTANTS[t]                                          \
+            + (HALF_PADDING(t) ? SHA256_HALF_PAD_WORDS[t] : W(t));         \
+        (d) += tmp;                                                        \
+        (h) = tmp + SIGMA0_256((a)) + MAJ((a), (b), (c));                  \
+    } while (0)
+
+#define HALF_SCHEDULE_512(t)                                               \
+    (W(t) = SHA512_HALF_PAD_WORDS[t]                                       \
+        + (HALF_PADDING((t) - 2) ? 0 : LSIGMA1_512(W((t) - 2)))            \
+        + (HALF_PADDING((t) - 7) ? 0 : W((t) - 7))                         \
+        + (HALF_PADDING((t) - 15) ? 0 : LSIGMA0_512(W((t) - 15)))          \
+        + (HALF_PADDING((t) - 16) ? 0 : W((t) - 16)))
+
+#define HALF_ROUND_512(a, b, c, d, e, f, g, h, t)                          \
+    do                                                                     \
+    {                                                                      \
+        if ((t) >= 16)                                                     \
+            HALF_SCHEDULE_512(t);                                          \
+        tmp = (h) + SIGMA1_512((e)) + CH((e), (f), (g))                    \
+            + SHA512_CONSTANTS[t]                                          \
+            + (HALF_PADDING(t) ? SHA512_HALF_PAD_WORDS[t] : W(t));         \
+        (d) += tmp;                                                        \
+        (h) = tmp + SIGMA0_512((a)) + MAJ((a), (b), (c));                  \
+    } while (0)
+
+// Groups of rounds after which the working variables are back in place
+#define ROUNDS5_160(f, k, t)                       \
+    ROUND_160(a, b, c, d, e, f, k, (t));           \
+    ROUND_160(e, a, b, c, d, f, k, (t) + 1);       \
+    ROUND_160(d, e, a, b, c, f, k, (t) + 2);       \
+    ROUND_160(c, d, e, a, b, f, k, (t) + 3);       \
+    ROUND_160(b, c, d, e, a, f, k, (t) + 4)
+
+#define ROUNDS20_160(f, k, t)                      \
+    ROUNDS5_160(f, k, (t));                        \
+    ROUNDS5_160(f, k, (t) + 5);                    \
+    ROUNDS5_160(f, k, (t) + 10);                   \
+    ROUNDS5_160(f, k, (t) + 15)
+
+#define ROUNDS8(ROUND, t)                          \
+    ROUND(a, b, c, d, e, f, g, h, (t));            \
+    ROUND(h, a, b, c, d, e, f, g, (t) + 1);        \
+    ROUND(g, h, a, b, c, d, e, f, (t) + 2);        \
+    ROUND(f, g, h, a, b, c, d, e, (t) + 3);        \
+    ROUND(e, f, g, h, a, b, c, d, (t) + 4);        \
+    ROUND(d, e, f, g, h, a, b, c, (t) + 5);        \
+    ROUND(c, d, e, f, g, h, a, b, (t) + 6);        \
+    ROUND(b, c, d, e, f, g, h, a, (t) + 7)
+
 void
-compute_256(
+compress_160_scalar(
     uint32_t * hash_words, 
-    const uint8_t * message, 
-    const uint64_t message_len
+    const uint8_t * blocks, 
+    const uint64_t block_count
 )
 {
-    // Data pre-processing
-    uint8_t pad[72] = { 0x00 };
-    uint64_t block_count = pad_message_to_512(pad, message_len);
+    uint32_t message_schedule[16];
+    uint32_t a, b, c, d, e;
 
-    // Message-block iteration
-    uint32_t message_schedule[64] = { 0x00 };
-    uint32_t a, b, c, d, e, f, g, h, tmp1, tmp2;
-    uint8_t t;
-
-    for (uint64_t i = 0; i < block_count; ++i)
+    for (uint64_t i = 0; i < block_count; ++i, blocks += 64)
     {
         // Message-schedule preparation
         // t = 0..16 (32-bit words from message block)
-        for (t = 0; t < 16; ++t)
-        {
-            message_schedule[t] =
-                read_message_word_32(message, message_len, pad, i, t);
-        }
-
-        // t = 16..64
-        for (; t < 64; ++t)
+        // t = 16..80 are expanded in place as the rounds consume them
+        for (uint8_t t = 0; t < 16; ++t)
         {
-            message_schedule[t] = wrap_sum_32(4,
-                LSIGMA1_256(message_schedule[t - 2]),
-                message_schedule[t - 7],
-                LSIGMA0_256(message_schedule[t - 15]),
-                message_schedule[t - 16]);
+            message_schedule[t] = load_be32(blocks + (t << 2));
         }
 
         // Hash calculations
@@ -274,76 +514,38 @@ compute_256(
         c = hash_words[2];
         d = hash_words[3];
         e = hash_words[4];
-        f = hash_words[5];
-        g = hash_words[6];
-        h = hash_words[7];
 
-        for (t = 0; t < 64; ++t)
-        {
-            tmp1 = wrap_sum_32(5,
-                h,
-                SIGMA1_256(e),
-                CH(e, f, g),
-                (uint32_t)(SHA2_CONSTANTS[t] >> 32),
-                message_schedule[t]);
-
-            tmp2 = wrap_sum_32(2, SIGMA0_256(a), MAJ(a, b, c));
-
-            h = g;
-            g = f;
-            f = e;
-            e = wrap_sum_32(2, d, tmp1);
-            d = c;
-            c = b;
-            b = a;
-            a = wrap_sum_32(2, tmp1, tmp2);
-        }
+        ROUNDS20_160(CH, SHA1_CONSTANTS[0], 0);
+        ROUNDS20_160(PARITY, SHA1_CONSTANTS[1], 20);
+        ROUNDS20_160(MAJ, SHA1_CONSTANTS[2], 40);
+        ROUNDS20_160(PARITY, SHA1_CONSTANTS[3], 60);
 
-        hash_words[0] = wrap_sum_32(2, hash_words[0], a);
-        hash_words[1] = wrap_sum_32(2, hash_words[1], b);
-        hash_words[2] = wrap_sum_32(2, hash_words[2], c);
-        hash_words[3] = wrap_sum_32(2, hash_words[3], d);
-        hash_words[4] = wrap_sum_32(2, hash_words[4], e);
-        hash_words[5] = wrap_sum_32(2, hash_words[5], f);
-        hash_words[6] = wrap_sum_32(2, hash_words[6], g);
-        hash_words[7] = wrap_sum_32(2, hash_words[7], h);
+        hash_words[0] += a;
+        hash_words[1] += b;
+        hash_words[2] += c;
+        hash_words[3] += d;
+        hash_words[4] += e;
     }
 }
 
 void
-compute_512(
-    uint64_t * hash_words, 
-    const uint8_t * message, 
-    const uint64_t message_len
+compress_256_scalar(
+    uint32_t * hash_words, 
+    const uint8_t * blocks, 
+    const uint64_t block_count
 )
 {
-    // Data pre-processing
-    uint8_t pad[144] = { 0x00 };
-    uint64_t block_count = pad_message_to_1024(pad, message_len);
-
-    // Message-block iteration
-    uint64_t message_schedule[80] = { 0x00 };
-    uint64_t a, b, c, d, e, f, g, h, tmp1, tmp2;
-    uint8_t t;
+    uint32_t message_schedule[16];
+    uint32_t a, b, c, d, e, f, g, h, tmp;
 
-    for (uint64_t i = 0; i < block_count; ++i)
+    for (uint64_t i = 0; i < block_count; ++i, blocks += 64)
     {
         // Message-schedule preparation
-        // t = 0..16 (64-bit words from message block)
-        for (t = 0; t < 16; ++t)
-        {
-            message_schedule[t] = 
-                read_message_word_64(message, message_len, pad, i, t);
-        }
-
-        // t = 16..80
-        for (; t < 80; ++t)
+        // t = 0..16 (32-bit words from message block)
+        // t = 16..64 are expanded in place as the rounds consume them
+        for (uint8_t t = 0; t < 16; ++t)
         {
-            message_schedule[t] = wrap_sum_64(4,
-                LSIGMA1_512(message_schedule[t - 2]),
-                message_schedule[t - 7],
-                LSIGMA0_512(message_schedule[t - 15]),
-                message_schedule[t - 16]);
+            message_schedule[t] = load_be32(blocks + (t << 2));
         }
 
         // Hash calculations
@@ -356,393 +558,335 @@ compute_512(
         g = hash_words[6];
         h = hash_words[7];
 
-        for (t = 0; t < 80; ++t)
-        {
-            tmp1 = wrap_sum_64(5,
-                h,
-                SIGMA1_512(e),
-                CH(e, f, g),
-                SHA2_CONSTANTS[t],
-                message_schedule[t]);
-
-            tmp2 = wrap_sum_64(2, SIGMA0_512(a), MAJ(a, b, c));
-
-            h = g;
-            g = f;
-            f = e;
-            e = wrap_sum_64(2, d, tmp1);
-            d = c;
-            c = b;
-            b = a;
-            a = wrap_sum_64(2, tmp1, tmp2);
-        }
-
-        hash_words[0] = wrap_sum_64(2, hash_words[0], a);
-        hash_words[1] = wrap_sum_64(2, hash_words[1], b);
-        hash_words[2] = wrap_sum_64(2, hash_words[2], c);
-        hash_words[3] = wrap_sum_64(2, hash_words[3], d);
-        hash_words[4] = wrap_sum_64(2, hash_words[4], e);
-        hash_words[5] = wrap_sum_64(2, hash_words[5], f);
-        hash_words[6] = wrap_sum_64(2, hash_words[6], g);
-        hash_words[7] = wrap_sum_64(2, hash_words[7], h);
+        ROUNDS8(ROUND_256, 0);
+        ROUNDS8(ROUND_256, 8);
+        ROUNDS8(ROUND_256, 16);
+        ROUNDS8(ROUND_256, 24);
+        ROUNDS8(ROUND_256, 32);
+        ROUNDS8(ROUND_256, 40);
+        ROUNDS8(ROUND_256, 48);
+        ROUNDS8(ROUND_256, 56);
+
+        hash_words[0] += a;
+        hash_words[1] += b;
+        hash_words[2] += c;
+        hash_words[3] += d;
+        hash_words[4] += e;
+        hash_words[5] += f;
+        hash_words[6] += g;
+        hash_words[7] += h;
     }
 }
 
-//=======================//
-// Misc Shared Functions //
-//=======================//
-
 void
-unpack_32(
-    uint8_t * buf, 
-    const uint32_t * words, 
-    const uint8_t byte_count, 
-    const ShaDigestFormat format
+compress_512_scalar(
+    uint64_t * hash_words, 
+    const uint8_t * blocks, 
+    const uint64_t block_count
 )
 {
-    uint8_t word_index, pos_in_word, r_shift;
+    uint64_t message_schedule[16];
+    uint64_t a, b, c, d, e, f, g, h, tmp;
 
-    if (!format)
+    for (uint64_t i = 0; i < block_count; ++i, blocks += 128)
     {
-        for (uint8_t i = 0; i < byte_count; ++i)
+        // Message-schedule preparation
+        // t = 0..16 (64-bit words from message block)
+        // t = 16..80 are expanded in place as the rounds consume them
+        for (uint8_t t = 0; t < 16; ++t)
         {
-            word_index = i / 4;
-            pos_in_word = i % 4;
-            r_shift = (3 - pos_in_word) << 3;
-            *(buf++) = (uint8_t)(words[word_index] >> r_shift);
+            message_schedule[t] = load_be64(blocks + (t << 3));
         }
 
-        return;
-    }
-    
-    uint8_t byte, digit, a_add;
-
-    a_add = (format == HEX_STRING_UPPER ? 'A' : 'a') - 10;
+        // Hash calculations
+        a = hash_words[0];
+        b = hash_words[1];
+        c = hash_words[2];
+        d = hash_words[3];
+        e = hash_words[4];
+        f = hash_words[5];
+        g = hash_words[6];
+        h = hash_words[7];
 
-    for (uint8_t i = 0; i < byte_count; ++i)
-    {
-        word_index = i / 4;
-        pos_in_word = i % 4;
-        r_shift = (3 - pos_in_word) << 3;
-        byte = (uint8_t)(words[word_index] >> r_shift);
-
-        // Parse left hex digit
-        digit = byte / 16;
-        *(buf++) = digit + (digit < 10 ? '0' : a_add);
-
-        // Parse right hex digit
-        digit = byte % 16;
-        *(buf++) = digit + (digit < 10 ? '0' : a_add);
+        ROUNDS8(ROUND_512, 0);
+        ROUNDS8(ROUND_512, 8);
+        ROUNDS8(ROUND_512, 16);
+        ROUNDS8(ROUND_512, 24);
+        ROUNDS8(ROUND_512, 32);
+        ROUNDS8(ROUND_512, 40);
+        ROUNDS8(ROUND_512, 48);
+        ROUNDS8(ROUND_512, 56);
+        ROUNDS8(ROUND_512, 64);
+        ROUNDS8(ROUND_512, 72);
+
+        hash_words[0] += a;
+        hash_words[1] += b;
+        hash_words[2] += c;
+        hash_words[3] += d;
+        hash_words[4] += e;
+        hash_words[5] += f;
+        hash_words[6] += g;
+        hash_words[7] += h;
     }
-
-    *buf = '\0';
 }
 
+//===========================================//
+// Scalar Fixed-Length Compression Functions //
+//===========================================//
+
 void
-unpack_64(
-    uint8_t * buf, 
-    const uint64_t * words, 
-    const uint8_t byte_count, 
-    const ShaDigestFormat format
+compress_sched_256_scalar(
+    uint32_t * hash_words,
+    const uint32_t * schedule
 )
 {
-    uint8_t word_index, pos_in_word, r_shift;
-
-    if (!format)
-    {
-        for (uint8_t i = 0; i < byte_count; ++i)
-        {
-            word_index = i / 8;
-            pos_in_word = i % 8;
-            r_shift = (7 - (pos_in_word)) << 3;
-            *(buf++) = (uint8_t)(words[word_index] >> r_shift);
-        }
-
-        return;
-    }
-
-    uint8_t byte, digit, a_add;
-    a_add = (format == HEX_STRING_UPPER ? 'A' : 'a') - 10;
-
-    for (uint8_t i = 0; i < byte_count; ++i)
-    {
-        word_index = i / 8;
-        pos_in_word = i % 8;
-        r_shift = (7 - (pos_in_word)) << 3;
-        byte = (uint8_t)(words[word_index] >> r_shift);
-
-        // Parse left hex digit
-        digit = byte / 16;
-        *(buf++) = digit + (digit < 10 ? '0' : a_add);
-
-        // Parse right hex digit
-        digit = byte % 16;
-        *(buf++) = digit + (digit < 10 ? '0' : a_add);
-    }
-
-    *buf = '\0';
+    uint32_t a, b, c, d, e, f, g, h, tmp;
+
+    a = hash_words[0];
+    b = hash_words[1];
+    c = hash_words[2];
+    d = hash_words[3];
+    e = hash_words[4];
+    f = hash_words[5];
+    g = hash_words[6];
+    h = hash_words[7];
+
+    ROUNDS8(SCHED_ROUND_256, 0);
+    ROUNDS8(SCHED_ROUND_256, 8);
+    ROUNDS8(SCHED_ROUND_256, 16);
+    ROUNDS8(SCHED_ROUND_256, 24);
+    ROUNDS8(SCHED_ROUND_256, 32);
+    ROUNDS8(SCHED_ROUND_256, 40);
+    ROUNDS8(SCHED_ROUND_256, 48);
+    ROUNDS8(SCHED_ROUND_256, 56);
+
+    hash_words[0] += a;
+    hash_words[1] += b;
+    hash_words[2] += c;
+    hash_words[3] += d;
+    hash_words[4] += e;
+    hash_words[5] += f;
+    hash_words[6] += g;
+    hash_words[7] += h;
 }
 
-//=============================//
-// Static-Function Definitions //
-//=============================//
-
-static uint64_t
-pad_message_to_512(
-    uint8_t * pad,
-    const uint64_t message_len
+void
+compress_sched_512_scalar(
+    uint64_t * hash_words,
+    const uint64_t * schedule
 )
 {
-    // Complete blocks in message (prior to padding)
-    uint64_t block_count = message_len / UINT64_C(64);
-
-    uint8_t k, mod64;
-    mod64 = (uint8_t)(message_len % UINT64_C(64));
-
-    // k = number of 0x00 padding bytes
-    // Increment block_count to reflect padding
-    if (mod64 < 56)
-    {
-        k = 55 - mod64;
-        ++block_count;
-    }
-    else
-    {
-        k = 119 - mod64;
-        block_count += 2;
-    }
-
-    // Set 1 bit at start of pad
-    pad[0] = 0x80;
-
-    // Set message length in bits as last 64 bits of pad
-    uint64_t bits = message_len << 3;
-    unpack_64(pad + k + 1, &bits, 8, OCTET_ARRAY);
-
-    // Return message block count (including padding)
-    return block_count;
+    uint64_t a, b, c, d, e, f, g, h, tmp;
+
+    a = hash_words[0];
+    b = hash_words[1];
+    c = hash_words[2];
+    d = hash_words[3];
+    e = hash_words[4];
+    f = hash_words[5];
+    g = hash_words[6];
+    h = hash_words[7];
+
+    ROUNDS8(SCHED_ROUND_512, 0);
+    ROUNDS8(SCHED_ROUND_512, 8);
+    ROUNDS8(SCHED_ROUND_512, 16);
+    ROUNDS8(SCHED_ROUND_512, 24);
+    ROUNDS8(SCHED_ROUND_512, 32);
+    ROUNDS8(SCHED_ROUND_512, 40);
+    ROUNDS8(SCHED_ROUND_512, 48);
+    ROUNDS8(SCHED_ROUND_512, 56);
+    ROUNDS8(SCHED_ROUND_512, 64);
+    ROUNDS8(SCHED_ROUND_512, 72);
+
+    hash_words[0] += a;
+    hash_words[1] += b;
+    hash_words[2] += c;
+    hash_words[3] += d;
+    hash_words[4] += e;
+    hash_words[5] += f;
+    hash_words[6] += g;
+    hash_words[7] += h;
 }
 
-static uint64_t
-pad_message_to_1024(
-    uint8_t * pad,
-    const uint64_t message_len
+void
+compress_half_256_scalar(
+    uint32_t * hash_words,
+    const uint32_t * words
 )
 {
-    // Complete blocks in message (prior to padding)
-    uint64_t block_count = message_len / UINT64_C(128);
-
-    uint8_t k, mod128;
-    mod128 = (uint8_t)(message_len % UINT64_C(128));
+    uint32_t message_schedule[16];
+    uint32_t a, b, c, d, e, f, g, h, tmp;
 
-    // k = number of 0x00 padding bytes
-    // Increment block_count to reflect padding
-    if (mod128 < 112)
+    // Message words; the padding words and every schedule term read from
+    // them come from SHA256_HALF_PAD_WORDS
+    for (uint8_t t = 0; t < 8; ++t)
     {
-        k = 111 - mod128;
-        ++block_count;
+        message_schedule[t] = words[t];
     }
-    else
-    {
-        k = 239 - mod128;
-        block_count += 2;
-    }
-
-    // Set 1 bit at start of pad
-    pad[0] = 0x80;
 
-    // Set message length in bits as last 128 bits of pad
-    uint64_t bits[2] = 
-    {
-        (message_len & UINT64_C(0xE000000000000000)) >> 61,
-        (message_len & SHA256_MAX_MSG_LEN) << 3
-    };
-
-    unpack_64(pad + k + 1, bits, 16, OCTET_ARRAY);
-
-    // Return message block count (including padding)
-    return block_count;
+    a = hash_words[0];
+    b = hash_words[1];
+    c = hash_words[2];
+    d = hash_words[3];
+    e = hash_words[4];
+    f = hash_words[5];
+    g = hash_words[6];
+    h = hash_words[7];
+
+    ROUNDS8(HALF_ROUND_256, 0);
+    ROUNDS8(HALF_ROUND_256, 8);
+    ROUNDS8(HALF_ROUND_256, 16);
+    ROUNDS8(HALF_ROUND_256, 24);
+    ROUNDS8(HALF_ROUND_256, 32);
+    ROUNDS8(HALF_ROUND_256, 40);
+    ROUNDS8(HALF_ROUND_256, 48);
+    ROUNDS8(HALF_ROUND_256, 56);
+
+    hash_words[0] += a;
+    hash_words[1] += b;
+    hash_words[2] += c;
+    hash_words[3] += d;
+    hash_words[4] += e;
+    hash_words[5] += f;
+    hash_words[6] += g;
+    hash_words[7] += h;
 }
 
-static uint32_t
-read_message_word_32(
-    const uint8_t * message,
-    const uint64_t message_len,
-    const uint8_t * pad,
-    const uint64_t block_index,
-    const uint8_t word_index
+void
+compress_half_512_scalar(
+    uint64_t * hash_words,
+    const uint64_t * words
 )
 {
-    uint64_t start_byte = (block_index * 64) + (word_index * 4);
-
-    // Complete 32-bit word from input data
-    if ((message_len >= 4) && (start_byte < message_len - 3))
-        return pack_32(message + start_byte);
+    uint64_t message_schedule[16];
+    uint64_t a, b, c, d, e, f, g, h, tmp;
 
-    // Complete 32-bit word from padding bytes
-    if (start_byte >= message_len)
-        return pack_32(pad + (start_byte - message_len));
-
-    // 32-bit word that spans input data and padding bytes
-    uint32_t word = 0;
-    uint64_t message_index;
-    uint8_t partial_len, byte_pos, l_shift;
-    partial_len = (uint8_t)(message_len % 4);
-
-    for (byte_pos = 0; byte_pos < partial_len; ++byte_pos)
+    // Message words; the padding words and every schedule term read from
+    // them come from SHA512_HALF_PAD_WORDS
+    for (uint8_t t = 0; t < 8; ++t)
     {
-        message_index = message_len - partial_len + byte_pos;
-        l_shift = (3 - byte_pos) << 3;
-        word |= (uint32_t)message[message_index] << l_shift;
+        message_schedule[t] = words[t];
     }
 
-    for (; byte_pos < 4; ++byte_pos)
-    {
-        l_shift = (3 - byte_pos) << 3;
-        word |= (uint32_t)pad[byte_pos - partial_len] << l_shift;
-    }
-    
-    return word;
-    
+    a = hash_words[0];
+    b = hash_words[1];
+    c = hash_words[2];
+    d = hash_words[3];
+    e = hash_words[4];
+    f = hash_words[5];
+    g = hash_words[6];
+    h = hash_words[7];
+
+    ROUNDS8(HALF_ROUND_512, 0);
+    ROUNDS8(HALF_ROUND_512, 8);
+    ROUNDS8(HALF_ROUND_512, 16);
+    ROUNDS8(HALF_ROUND_512, 24);
+    ROUNDS8(HALF_ROUND_512, 32);
+    ROUNDS8(HALF_ROUND_512, 40);
+    ROUNDS8(HALF_ROUND_512, 48);
+    ROUNDS8(HALF_ROUND_512, 56);
+    ROUNDS8(HALF_ROUND_512, 64);
+    ROUNDS8(HALF_ROUND_512, 72);
+
+    hash_words[0] += a;
+    hash_words[1] += b;
+    hash_words[2] += c;
+    hash_words[3] += d;
+    hash_words[4] += e;
+    hash_words[5] += f;
+    hash_words[6] += g;
+    hash_words[7] += h;
 }
 
-static uint64_t
-read_message_word_64(
-    const uint8_t * message,
-    const uint64_t message_len,
-    const uint8_t * pad,
-    const uint64_t block_index,
-    const uint8_t word_index
+//===================//
+// Padding Functions //
+//===================//
+
+uint8_t
+pad_final_512(
+    uint8_t * tail,
+    const uint8_t * remainder,
+    const uint8_t remainder_len,
+    const uint64_t message_len
 )
 {
-    uint64_t start_byte = (block_index * 128) + (word_index * 8);
+    // One block if the 0x80 marker and 64-bit length still fit, two otherwise
+    uint8_t block_count = (remainder_len < 56) ? 1 : 2;
+    uint8_t tail_len = block_count << 6;
 
-    // Complete 64-bit word from input data
-    if ((message_len >= 8) && (start_byte < message_len - 7))
-        return pack_64(message + start_byte);
+    if (remainder_len)
+        memcpy(tail, remainder, remainder_len);
 
-    // Complete 64-bit word from padding bytes
-    if (start_byte >= message_len)
-        return pack_64(pad + (start_byte - message_len));
+    // Set 1 bit after the message, zero-fill up to the length field
+    tail[remainder_len] = 0x80;
+    memset(tail + remainder_len + 1, 0x00, tail_len - remainder_len - 9);
 
-    // 64-bit word that spans input data and padding bytes
-    uint64_t word = 0;
-    uint64_t message_index;
-    uint8_t partial_len, byte_pos, l_shift;
-    partial_len = (uint8_t)(message_len % 8);
+    // Set message length in bits as last 64 bits of tail
+    store_be64(tail + tail_len - 8, message_len << 3);
 
-    for (byte_pos = 0; byte_pos < partial_len; ++byte_pos)
-    {
-        message_index = message_len - partial_len + byte_pos;
-        l_shift = (7 - byte_pos) << 3;
-        word |= (uint64_t)message[message_index] << l_shift;
-    }
-
-    for (; byte_pos < 8; ++byte_pos)
-    {
-        l_shift = (7 - byte_pos) << 3;
-        word |= (uint64_t)pad[byte_pos - partial_len] << l_shift;
-    }
-    
-    return word;
+    return block_count;
 }
 
-static uint32_t
-wrap_sum_32(int count, ...)
+uint8_t
+pad_final_1024(
+    uint8_t * tail,
+    const uint8_t * remainder,
+    const uint8_t remainder_len,
+    const uint64_t message_len
+)
 {
-    va_list arg_list;
-    uint32_t sum = 0, addend, overflow_thresh;
+    // One block if the 0x80 marker and 128-bit length still fit, two otherwise
+    uint8_t block_count = (remainder_len < 112) ? 1 : 2;
+    uint16_t tail_len = (uint16_t)block_count << 7;
 
-    va_start(arg_list, count);
+    if (remainder_len)
+        memcpy(tail, remainder, remainder_len);
 
-    for (int i = 0; i < count; ++i)
-    {
-        addend = va_arg(arg_list, uint32_t);
-
-        if (!addend)
-            continue;
+    // Set 1 bit after the message, zero-fill up to the length field
+    tail[remainder_len] = 0x80;
+    memset(tail + remainder_len + 1, 0x00, tail_len - remainder_len - 17);
 
-        if (!sum)
-        {
-            sum = addend;
-            continue;
-        }
-
-        // Determine minimum addend that would cause overflow
-        overflow_thresh = UINT32_MAX - sum + 1;
-
-        // If sum will overflow, assign difference of addend & overflow_addend
-        // (Equivalent to addition modulo 2^32)
-        sum = (addend >= overflow_thresh) 
-            ? (addend - overflow_thresh) 
-            : (sum + addend);
-    }
+    // Set message length in bits as last 128 bits of tail
+    store_be64(tail + tail_len - 16, message_len >> 61);
+    store_be64(tail + tail_len - 8, message_len << 3);
 
-    va_end(arg_list);
-    return sum;
+    return block_count;
 }
 
-static uint64_t
-wrap_sum_64(int count, ...)
-{
-    va_list arg_list;
-    uint64_t sum = 0, addend, overflow_thresh;
-
-    va_start(arg_list, count);
-
-    for (int i = 0; i < count; ++i)
-    {
-        addend = va_arg(arg_list, uint64_t);
-
-        if (!addend)
-            continue;
-
-        if (!sum)
-        {
-            sum = addend;
-            continue;
-        }
-
-        // Determine minimum addend that would cause overflow
-        overflow_thresh = UINT64_MAX - sum + 1;
-
-        // If sum will overflow, assign difference of addend & overflow_addend
-        // (Equivalent to addition modulo 2^64)
-        sum = (addend >= overflow_thresh) 
-            ? (addend - overflow_thresh) 
-            : (sum + addend);
-    }
-
-    va_end(arg_list);
-    return sum;
-}
+//=======================//
+// Misc Shared Functions //
+//=======================//
 
-static uint32_t
-pack_32(const uint8_t * bytes)
+void
+unpack_32(
+    uint8_t * buf, 
+    const uint32_t * words, 
+    const uint8_t byte_count, 
+    const ShaDigestFormat format
+)
 {
-    uint32_t word = 0;
-    uint8_t l_shift;
+    uint8_t raw[32];
 
-    for (uint8_t i = 0; i < 4; ++i)
-    {
-        l_shift = (3 - i) << 3;
-        word |= (uint32_t)bytes[i] << l_shift;
-    }
+    // Big-endian bytes of every word the digest touches (SHA-224 ends mid-word)
+    for (uint8_t w = 0; w < (byte_count + 3) / 4; ++w)
+        store_be32(raw + w * 4, words[w]);
 
-    return word;
+    encode_digest(buf, raw, byte_count, format);
 }
 
-static uint64_t
-pack_64(const uint8_t * bytes)
+void
+unpack_64(
+    uint8_t * buf, 
+    const uint64_t * words, 
+    const uint8_t byte_count, 
+    const ShaDigestFormat format
+)
 {
-    uint64_t word = 0;
-    uint8_t l_shift;
+    uint8_t raw[64];
 
-    for (uint8_t i = 0; i < 8; ++i)
-    {
-        l_shift = (7 - i) << 3;
-        word |= (uint64_t)bytes[i] << l_shift;
-    }
+    // Big-endian bytes of every word the digest touches (SHA-512/224 ends mid-word)
+    for (uint8_t w = 0; w < (byte_count + 7) / 8; ++w)
+        store_be64(raw + w * 8, words[w]);
 
-    return word;
+    encode_digest(buf, raw, byte_count, format);
 }
@@ -0,0 +1,143 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/cpu.c                                 //
+// Description: Host CPU feature detection                //
+//                                                        //
+//********************************************************//
+
+#include "sharptwoth/internal.h"
+
+#ifdef SHARP2TH_X86
+#include <cpuid.h>
+#endif
+
+//=================//
+// Cached Features //
+//=================//
+
+// Written once by cpu_probe() from the load-time constructor, before any caller
+// thread can exist, so later reads need no synchronization
+static uint32_t host_features = 0;
+
+//==================//
+// Static Functions //
+//==================//
+
+static uint32_t
+probe_cpu_features(void);
+
+#ifdef SHARP2TH_X86
+static uint64_t
+read_xcr0(void);
+#endif
+
+//===================//
+// Feature Detection //
+//===================//
+
+void
+cpu_probe(void)
+{
+    host_features = probe_cpu_features();
+}
+
+uint32_t
+cpu_features(void)
+{
+    return host_features;
+}
+
+void
+cpu_model(char * name, const size_t name_len)
+{
+    char brand[49] = "generic";
+
+#ifdef SHARP2TH_X86
+    unsigned int regs[12];
+
+    // Leaves 0x80000002..4 hold the 48-byte brand string, NUL-padded
+    if (__get_cpuid_max(0x80000000, NULL) >= 0x80000004)
+    {
+        for (unsigned int i = 0; i < 3; ++i)
+            __get_cpuid(0x80000002 + i, &regs[i * 4], &regs[i * 4 + 1], &regs[i * 4 + 2], &regs[i * 4 + 3]);
+
+        memcpy(brand, regs, 48);
+        brand[48] = '\0';
+    }
+#endif
+
+    // Leading padding spaces are trimmed so the name reads cleanly in cache files
+    const char * start = brand;
+
+    while (*start == ' ')
+        ++start;
+
+    if (name_len)
+    {
+        strncpy(name, start, name_len - 1);
+        name[name_len - 1] = '\0';
+    }
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static uint32_t
+probe_cpu_features(void)
+{
+    uint32_t features = 0;
+
+#ifdef SHARP2TH_X86
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return 0;
+
+    if (ecx & bit_SSSE3)
+        features |= CPU_FEATURE_SSSE3;
+
+    if (ecx & bit_SSE4_1)
+        features |= CPU_FEATURE_SSE41;
+
+    // YMM registers are only usable if the OS saves them on context switch
+    int ymm_enabled = (ecx & bit_OSXSAVE) && ((read_xcr0() & 0x06) == 0x06);
+
+    if (ymm_enabled && (ecx & bit_AVX))
+        features |= CPU_FEATURE_AVX;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return features;
+
+    // SHA extensions operate on XMM registers only, so no XGETBV check is needed
+    if (ebx & bit_SHA)
+        features |= CPU_FEATURE_SHA;
+
+    if ((features & CPU_FEATURE_AVX) && (ebx & bit_AVX2))
+        features |= CPU_FEATURE_AVX2;
+
+    // ZMM kernels need F + BW and OS support for opmask and all 32 ZMM registers
+    uint32_t avx512 = bit_AVX512F | bit_AVX512BW;
+    int zmm_enabled = (features & CPU_FEATURE_AVX) && ((read_xcr0() & 0xe6) == 0xe6);
+
+    if (zmm_enabled && ((ebx & avx512) == avx512))
+        features |= CPU_FEATURE_AVX512;
+#endif
+
+    return features;
+}
+
+#ifdef SHARP2TH_X86
+static uint64_t
+read_xcr0(void)
+{
+    // Encoded as inline assembly so this file needs no -mxsave
+    uint32_t eax, edx;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+}
+#endif
@@ -0,0 +1,207 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/descriptor.c                          //
+// Description: Per-algorithm parameter table             //
+//                                                        //
+//********************************************************//
+
+#include "sharptwoth/internal.h"
+
+//=====================//
+// Initial Hash Values //
+//=====================//
+
+static const uint32_t SHA1_INITIAL_HASH[5] =
+{
+    UINT32_C(0x67452301),
+    UINT32_C(0xefcdab89),
+    UINT32_C(0x98badcfe),
+    UINT32_C(0x10325476),
+    UINT32_C(0xc3d2e1f0)
+};
+
+static const uint32_t SHA224_INITIAL_HASH[8] =
+{
+    UINT32_C(0xc1059ed8),
+    UINT32_C(0x367cd507),
+    UINT32_C(0x3070dd17),
+    UINT32_C(0xf70e5939),
+    UINT32_C(0xffc00b31),
+    UINT32_C(0x68581511),
+    UINT32_C(0x64f98fa7),
+    UINT32_C(0xbefa4fa4)
+};
+
+static const uint32_t SHA256_INITIAL_HASH[8] =
+{
+    UINT32_C(0x6a09e667),
+    UINT32_C(0xbb67ae85),
+    UINT32_C(0x3c6ef372),
+    UINT32_C(0xa54ff53a),
+    UINT32_C(0x510e527f),
+    UINT32_C(0x9b05688c),
+    UINT32_C(0x1f83d9ab),
+    UINT32_C(0x5be0cd19)
+};
+
+static const uint64_t SHA384_INITIAL_HASH[8] =
+{
+    UINT64_C(0xcbbb9d5dc1059ed8),
+    UINT64_C(0x629a292a367cd507),
+    UINT64_C(0x9159015a3070dd17),
+    UINT64_C(0x152fecd8f70e5939),
+    UINT64_C(0x67332667ffc00b31),
+    UINT64_C(0x8eb44a8768581511),
+    UINT64_C(0xdb0c2e0d64f98fa7),
+    UINT64_C(0x47b5481dbefa4fa4)
+};
+
+static const uint64_t SHA512_INITIAL_HASH[8] =
+{
+    UINT64_C(0x6a09e667f3bcc908),
+    UINT64_C(0xbb67ae8584caa73b),
+    UINT64_C(0x3c6ef372fe94f82b),
+    UINT64_C(0xa54ff53a5f1d36f1),
+    UINT64_C(0x510e527fade682d1),
+    UINT64_C(0x9b05688c2b3e6c1f),
+    UINT64_C(0x1f83d9abfb41bd6b),
+    UINT64_C(0x5be0cd19137e2179)
+};
+
+static const uint64_t SHA512_224_INITIAL_HASH[8] =
+{
+    UINT64_C(0x8c3d37c819544da2),
+    UINT64_C(0x73e1996689dcd4d6),
+    UINT64_C(0x1dfab7ae32ff9c82),
+    UINT64_C(0x679dd514582f9fcf),
+    UINT64_C(0x0f6d2b697bd44da8),
+    UINT64_C(0x77e36f7304c48942),
+    UINT64_C(0x3f9d85a86a1d36c8),
+    UINT64_C(0x1112e6ad91d692a1)
+};
+
+static const uint64_t SHA512_256_INITIAL_HASH[8] =
+{
+    UINT64_C(0x22312194fc2bf72c),
+    UINT64_C(0x9f555fa3c84c64c2),
+    UINT64_C(0x2393b86b6f53b151),
+    UINT64_C(0x963877195940eabd),
+    UINT64_C(0x96283ee2a88effe3),
+    UINT64_C(0xbe5e1e2553863992),
+    UINT64_C(0x2b0199fc2c85b8aa),
+    UINT64_C(0x0eb72ddc81c52ca2)
+};
+
+//=======================//
+// Algorithm Descriptors //
+//=======================//
+
+// Indexed by ShaType
+const sha_descriptor SHA_DESCRIPTORS[7] =
+{
+    // SHA-1
+    {
+        .block_len = 64,
+        .word_size = 4,
+        .word_count = 5,
+        .digest_len = SHA1_DIGEST_LEN,
+        .max_message_len = SHA1_MAX_MSG_LEN,
+        .initial_hash = SHA1_INITIAL_HASH,
+        .compressor_32 = compressor_160,
+        .mb_compressor_32 = mb_compressor_160
+    },
+    // SHA-224
+    {
+        .block_len = 64,
+        .word_size = 4,
+        .word_count = 8,
+        .digest_len = SHA224_DIGEST_LEN,
+        .max_message_len = SHA224_MAX_MSG_LEN,
+        .initial_hash = SHA224_INITIAL_HASH,
+        .compressor_32 = compressor_256,
+        .mb_compressor_32 = mb_compressor_256,
+        .pad_schedule = SHA256_PAD_SCHEDULE,
+        .sched_compressor_32 = sched_compressor_256,
+        .half_compressor_32 = half_compressor_256,
+        .mb_sched_compressor_32 = mb_sched_compressor_256
+    },
+    // SHA-256
+    {
+        .block_len = 64,
+        .word_size = 4,
+        .word_count = 8,
+        .digest_len = SHA256_DIGEST_LEN,
+        .max_message_len = SHA256_MAX_MSG_LEN,
+        .initial_hash = SHA256_INITIAL_HASH,
+        .compressor_32 = compressor_256,
+        .mb_compressor_32 = mb_compressor_256,
+        .pad_schedule = SHA256_PAD_SCHEDULE,
+        .sched_compressor_32 = sched_compressor_256,
+        .half_compressor_32 = half_compressor_256,
+        .mb_sched_compressor_32 = mb_sched_compressor_256
+    },
+    // SHA-384
+    {
+        .block_len = 128,
+        .word_size = 8,
+        .word_count = 8,
+        .digest_len = SHA384_DIGEST_LEN,
+        .max_message_len = UINT64_MAX,
+        .initial_hash = SHA384_INITIAL_HASH,
+        .compressor_64 = compressor_512,
+        .mb_compressor_64 = mb_compressor_512,
+        .pad_schedule = SHA512_PAD_SCHEDULE,
+        .sched_compressor_64 = sched_compressor_512,
+        .half_compressor_64 = half_compressor_512,
+        .mb_sched_compressor_64 = mb_sched_compressor_512
+    },
+    // SHA-512
+    {
+        .block_len = 128,
+        .word_size = 8,
+        .word_count = 8,
+        .digest_len = SHA512_DIGEST_LEN,
+        .max_message_len = UINT64_MAX,
+        .initial_hash = SHA512_INITIAL_HASH,
+        .compressor_64 = compressor_512,
+        .mb_compressor_64 = mb_compressor_512,
+        .pad_schedule = SHA512_PAD_SCHEDULE,
+        .sched_compressor_64 = sched_compressor_512,
+        .half_compressor_64 = half_compressor_512,
+        .mb_sched_compressor_64 = mb_sched_compressor_512
+    },
+    // SHA-512/224
+    {
+        .block_len = 128,
+        .word_size = 8,
+        .word_count = 8,
+        .digest_len = SHA512_224_DIGEST_LEN,
+        .max_message_len = UINT64_MAX,
+        .initial_hash = SHA512_224_INITIAL_HASH,
+        .compressor_64 = compressor_512,
+        .mb_compressor_64 = mb_compressor_512,
+        .pad_schedule = SHA512_PAD_SCHEDULE,
+        .sched_compressor_64 = sched_compressor_512,
+        .half_compressor_64 = half_compressor_512,
+        .mb_sched_compressor_64 = mb_sched_compressor_512
+    },
+    // SHA-512/256
+    {
+        .block_len = 128,
+        .word_size = 8,
+        .word_count = 8,
+        .digest_len = SHA512_256_DIGEST_LEN,
+        .max_message_len = UINT64_MAX,
+        .initial_hash = SHA512_256_INITIAL_HASH,
+        .compressor_64 = compressor_512,
+        .mb_compressor_64 = mb_compressor_512,
+        .pad_schedule = SHA512_PAD_SCHEDULE,
+        .sched_compressor_64 = sched_compressor_512,
+        .half_compressor_64 = half_compressor_512,
+        .mb_sched_compressor_64 = mb_sched_compressor_512
+    }
+};
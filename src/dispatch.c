@@ -0,0 +1,399 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/dispatch.c                            //
+// Description: Compression-kernel selection              //
+//                                                        //
+//********************************************************//
+
+#include <stdlib.h>
+#include "sharptwoth/internal.h"
+
+//==================//
+// Selected Kernels //
+//==================//
+
+// kernel_set
+// One kernel per algorithm family, single-stream and multi-buffer, plus the
+// fixed-length kernels that go with them
+// (multi-buffer kernels are NULL where the backend has none)
+
+typedef struct kernel_set
+{
+    compressor_32_t compress_160;
+    compressor_32_t compress_256;
+    compressor_64_t compress_512;
+    mb_compressor_32_t compress_160x8;
+    mb_compressor_32_t compress_256x8;
+    mb_compressor_64_t compress_512x8;
+    word_compressor_32_t sched_256;
+    word_compressor_32_t half_256;
+    word_compressor_64_t sched_512;
+    word_compressor_64_t half_512;
+    word_compressor_32_t sched_256x8;
+    word_compressor_32_t half_256x8;
+    word_compressor_64_t sched_512x8;
+
+} kernel_set;
+
+#define PORTABLE_KERNELS \
+    { compress_160_scalar, compress_256_scalar, compress_512_scalar, NULL, NULL, NULL, \
+      compress_sched_256_scalar, compress_half_256_scalar, \
+      compress_sched_512_scalar, compress_half_512_scalar, NULL, NULL, NULL }
+
+// Kernels per message-size bucket (identical across buckets unless tuned);
+// portable until select_compressors() has run
+static kernel_set bound[TUNE_BUCKETS] =
+{
+    PORTABLE_KERNELS, PORTABLE_KERNELS, PORTABLE_KERNELS
+};
+
+// Backend the kernels above were bound for
+static ShaBackend active_backend = BACKEND_AUTO;
+
+// Environment variables naming a backend to force, and an autotuner cache
+// file to load or create, at load time
+// (backend values: auto, scalar, ssse3, avx2, avx512, shani)
+#define BACKEND_ENV_VAR "SHARPTWOTH_BACKEND"
+#define AUTOTUNE_ENV_VAR "SHARPTWOTH_AUTOTUNE"
+
+//==================//
+// Static Functions //
+//==================//
+
+static void
+backend_kernels(const ShaBackend backend, kernel_set * kernels);
+
+static void
+bind_backend(const ShaBackend backend);
+
+static ShaBackend
+parse_backend(const char * name);
+
+// select_compressors()
+// Probes the host CPU, then binds each compression function to the fastest kernel the host supports,
+// or to the backend named by SHARPTWOTH_BACKEND if the host supports it,
+// then applies the SHARPTWOTH_AUTOTUNE decision table if one was asked for
+// (runs once when the library is loaded)
+__attribute__((constructor))
+static void
+select_compressors(void)
+{
+    cpu_probe();
+
+    ShaBackend backend = parse_backend(getenv(BACKEND_ENV_VAR));
+    const char * tune_cache = getenv(AUTOTUNE_ENV_VAR);
+
+    if (!backend_supported(backend))
+        backend = BACKEND_AUTO;
+
+    bind_backend(backend);
+
+    // A forced backend wins over tuning; an empty value tunes without a cache
+    if (tune_cache && backend == BACKEND_AUTO)
+        sha_autotune(*tune_cache ? tune_cache : NULL);
+}
+
+//===================//
+// Backend Selection //
+//===================//
+
+ShaComputationResult
+sha_set_backend(const ShaBackend backend)
+{
+    if (!backend_supported(backend))
+        return UNSUPPORTED_BACKEND;
+
+    bind_backend(backend);
+
+    return HASH_COMPUTED;
+}
+
+ShaBackend
+sha_get_backend(void)
+{
+    return active_backend;
+}
+
+int
+backend_supported(const ShaBackend backend)
+{
+    switch (backend)
+    {
+        case BACKEND_AUTO:
+        case BACKEND_SCALAR:
+            return 1;
+#ifdef SHARP2TH_X86
+        case BACKEND_SSSE3:
+            return (cpu_features() & CPU_FEATURE_SSSE3) != 0;
+        case BACKEND_AVX2:
+            return (cpu_features() & CPU_FEATURE_AVX2) != 0;
+        case BACKEND_AVX512:
+            return (cpu_features() & CPU_FEATURE_AVX512) != 0;
+        case BACKEND_SHA_NI:
+        {
+            uint32_t shani = CPU_FEATURE_SHA | CPU_FEATURE_SSSE3 | CPU_FEATURE_SSE41;
+            return (cpu_features() & shani) == shani;
+        }
+#endif
+        default:
+            return 0;
+    }
+}
+
+void
+apply_tuning(const tune_table * table)
+{
+    kernel_set single, lanes;
+
+    bind_backend(BACKEND_AUTO);
+
+    for (uint8_t b = 0; b < TUNE_BUCKETS; ++b)
+    {
+        // Single-stream kernels come from one backend, multi-buffer kernels
+        // from another (a batch winner without lanes leaves the kernel NULL,
+        // so batches of that size loop over the single-stream path)
+        backend_kernels((ShaBackend)table->single[TUNE_160][b], &single);
+        backend_kernels((ShaBackend)table->batch[TUNE_160][b], &lanes);
+        bound[b].compress_160 = single.compress_160;
+        bound[b].compress_160x8 = lanes.compress_160x8;
+
+        backend_kernels((ShaBackend)table->single[TUNE_256][b], &single);
+        backend_kernels((ShaBackend)table->batch[TUNE_256][b], &lanes);
+        bound[b].compress_256 = single.compress_256;
+        bound[b].sched_256 = single.sched_256;
+        bound[b].half_256 = single.half_256;
+        bound[b].compress_256x8 = lanes.compress_256x8;
+        bound[b].sched_256x8 = lanes.sched_256x8;
+        bound[b].half_256x8 = lanes.half_256x8;
+
+        backend_kernels((ShaBackend)table->single[TUNE_512][b], &single);
+        backend_kernels((ShaBackend)table->batch[TUNE_512][b], &lanes);
+        bound[b].compress_512 = single.compress_512;
+        bound[b].sched_512 = single.sched_512;
+        bound[b].half_512 = single.half_512;
+        bound[b].compress_512x8 = lanes.compress_512x8;
+        bound[b].sched_512x8 = lanes.sched_512x8;
+    }
+}
+
+//=======================//
+// Compression Functions //
+//=======================//
+
+compressor_32_t
+compressor_160(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].compress_160;
+}
+
+compressor_32_t
+compressor_256(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].compress_256;
+}
+
+compressor_64_t
+compressor_512(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].compress_512;
+}
+
+//==========================//
+// Multi-Buffer Compressors //
+//==========================//
+
+mb_compressor_32_t
+mb_compressor_160(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].compress_160x8;
+}
+
+mb_compressor_32_t
+mb_compressor_256(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].compress_256x8;
+}
+
+mb_compressor_64_t
+mb_compressor_512(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].compress_512x8;
+}
+
+//======================//
+// Fixed-Length Kernels //
+//======================//
+
+word_compressor_32_t
+sched_compressor_256(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].sched_256;
+}
+
+word_compressor_64_t
+sched_compressor_512(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].sched_512;
+}
+
+word_compressor_32_t
+half_compressor_256(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].half_256;
+}
+
+word_compressor_64_t
+half_compressor_512(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].half_512;
+}
+
+word_compressor_32_t
+mb_sched_compressor_256(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].sched_256x8;
+}
+
+word_compressor_64_t
+mb_sched_compressor_512(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].sched_512x8;
+}
+
+word_compressor_32_t
+mb_half_compressor_256(const uint64_t message_len)
+{
+    return bound[tune_bucket(message_len)].half_256x8;
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static void
+backend_kernels(const ShaBackend backend, kernel_set * kernels)
+{
+    // Anything the backend has no kernel for stays portable
+    *kernels = (kernel_set)PORTABLE_KERNELS;
+
+#ifdef SHARP2TH_X86
+    uint32_t features = cpu_features();
+
+    switch (backend)
+    {
+        case BACKEND_SSSE3:
+            kernels->compress_160 = compress_160_ssse3;
+            kernels->compress_256 = compress_256_ssse3;
+            break;
+
+        case BACKEND_AVX2:
+            kernels->compress_512 = compress_512_avx2;
+            kernels->compress_160x8 = compress_160x8_avx2;
+            kernels->compress_256x8 = compress_256x8_avx2;
+            kernels->sched_256x8 = compress_sched_256x8_avx2;
+            kernels->half_256x8 = compress_half_256x8_avx2;
+            break;
+
+        case BACKEND_AVX512:
+            kernels->compress_512x8 = compress_512x8_avx512;
+            kernels->sched_512x8 = compress_sched_512x8_avx512;
+            break;
+
+        case BACKEND_SHA_NI:
+            kernels->compress_160 = compress_160_shani;
+            kernels->compress_256 = compress_256_shani;
+            kernels->sched_256 = compress_sched_256_shani;
+            kernels->half_256 = compress_half_256_shani;
+            break;
+
+        case BACKEND_AUTO:
+            if (backend_supported(BACKEND_SHA_NI))
+            {
+                kernels->compress_160 = compress_160_shani;
+                kernels->compress_256 = compress_256_shani;
+                kernels->sched_256 = compress_sched_256_shani;
+                kernels->half_256 = compress_half_256_shani;
+            }
+            else if (features & CPU_FEATURE_SSSE3)
+            {
+                kernels->compress_160 = compress_160_ssse3;
+                kernels->compress_256 = compress_256_ssse3;
+            }
+
+            // Eight AVX2 lanes outrun one SHA-NI stream for SHA-1, but not for
+            // SHA-256, so SHA-256 batches only go multi-buffer without SHA extensions
+            if (features & CPU_FEATURE_AVX2)
+            {
+                kernels->compress_512 = compress_512_avx2;
+                kernels->compress_160x8 = compress_160x8_avx2;
+
+                if (!(features & CPU_FEATURE_SHA))
+                {
+                    kernels->compress_256x8 = compress_256x8_avx2;
+                    kernels->sched_256x8 = compress_sched_256x8_avx2;
+                    kernels->half_256x8 = compress_half_256x8_avx2;
+                }
+            }
+
+            if (features & CPU_FEATURE_AVX512)
+            {
+                kernels->compress_512x8 = compress_512x8_avx512;
+                kernels->sched_512x8 = compress_sched_512x8_avx512;
+            }
+            break;
+
+        default:
+            break;
+    }
+#else
+    (void)backend;
+#endif
+}
+
+static void
+bind_backend(const ShaBackend backend)
+{
+    kernel_set kernels;
+
+    backend_kernels(backend, &kernels);
+
+    for (uint8_t b = 0; b < TUNE_BUCKETS; ++b)
+        bound[b] = kernels;
+
+    active_backend = backend;
+}
+
+static ShaBackend
+parse_backend(const char * name)
+{
+    static const struct
+    {
+        const char * name;
+        ShaBackend backend;
+
+    } names[] =
+    {
+        { "auto",   BACKEND_AUTO   },
+        { "scalar", BACKEND_SCALAR },
+        { "ssse3",  BACKEND_SSSE3  },
+        { "avx2",   BACKEND_AVX2   },
+        { "avx512", BACKEND_AVX512 },
+        { "shani",  BACKEND_SHA_NI }
+    };
+
+    if (!name)
+        return BACKEND_AUTO;
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+    {
+        if (!strcmp(name, names[i].name))
+            return names[i].backend;
+    }
+
+    // Unrecognized names leave the automatic choice in place
+    return BACKEND_AUTO;
+}
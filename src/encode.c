@@ -0,0 +1,358 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/encode.c                              //
+// Description: Digest encoding and decoding              //
+//                                                        //
+//********************************************************//
+
+#include "sharptwoth/internal.h"
+
+// Digit and alphabet tables (the SIMD codecs load them as shuffle tables
+// and take the two alphabet-specific base64 characters from them)
+static const char HEX_LOWER[16] = "0123456789abcdef";
+static const char HEX_UPPER[16] = "0123456789ABCDEF";
+static const char BASE64_ALPHABET[64] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char BASE64URL_ALPHABET[64] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Marks a character outside an alphabet in the decoding tables
+#define NOT_A_DIGIT 0xff
+
+//==================//
+// Static Functions //
+//==================//
+
+static void
+encode_hex(uint8_t * encoded, const uint8_t * raw, const size_t raw_len, const char * digits);
+
+static void
+encode_base64(uint8_t * encoded, const uint8_t * raw, const size_t raw_len, const char * alphabet, const int padded);
+
+static int
+decode_hex(uint8_t * raw, const uint8_t * encoded, const size_t raw_len);
+
+static int
+decode_base64(uint8_t * raw, const uint8_t * encoded, const size_t raw_len, const char * alphabet, const int padded);
+
+// sextet()
+// Value of a base64 character, or NOT_A_DIGIT (the letters and digits are
+// shared by both alphabets; only characters 62 and 63 differ)
+static inline uint8_t
+sextet(const uint8_t c, const char * alphabet)
+{
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A';
+    if (c >= 'a' && c <= 'z')
+        return c - 'a' + 26;
+    if (c >= '0' && c <= '9')
+        return c - '0' + 52;
+    if (c == (uint8_t)alphabet[62])
+        return 62;
+    if (c == (uint8_t)alphabet[63])
+        return 63;
+
+    return NOT_A_DIGIT;
+}
+
+// nibble()
+// Value of a hex digit in either case, or NOT_A_DIGIT
+static inline uint8_t
+nibble(const uint8_t c)
+{
+    uint8_t lower = c | 0x20;
+
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (lower >= 'a' && lower <= 'f')
+        return lower - 'a' + 10;
+
+    return NOT_A_DIGIT;
+}
+
+//=================//
+// Digest Encoding //
+//=================//
+
+void
+encode_digest(
+    uint8_t * encoded,
+    const uint8_t * raw,
+    const size_t raw_len,
+    const ShaDigestFormat format
+)
+{
+    switch (format)
+    {
+        case HEX_STRING_LOWER:
+            encode_hex(encoded, raw, raw_len, HEX_LOWER);
+            break;
+        case HEX_STRING_UPPER:
+            encode_hex(encoded, raw, raw_len, HEX_UPPER);
+            break;
+        case BASE64:
+            encode_base64(encoded, raw, raw_len, BASE64_ALPHABET, 1);
+            break;
+        case BASE64URL:
+            encode_base64(encoded, raw, raw_len, BASE64URL_ALPHABET, 0);
+            break;
+        default:
+            memcpy(encoded, raw, raw_len);
+            return;
+    }
+
+    encoded[encoded_len(raw_len, format)] = '\0';
+}
+
+int
+decode_digest(
+    uint8_t * raw,
+    const uint8_t * encoded,
+    const size_t raw_len,
+    const ShaDigestFormat format
+)
+{
+    switch (format)
+    {
+        case HEX_STRING_LOWER:
+        case HEX_STRING_UPPER:
+            return decode_hex(raw, encoded, raw_len);
+        case BASE64:
+            return decode_base64(raw, encoded, raw_len, BASE64_ALPHABET, 1);
+        case BASE64URL:
+            return decode_base64(raw, encoded, raw_len, BASE64URL_ALPHABET, 0);
+        default:
+            memcpy(raw, encoded, raw_len);
+            return 1;
+    }
+}
+
+//====================//
+// Encoding Interface //
+//====================//
+
+size_t
+sha_encoded_size(const size_t raw_len, const ShaDigestFormat format)
+{
+    if (!valid_format(format))
+        return 0;
+
+    return encoded_len(raw_len, format) + (format != OCTET_ARRAY);
+}
+
+ShaComputationResult
+sha_encode(
+    uint8_t * encoded,
+    const uint8_t * raw,
+    const size_t raw_len,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!encoded)
+        return NULL_DIGEST_POINTER;
+
+    if (!raw && raw_len)
+        return NULL_MESSAGE_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    encode_digest(encoded, raw, raw_len, format);
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+sha_decode(
+    uint8_t * raw,
+    const uint8_t * encoded,
+    const size_t raw_len,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!raw && raw_len)
+        return NULL_DIGEST_POINTER;
+
+    if (!encoded && encoded_len(raw_len, format))
+        return NULL_MESSAGE_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    return decode_digest(raw, encoded, raw_len, format) ? HASH_COMPUTED : MALFORMED_ENCODING;
+}
+
+ShaComputationResult
+sha_encode_batch(
+    uint8_t * encoded,
+    const uint8_t * digests,
+    const size_t count,
+    const size_t digest_len,
+    const ShaDigestFormat format
+)
+{
+    size_t stride = sha_encoded_size(digest_len, format);
+
+    // Validate arguments
+    if (!encoded && count)
+        return NULL_DIGEST_POINTER;
+
+    if (!digests && count && digest_len)
+        return NULL_MESSAGE_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    for (size_t i = 0; i < count; ++i)
+        encode_digest(encoded + i * stride, digests + i * digest_len, digest_len, format);
+
+    return HASH_COMPUTED;
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static void
+encode_hex(uint8_t * encoded, const uint8_t * raw, const size_t raw_len, const char * digits)
+{
+    size_t i = 0;
+
+#ifdef SHARP2TH_X86
+    if (cpu_features() & CPU_FEATURE_SSSE3)
+        i = hex_encode_ssse3(encoded, raw, raw_len, digits);
+#endif
+
+    for (; i < raw_len; ++i)
+    {
+        encoded[2 * i] = (uint8_t)digits[raw[i] >> 4];
+        encoded[2 * i + 1] = (uint8_t)digits[raw[i] & 0x0f];
+    }
+}
+
+static void
+encode_base64(uint8_t * encoded, const uint8_t * raw, const size_t raw_len, const char * alphabet, const int padded)
+{
+    size_t i = 0;
+    uint32_t group;
+
+#ifdef SHARP2TH_X86
+    if (cpu_features() & CPU_FEATURE_SSSE3)
+        i = base64_encode_ssse3(encoded, raw, raw_len, alphabet);
+#endif
+
+    encoded += i / 3 * 4;
+
+    // Whole 3-byte groups
+    for (; i + 3 <= raw_len; i += 3)
+    {
+        group = (uint32_t)raw[i] << 16 | (uint32_t)raw[i + 1] << 8 | raw[i + 2];
+        *(encoded++) = (uint8_t)alphabet[group >> 18];
+        *(encoded++) = (uint8_t)alphabet[(group >> 12) & 0x3f];
+        *(encoded++) = (uint8_t)alphabet[(group >> 6) & 0x3f];
+        *(encoded++) = (uint8_t)alphabet[group & 0x3f];
+    }
+
+    if (i == raw_len)
+        return;
+
+    // One or two leftover bytes make two or three characters
+    group = (uint32_t)raw[i] << 16 | (i + 1 < raw_len ? (uint32_t)raw[i + 1] << 8 : 0);
+    *(encoded++) = (uint8_t)alphabet[group >> 18];
+    *(encoded++) = (uint8_t)alphabet[(group >> 12) & 0x3f];
+
+    if (i + 1 < raw_len)
+        *(encoded++) = (uint8_t)alphabet[(group >> 6) & 0x3f];
+    else if (padded)
+        *(encoded++) = '=';
+
+    if (padded)
+        *encoded = '=';
+}
+
+static int
+decode_hex(uint8_t * raw, const uint8_t * encoded, const size_t raw_len)
+{
+    size_t i = 0;
+    uint8_t high, low;
+
+#ifdef SHARP2TH_X86
+    if (cpu_features() & CPU_FEATURE_SSSE3)
+        i = hex_decode_ssse3(raw, encoded, raw_len);
+#endif
+
+    for (; i < raw_len; ++i)
+    {
+        high = nibble(encoded[2 * i]);
+        low = nibble(encoded[2 * i + 1]);
+
+        if (high == NOT_A_DIGIT || low == NOT_A_DIGIT)
+            return 0;
+
+        raw[i] = (uint8_t)(high << 4 | low);
+    }
+
+    return 1;
+}
+
+static int
+decode_base64(uint8_t * raw, const uint8_t * encoded, const size_t raw_len, const char * alphabet, const int padded)
+{
+    size_t i = 0;
+    uint8_t s[4];
+
+#ifdef SHARP2TH_X86
+    if (cpu_features() & CPU_FEATURE_SSSE3)
+        i = base64_decode_ssse3(raw, encoded, raw_len, alphabet);
+#endif
+
+    encoded += i / 3 * 4;
+
+    // Whole 4-character groups
+    for (; i + 3 <= raw_len; i += 3, encoded += 4)
+    {
+        for (uint8_t c = 0; c < 4; ++c)
+        {
+            if ((s[c] = sextet(encoded[c], alphabet)) == NOT_A_DIGIT)
+                return 0;
+        }
+
+        raw[i] = (uint8_t)(s[0] << 2 | s[1] >> 4);
+        raw[i + 1] = (uint8_t)(s[1] << 4 | s[2] >> 2);
+        raw[i + 2] = (uint8_t)(s[2] << 6 | s[3]);
+    }
+
+    if (i == raw_len)
+        return 1;
+
+    // A final group of two or three characters, its padding, and zero
+    // bits below the last byte (so each digest has exactly one encoding)
+    uint8_t chars = (uint8_t)(raw_len - i + 1);
+
+    for (uint8_t c = 0; c < chars; ++c)
+    {
+        if ((s[c] = sextet(encoded[c], alphabet)) == NOT_A_DIGIT)
+            return 0;
+    }
+
+    for (uint8_t c = chars; padded && c < 4; ++c)
+    {
+        if (encoded[c] != '=')
+            return 0;
+    }
+
+    raw[i] = (uint8_t)(s[0] << 2 | s[1] >> 4);
+
+    if (chars == 2)
+        return (s[1] & 0x0f) == 0;
+
+    raw[i + 1] = (uint8_t)(s[1] << 4 | s[2] >> 2);
+
+    return (s[2] & 0x03) == 0;
+}
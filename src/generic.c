@@ -0,0 +1,490 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/generic.c                             //
+// Description: Descriptor-driven hashing paths           //
+//                                                        //
+//********************************************************//
+
+#include <string.h>
+#include "sharptwoth/internal.h"
+
+//===============//
+// Generic Paths //
+//===============//
+
+ShaComputationResult
+hash_oneshot(
+    const sha_descriptor * algorithm,
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!digest)
+        return NULL_DIGEST_POINTER;
+
+    if (!message && message_len)
+        return NULL_MESSAGE_POINTER;
+
+    if (message_len > algorithm->max_message_len)
+        return UNSUPPORTED_DATA_SIZE;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    // Initialize hash, compute digest (short messages take a fixed-length
+    // path), format digest
+    if (algorithm->word_size == 4)
+    {
+        uint32_t hash_words[8];
+        memcpy(hash_words, algorithm->initial_hash, algorithm->word_count * sizeof(uint32_t));
+
+        if (!compute_short_32(algorithm, hash_words, message, message_len))
+            compute_32(algorithm->compressor_32(message_len), hash_words, message, message_len);
+
+        unpack_32(digest, hash_words, algorithm->digest_len, format);
+    }
+    else
+    {
+        uint64_t hash_words[8];
+        memcpy(hash_words, algorithm->initial_hash, algorithm->word_count * sizeof(uint64_t));
+
+        if (!compute_short_64(algorithm, hash_words, message, message_len))
+            compute_64(algorithm->compressor_64(message_len), hash_words, message, message_len);
+
+        unpack_64(digest, hash_words, algorithm->digest_len, format);
+    }
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+hash_iov(
+    const sha_descriptor * algorithm,
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+)
+{
+    uint64_t message_len = 0;
+
+    // Validate arguments
+    if (!digest)
+        return NULL_DIGEST_POINTER;
+
+    if (count < 0)
+        return UNSUPPORTED_DATA_SIZE;
+
+    if (!segments && count)
+        return NULL_MESSAGE_POINTER;
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (!segments[i].iov_base && segments[i].iov_len)
+            return NULL_MESSAGE_POINTER;
+
+        if (segments[i].iov_len > algorithm->max_message_len - message_len)
+            return UNSUPPORTED_DATA_SIZE;
+
+        message_len += segments[i].iov_len;
+    }
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    // Segments stream through one block buffer, so whole blocks inside a
+    // segment compress in place and only straddling blocks are copied
+    uint8_t buffer[128];
+    uint64_t total_len = 0;
+
+    if (algorithm->word_size == 4)
+    {
+        uint32_t hash_words[8];
+        compressor_32_t compress = algorithm->compressor_32(message_len);
+        memcpy(hash_words, algorithm->initial_hash, algorithm->word_count * sizeof(uint32_t));
+
+        for (int i = 0; i < count; ++i)
+            stream_update_32(hash_words, buffer, &total_len, compress, segments[i].iov_base, segments[i].iov_len);
+
+        stream_final_32(hash_words, buffer, total_len, compress);
+        unpack_32(digest, hash_words, algorithm->digest_len, format);
+    }
+    else
+    {
+        uint64_t hash_words[8];
+        compressor_64_t compress = algorithm->compressor_64(message_len);
+        memcpy(hash_words, algorithm->initial_hash, algorithm->word_count * sizeof(uint64_t));
+
+        for (int i = 0; i < count; ++i)
+            stream_update_64(hash_words, buffer, &total_len, compress, segments[i].iov_base, segments[i].iov_len);
+
+        stream_final_64(hash_words, buffer, total_len, compress);
+        unpack_64(digest, hash_words, algorithm->digest_len, format);
+    }
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+hash_copy(
+    const sha_descriptor * algorithm,
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!digest)
+        return NULL_DIGEST_POINTER;
+
+    if ((!message || !destination) && message_len)
+        return NULL_MESSAGE_POINTER;
+
+    if (message_len > algorithm->max_message_len)
+        return UNSUPPORTED_DATA_SIZE;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    // Copy and compress in step, then pad from the buffered tail
+    uint8_t buffer[128];
+    uint64_t total_len = 0;
+
+    if (algorithm->word_size == 4)
+    {
+        uint32_t hash_words[8];
+        compressor_32_t compress = algorithm->compressor_32(message_len);
+        memcpy(hash_words, algorithm->initial_hash, algorithm->word_count * sizeof(uint32_t));
+        stream_copy_32(hash_words, buffer, &total_len, compress, destination, message, message_len);
+        stream_final_32(hash_words, buffer, total_len, compress);
+        unpack_32(digest, hash_words, algorithm->digest_len, format);
+    }
+    else
+    {
+        uint64_t hash_words[8];
+        compressor_64_t compress = algorithm->compressor_64(message_len);
+        memcpy(hash_words, algorithm->initial_hash, algorithm->word_count * sizeof(uint64_t));
+        stream_copy_64(hash_words, buffer, &total_len, compress, destination, message, message_len);
+        stream_final_64(hash_words, buffer, total_len, compress);
+        unpack_64(digest, hash_words, algorithm->digest_len, format);
+    }
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+hash_update(
+    const sha_descriptor * algorithm,
+    void * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    // Validate arguments
+    if (!message && message_len)
+        return NULL_MESSAGE_POINTER;
+
+    if (message_len > algorithm->max_message_len - *total_len)
+        return UNSUPPORTED_DATA_SIZE;
+
+    // Absorb input (the total length is open-ended, so the large-message kernel)
+    if (algorithm->word_size == 4)
+    {
+        stream_update_32(
+            hash_words,
+            buffer,
+            total_len,
+            algorithm->compressor_32(UINT64_MAX),
+            message,
+            message_len
+        );
+    }
+    else
+    {
+        stream_update_64(
+            hash_words,
+            buffer,
+            total_len,
+            algorithm->compressor_64(UINT64_MAX),
+            message,
+            message_len
+        );
+    }
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+hash_update_copy(
+    const sha_descriptor * algorithm,
+    void * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    // Validate arguments
+    if ((!message || !destination) && message_len)
+        return NULL_MESSAGE_POINTER;
+
+    if (message_len > algorithm->max_message_len - *total_len)
+        return UNSUPPORTED_DATA_SIZE;
+
+    // Absorb input from the copy (open-ended total length, as in hash_update())
+    if (algorithm->word_size == 4)
+    {
+        stream_copy_32(
+            hash_words,
+            buffer,
+            total_len,
+            algorithm->compressor_32(UINT64_MAX),
+            destination,
+            message,
+            message_len
+        );
+    }
+    else
+    {
+        stream_copy_64(
+            hash_words,
+            buffer,
+            total_len,
+            algorithm->compressor_64(UINT64_MAX),
+            destination,
+            message,
+            message_len
+        );
+    }
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+hash_final(
+    const sha_descriptor * algorithm,
+    void * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    uint8_t * digest,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!digest)
+        return NULL_DIGEST_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    // Pad and compress the final block(s), then format digest
+    if (algorithm->word_size == 4)
+    {
+        stream_final_32(hash_words, buffer, total_len, algorithm->compressor_32(UINT64_MAX));
+        unpack_32(digest, hash_words, algorithm->digest_len, format);
+    }
+    else
+    {
+        stream_final_64(hash_words, buffer, total_len, algorithm->compressor_64(UINT64_MAX));
+        unpack_64(digest, hash_words, algorithm->digest_len, format);
+    }
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+hash_batch(
+    const sha_descriptor * algorithm,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!digests && count)
+        return NULL_DIGEST_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    ShaComputationResult result =
+        validate_batch(messages, message_lens, count, algorithm->max_message_len);
+
+    if (result != HASH_COMPUTED)
+        return result;
+
+    // Compute digests
+    if (algorithm->word_size == 4)
+        batch_32(algorithm, NULL, digests, messages, message_lens, count, format, NULL);
+    else
+        batch_64(algorithm, NULL, digests, messages, message_lens, count, format, NULL);
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+hash_batch_each(
+    const sha_descriptor * algorithm,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format,
+    ShaComputationResult * statuses
+)
+{
+    if (!statuses)
+        return hash_batch(algorithm, digests, messages, message_lens, count, format);
+
+    // Validate arguments (errors that apply to the whole batch come first)
+    if (!digests && count)
+        return NULL_DIGEST_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    if (!count)
+        return HASH_COMPUTED;
+
+    if (!messages || !message_lens)
+        return NULL_MESSAGE_POINTER;
+
+    ShaComputationResult first =
+        validate_each(messages, message_lens, count, algorithm->max_message_len, statuses);
+
+    // Compute digests for every message that passed
+    if (algorithm->word_size == 4)
+        batch_32(algorithm, NULL, digests, messages, message_lens, count, format, statuses);
+    else
+        batch_64(algorithm, NULL, digests, messages, message_lens, count, format, statuses);
+
+    return first;
+}
+
+ShaComputationResult
+hash_suffix(
+    const sha_descriptor * algorithm,
+    const sha_midstate * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!digest)
+        return NULL_DIGEST_POINTER;
+
+    if (!suffix && suffix_len)
+        return NULL_MESSAGE_POINTER;
+
+    if (suffix_len > algorithm->max_message_len - midstate->prefix_len)
+        return UNSUPPORTED_DATA_SIZE;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    // Continue from a copy of the midstate, which stays shared and untouched
+    if (algorithm->word_size == 4)
+    {
+        uint32_t hash_words[8];
+        memcpy(hash_words, midstate->hash_words, algorithm->word_count * sizeof(uint32_t));
+        stream_suffix_32(
+            hash_words,
+            midstate->buffer,
+            midstate->prefix_len,
+            algorithm->compressor_32(suffix_len),
+            suffix,
+            suffix_len
+        );
+        unpack_32(digest, hash_words, algorithm->digest_len, format);
+    }
+    else
+    {
+        uint64_t hash_words[8];
+        memcpy(hash_words, midstate->hash_words, algorithm->word_count * sizeof(uint64_t));
+        stream_suffix_64(
+            hash_words,
+            midstate->buffer,
+            midstate->prefix_len,
+            algorithm->compressor_64(suffix_len),
+            suffix,
+            suffix_len
+        );
+        unpack_64(digest, hash_words, algorithm->digest_len, format);
+    }
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+hash_suffix_batch(
+    const sha_descriptor * algorithm,
+    const sha_midstate * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!digests && count)
+        return NULL_DIGEST_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    ShaComputationResult result = validate_batch(
+        suffixes, suffix_lens, count, algorithm->max_message_len - midstate->prefix_len);
+
+    if (result != HASH_COMPUTED)
+        return result;
+
+    // Compute digests
+    if (algorithm->word_size == 4)
+        batch_32(algorithm, midstate, digests, suffixes, suffix_lens, count, format, NULL);
+    else
+        batch_64(algorithm, midstate, digests, suffixes, suffix_lens, count, format, NULL);
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+hash_peek(
+    const sha_descriptor * algorithm,
+    const void * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    uint8_t * digest,
+    const ShaDigestFormat format
+)
+{
+    // Finalize a copy of the chaining value; the buffer is only read
+    if (algorithm->word_size == 4)
+    {
+        uint32_t copy[8];
+        memcpy(copy, hash_words, algorithm->word_count * sizeof(uint32_t));
+        return hash_final(algorithm, copy, buffer, total_len, digest, format);
+    }
+    else
+    {
+        uint64_t copy[8];
+        memcpy(copy, hash_words, algorithm->word_count * sizeof(uint64_t));
+        return hash_final(algorithm, copy, buffer, total_len, digest, format);
+    }
+}
@@ -13,8 +13,10 @@
 #ifndef SHARP2TH_INTERNAL_H
 #define SHARP2TH_INTERNAL_H
 
-#include <stdarg.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
+#include <sys/uio.h>
 #include "sharptwoth/sharptwoth.h"
 
 //========================//
@@ -42,28 +44,947 @@
 #define LSIGMA0_512(x)  (ROTR((x), 1) ^ ROTR((x), 8) ^ ((x) >> 7))
 #define LSIGMA1_512(x)  (ROTR((x), 19) ^ ROTR((x), 61) ^ ((x) >> 6))
 
+//========================//
+// Big-Endian Word Access //
+//========================//
+
+// Byte swaps (compile to a single bswap/rev instruction where available)
+#if defined(__GNUC__) || defined(__clang__)
+#define BSWAP_32(x) __builtin_bswap32((x))
+#define BSWAP_64(x) __builtin_bswap64((x))
+#else
+#define BSWAP_32(x) \
+    ((ROTL((uint32_t)(x), 8) & UINT32_C(0x00ff00ff)) | (ROTR((uint32_t)(x), 8) & UINT32_C(0xff00ff00)))
+#define BSWAP_64(x) \
+    (((uint64_t)BSWAP_32((uint32_t)(x)) << 32) | BSWAP_32((uint32_t)((x) >> 32)))
+#endif
+
+// Unaligned big-endian loads/stores (memcpy keeps them free of alignment
+// and aliasing assumptions; compilers lower it to a plain mov)
+static inline uint32_t
+load_be32(const uint8_t * bytes)
+{
+    uint32_t word;
+    memcpy(&word, bytes, sizeof(word));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return word;
+#else
+    return BSWAP_32(word);
+#endif
+}
+
+static inline uint64_t
+load_be64(const uint8_t * bytes)
+{
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return word;
+#else
+    return BSWAP_64(word);
+#endif
+}
+
+static inline void
+store_be32(uint8_t * bytes, uint32_t word)
+{
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ != __ORDER_BIG_ENDIAN__)
+    word = BSWAP_32(word);
+#endif
+    memcpy(bytes, &word, sizeof(word));
+}
+
+static inline void
+store_be64(uint8_t * bytes, uint64_t word)
+{
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ != __ORDER_BIG_ENDIAN__)
+    word = BSWAP_64(word);
+#endif
+    memcpy(bytes, &word, sizeof(word));
+}
+
+//===========//
+// Constants //
+//===========//
+
+extern const uint32_t SHA1_CONSTANTS[4];
+extern const uint32_t SHA256_CONSTANTS[64];
+extern const uint64_t SHA512_CONSTANTS[80];
+extern const uint32_t SHA256_PAD_SCHEDULE[64];
+extern const uint64_t SHA512_PAD_SCHEDULE[80];
+extern const uint32_t SHA256_HALF_PAD_WORDS[64];
+extern const uint64_t SHA512_HALF_PAD_WORDS[80];
+
+// Whether schedule word s of a half-filled block (32 bytes of message in SHA-256,
+// 64 bytes in the 64-bit family) is a padding word
+// (constant for every message, so the half-block kernels never load it)
+#define HALF_PADDING(s) ((s) >= 8 && (s) < 16)
+
 //============================//
 // Hash-Computation Functions //
 //============================//
 
+// Function-pointer types matching the block-compression functions' signatures
+typedef void (* compressor_32_t)(uint32_t *, const uint8_t *, const uint64_t);
+typedef void (* compressor_64_t)(uint64_t *, const uint8_t *, const uint64_t);
+
+// Function-pointer types for kernels fed 32/64-bit words rather than message bytes:
+// schedule kernels take a block as its whole precomputed schedule (K[t] + W[t]),
+// half-block kernels take the words of a message exactly half a block long
+// (32 or 64 bytes) and supply its padding words as constants
+typedef void (* word_compressor_32_t)(uint32_t *, const uint32_t *);
+typedef void (* word_compressor_64_t)(uint64_t *, const uint64_t *);
+
+// compute_32()
+// Hashes a whole message with a 64-byte-block compression kernel
 void
-compute_160(
+compute_32(
+    const compressor_32_t compress,
     uint32_t * hash_words, 
     const uint8_t * message, 
     const uint64_t message_len
 );
 
+// compute_64()
+// Hashes a whole message with a 128-byte-block compression kernel
 void
-compute_256(
-    uint32_t * hash_words, 
+compute_64(
+    const compressor_64_t compress,
+    uint64_t * hash_words, 
     const uint8_t * message, 
     const uint64_t message_len
 );
 
+//=======================//
+// Compression Functions //
+//=======================//
+
+// compressor_160/256/512()
+// Best kernel on this host for messages of the given length (the autotuner
+// may pick different kernels per size bucket; streaming input, whose length
+// is unknown, asks for UINT64_MAX)
+compressor_32_t
+compressor_160(const uint64_t message_len);
+
+compressor_32_t
+compressor_256(const uint64_t message_len);
+
+compressor_64_t
+compressor_512(const uint64_t message_len);
+
+// Portable kernels (src/compute.c)
+void
+compress_160_scalar(
+    uint32_t * hash_words, 
+    const uint8_t * blocks, 
+    const uint64_t block_count
+);
+
 void
-compute_512(
+compress_256_scalar(
+    uint32_t * hash_words, 
+    const uint8_t * blocks, 
+    const uint64_t block_count
+);
+
+void
+compress_512_scalar(
     uint64_t * hash_words, 
-    const uint8_t * message, 
+    const uint8_t * blocks, 
+    const uint64_t block_count
+);
+
+#ifdef SHARP2TH_X86
+
+// Intel SHA extensions kernels (src/x86/sha_ni.c)
+void
+compress_160_shani(
+    uint32_t * hash_words, 
+    const uint8_t * blocks, 
+    const uint64_t block_count
+);
+
+void
+compress_256_shani(
+    uint32_t * hash_words, 
+    const uint8_t * blocks, 
+    const uint64_t block_count
+);
+
+// Scalar rounds over an SSSE3-computed message schedule (src/x86/sha_ssse3.c)
+void
+compress_160_ssse3(
+    uint32_t * hash_words, 
+    const uint8_t * blocks, 
+    const uint64_t block_count
+);
+
+void
+compress_256_ssse3(
+    uint32_t * hash_words, 
+    const uint8_t * blocks, 
+    const uint64_t block_count
+);
+
+// Scalar SHA-512 rounds over an AVX2-computed message schedule (src/x86/sha512_avx2.c)
+void
+compress_512_avx2(
+    uint64_t * hash_words, 
+    const uint8_t * blocks, 
+    const uint64_t block_count
+);
+
+#endif // SHARP2TH_X86
+
+//=====================//
+// Multi-Buffer Engine //
+//=====================//
+
+// Number of independent messages hashed side by side by a multi-buffer kernel
+#define MB_LANES 8
+
+// Function-pointer types matching the multi-buffer kernels' signatures
+// state:  chaining values transposed word-major (state[word * MB_LANES + lane])
+// blocks: one message block per lane (idle lanes may point anywhere readable)
+typedef void (* mb_compressor_32_t)(uint32_t *, const uint8_t * const *);
+typedef void (* mb_compressor_64_t)(uint64_t *, const uint8_t * const *);
+
+// mb_job
+// One message for the multi-buffer engine
+//
+// Members:
+//   message       Pointer to input data
+//   message_len   Number of bytes in input data
+//   hash_words    Chaining value to start from on entry, final chaining value on return
+//   absorbed_len  Number of bytes already compressed into hash_words (whole blocks; 0 when
+//                 starting from the initial hash value)
+//   prefix        Bytes that precede the message but were not compressed yet
+//   prefix_len    Number of bytes in prefix (less than one block)
+//   unpadded      Nonzero to compress complete blocks only and leave the rest of the
+//                 input unpadded, as an update does (prefix and message must fill a block)
+
+typedef struct mb_job
+{
+    const uint8_t * message;
+    uint64_t message_len;
+    void * hash_words;
+    uint64_t absorbed_len;
+    const uint8_t * prefix;
+    uint8_t prefix_len;
+    uint8_t unpadded;
+
+} mb_job;
+
+// mb_compute_32()
+// Pads and hashes every job through a 64-byte-block multi-buffer kernel,
+// refilling each lane with the next pending job as soon as its message ends
+// (when every busy lane is on the padding block of a one-block message, the
+// schedule kernel runs it from pad_schedule instead; both may be NULL)
+void
+mb_compute_32(
+    const mb_compressor_32_t compress,
+    const uint8_t word_count,
+    mb_job * jobs,
+    const size_t job_count,
+    const word_compressor_32_t sched_compress,
+    const uint32_t * pad_schedule
+);
+
+// mb_compute_64()
+// Pads and hashes every job through a 128-byte-block multi-buffer kernel
+// (each job carries its own initial hash, so SHA-384/512/512-t jobs can mix)
+void
+mb_compute_64(
+    const mb_compressor_64_t compress,
+    const uint8_t word_count,
+    mb_job * jobs,
+    const size_t job_count,
+    const word_compressor_64_t sched_compress,
+    const uint64_t * pad_schedule
+);
+
+// mb_compressor_160()
+// Multi-buffer SHA-1 kernel for batches of messages around the given length
+// (NULL if there is none, or if looping over single streams is faster)
+mb_compressor_32_t
+mb_compressor_160(const uint64_t message_len);
+
+// mb_compressor_256()
+// Multi-buffer SHA-224/SHA-256 kernel for batches of messages around the given length
+// (NULL if there is none, or if looping over single streams is faster)
+mb_compressor_32_t
+mb_compressor_256(const uint64_t message_len);
+
+// mb_compressor_512()
+// Multi-buffer SHA-384/SHA-512/SHA-512/t kernel for batches of messages around the given length
+// (NULL if there is none, or if looping over single streams is faster)
+mb_compressor_64_t
+mb_compressor_512(const uint64_t message_len);
+
+#ifdef SHARP2TH_X86
+
+// AVX2 8-lane kernels (src/x86/sha1_avx2.c, src/x86/sha256_avx2.c)
+void
+compress_160x8_avx2(
+    uint32_t * state,
+    const uint8_t * const * blocks
+);
+
+void
+compress_256x8_avx2(
+    uint32_t * state,
+    const uint8_t * const * blocks
+);
+
+// AVX-512 8-lane kernels (src/x86/sha512_avx512.c)
+void
+compress_512x8_avx512(
+    uint64_t * state,
+    const uint8_t * const * blocks
+);
+
+#endif // SHARP2TH_X86
+
+//======================//
+// Fixed-Length Kernels //
+//======================//
+
+// sched_compressor_256/512()
+// Best schedule kernel on this host for messages of the given length
+word_compressor_32_t
+sched_compressor_256(const uint64_t message_len);
+
+word_compressor_64_t
+sched_compressor_512(const uint64_t message_len);
+
+// half_compressor_256/512()
+// Best half-block kernel on this host for messages of the given length
+word_compressor_32_t
+half_compressor_256(const uint64_t message_len);
+
+word_compressor_64_t
+half_compressor_512(const uint64_t message_len);
+
+// mb_sched_compressor_256/512()
+// Multi-buffer schedule kernel paired with mb_compressor_256/512() (one schedule
+// broadcast to every lane of a transposed state; NULL if there is none)
+word_compressor_32_t
+mb_sched_compressor_256(const uint64_t message_len);
+
+word_compressor_64_t
+mb_sched_compressor_512(const uint64_t message_len);
+
+// mb_half_compressor_256()
+// Multi-buffer half-block kernel paired with mb_compressor_256() (eight messages'
+// words transposed like the state; NULL if there is none)
+word_compressor_32_t
+mb_half_compressor_256(const uint64_t message_len);
+
+// Portable kernels (src/compute.c)
+void
+compress_sched_256_scalar(
+    uint32_t * hash_words,
+    const uint32_t * schedule
+);
+
+void
+compress_sched_512_scalar(
+    uint64_t * hash_words,
+    const uint64_t * schedule
+);
+
+void
+compress_half_256_scalar(
+    uint32_t * hash_words,
+    const uint32_t * words
+);
+
+void
+compress_half_512_scalar(
+    uint64_t * hash_words,
+    const uint64_t * words
+);
+
+#ifdef SHARP2TH_X86
+
+// Intel SHA extensions kernels (src/x86/sha_ni.c)
+void
+compress_sched_256_shani(
+    uint32_t * hash_words,
+    const uint32_t * schedule
+);
+
+void
+compress_half_256_shani(
+    uint32_t * hash_words,
+    const uint32_t * words
+);
+
+// Multi-buffer kernels (src/x86/sha256_avx2.c, src/x86/sha512_avx512.c)
+void
+compress_sched_256x8_avx2(
+    uint32_t * state,
+    const uint32_t * schedule
+);
+
+void
+compress_half_256x8_avx2(
+    uint32_t * state,
+    const uint32_t * words
+);
+
+void
+compress_sched_512x8_avx512(
+    uint64_t * state,
+    const uint64_t * schedule
+);
+
+#endif // SHARP2TH_X86
+
+//=======================//
+// Algorithm Descriptors //
+//=======================//
+
+// sha_descriptor
+// Everything the generic paths need to know about one algorithm
+//
+// Members:
+//   block_len         Number of bytes per message block
+//   word_size         Number of bytes per chaining-value word
+//   word_count        Number of words in the chaining value
+//   digest_len        Number of digest bytes (truncated from the chaining value)
+//   max_message_len   Largest message length in bytes
+//   initial_hash      Initial hash value (word_count words of word_size bytes)
+//   compressor_32/64  Kernel lookup by message length (the one matching word_size)
+//   mb_compressor_32/64  Multi-buffer kernel lookup by typical message length
+//   pad_schedule      Schedule of the padding block after a one-block message (NULL if
+//                     the algorithm has no fixed-length kernels; the lookups below are
+//                     only set alongside it)
+//   sched_compressor_32/64     Schedule kernel lookup by message length
+//   half_compressor_32/64      Half-block kernel lookup by message length
+//   mb_sched_compressor_32/64  Multi-buffer schedule kernel lookup by typical message length
+
+typedef struct sha_descriptor
+{
+    uint8_t block_len;
+    uint8_t word_size;
+    uint8_t word_count;
+    uint8_t digest_len;
+    uint64_t max_message_len;
+    const void * initial_hash;
+    compressor_32_t (* compressor_32)(const uint64_t);
+    compressor_64_t (* compressor_64)(const uint64_t);
+    mb_compressor_32_t (* mb_compressor_32)(const uint64_t);
+    mb_compressor_64_t (* mb_compressor_64)(const uint64_t);
+    const void * pad_schedule;
+    word_compressor_32_t (* sched_compressor_32)(const uint64_t);
+    word_compressor_64_t (* sched_compressor_64)(const uint64_t);
+    word_compressor_32_t (* half_compressor_32)(const uint64_t);
+    word_compressor_64_t (* half_compressor_64)(const uint64_t);
+    word_compressor_32_t (* mb_sched_compressor_32)(const uint64_t);
+    word_compressor_64_t (* mb_sched_compressor_64)(const uint64_t);
+
+} sha_descriptor;
+
+// One descriptor per algorithm, indexed by ShaType (src/descriptor.c)
+extern const sha_descriptor SHA_DESCRIPTORS[7];
+
+// compute_short_32()
+// Hashes a message of at most one block through a dedicated path: a single padded
+// block up to 55 bytes, the half-block kernel at 32 bytes, and one message block plus
+// the precomputed padding schedule at 64 bytes (returns 0, touching nothing, for any
+// other length or where the algorithm lacks the kernels)
+int
+compute_short_32(
+    const sha_descriptor * algorithm,
+    uint32_t * hash_words,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// compute_short_64()
+// As compute_short_32(), at up to 111, 64 and 128 bytes
+int
+compute_short_64(
+    const sha_descriptor * algorithm,
+    uint64_t * hash_words,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// sha_midstate
+// Read-only view of a streaming context that suffixes are hashed on from
+//
+// Members:
+//   hash_words  Chaining value after the prefix's complete blocks
+//   buffer      Prefix bytes past the last complete block
+//   prefix_len  Number of prefix bytes absorbed
+
+typedef struct sha_midstate
+{
+    const void * hash_words;
+    const uint8_t * buffer;
+    uint64_t prefix_len;
+
+} sha_midstate;
+
+// hash_oneshot()
+// Validates arguments and hashes a whole message (backs sha() and shaXXX())
+ShaComputationResult
+hash_oneshot(
+    const sha_descriptor * algorithm,
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+// hash_iov()
+// Validates arguments and hashes a message split across segments
+ShaComputationResult
+hash_iov(
+    const sha_descriptor * algorithm,
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+);
+
+// hash_copy()
+// Validates arguments, copies a whole message to destination and hashes it on the way
+ShaComputationResult
+hash_copy(
+    const sha_descriptor * algorithm,
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+// hash_update()
+// Validates arguments and absorbs input into a streaming context's fields
+ShaComputationResult
+hash_update(
+    const sha_descriptor * algorithm,
+    void * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// hash_update_copy()
+// Validates arguments, copies input to destination and absorbs it into a streaming context's fields
+ShaComputationResult
+hash_update_copy(
+    const sha_descriptor * algorithm,
+    void * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// hash_final()
+// Validates arguments, pads the buffered tail and writes the digest
+ShaComputationResult
+hash_final(
+    const sha_descriptor * algorithm,
+    void * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// hash_batch()
+// Validates a whole batch, then hashes it (multi-buffer where it pays off)
+ShaComputationResult
+hash_batch(
+    const sha_descriptor * algorithm,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// hash_batch_each()
+// Hashes every valid message of a batch, recording a status per message
+// (a NULL statuses array falls back to hash_batch())
+ShaComputationResult
+hash_batch_each(
+    const sha_descriptor * algorithm,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format,
+    ShaComputationResult * statuses
+);
+
+// hash_suffix()
+// Validates arguments and hashes prefix || suffix from a prefix's midstate
+ShaComputationResult
+hash_suffix(
+    const sha_descriptor * algorithm,
+    const sha_midstate * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+);
+
+// hash_suffix_batch()
+// Validates a whole batch of suffixes, then hashes each after the same prefix
+ShaComputationResult
+hash_suffix_batch(
+    const sha_descriptor * algorithm,
+    const sha_midstate * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+// hash_peek()
+// Writes the digest of a streaming context's input so far, leaving it intact
+ShaComputationResult
+hash_peek(
+    const sha_descriptor * algorithm,
+    const void * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    uint8_t * digest,
+    const ShaDigestFormat format
+);
+
+// hash_export()
+// Serializes a streaming context's fields (layout in sharptwoth.h)
+ShaComputationResult
+hash_export(
+    const sha_descriptor * algorithm,
+    const void * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    uint8_t * state
+);
+
+// hash_import()
+// Validates an exported context, then restores a streaming context's fields from it
+ShaComputationResult
+hash_import(
+    const sha_descriptor * algorithm,
+    void * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const uint8_t * state,
+    const size_t state_len
+);
+
+// hash_verify()
+// Validates arguments, hashes a whole message and compares it with an expected digest
+ShaComputationResult
+hash_verify(
+    const sha_descriptor * algorithm,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// hash_final_verify()
+// Pads a streaming context's buffered tail and compares the digest with an expected one
+ShaComputationResult
+hash_final_verify(
+    const sha_descriptor * algorithm,
+    void * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+);
+
+// hash_verify_batch()
+// Hashes every valid message of a batch and compares each with its expected digest,
+// recording a status per message if statuses is given
+ShaComputationResult
+hash_verify_batch(
+    const sha_descriptor * algorithm,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const uint8_t * expected,
+    const ShaDigestFormat format,
+    ShaComputationResult * statuses
+);
+
+//===============//
+// Batch Helpers //
+//===============//
+
+// Function-pointer type for a pass over a chunk of finished chaining values
+// (count values of 8 words each), run before they are formatted
+typedef void (* rehash_32_t)(uint32_t (*)[8], const size_t);
+
+// validate_batch()
+// Checks every message pointer/length pair of a batch before any hashing starts
+ShaComputationResult
+validate_batch(
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const uint64_t max_message_len
+);
+
+// validate_each()
+// Records a status for every message of a batch, returning the first failure
+// (messages and message_lens must not be NULL)
+ShaComputationResult
+validate_each(
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const uint64_t max_message_len,
+    ShaComputationResult * statuses
+);
+
+// batch_32()
+// Hashes a validated batch, writing formatted digests back to back
+// (each message follows the midstate's prefix, or stands alone if midstate is NULL;
+// messages whose status is not HASH_COMPUTED are skipped, if statuses is given)
+void
+batch_32(
+    const sha_descriptor * algorithm,
+    const sha_midstate * midstate,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format,
+    const ShaComputationResult * statuses
+);
+
+// batch_rehash_32()
+// Same as batch_32(), but hands each chunk's chaining values to rehash before they
+// are formatted (SHA-256d hashes them again there); rehash may be NULL
+void
+batch_rehash_32(
+    const sha_descriptor * algorithm,
+    const sha_midstate * midstate,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format,
+    const ShaComputationResult * statuses,
+    const rehash_32_t rehash
+);
+
+// batch_64()
+// Hashes a validated batch, writing formatted digests back to back
+// (each message follows the midstate's prefix, or stands alone if midstate is NULL;
+// messages whose status is not HASH_COMPUTED are skipped, if statuses is given)
+void
+batch_64(
+    const sha_descriptor * algorithm,
+    const sha_midstate * midstate,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format,
+    const ShaComputationResult * statuses
+);
+
+//============//
+// Autotuning //
+//============//
+
+// Message-size buckets the autotuner decides for separately
+// (under 512 bytes, under 8 KiB, and larger)
+#define TUNE_BUCKETS 3
+
+// Algorithm families sharing a compression function
+#define TUNE_160 0
+#define TUNE_256 1
+#define TUNE_512 2
+#define TUNE_FAMILIES 3
+
+// tune_table
+// Autotuner decisions, as ShaBackend values per family and size bucket
+// (BACKEND_AUTO keeps the default kernel)
+//
+// Members:
+//   single  Backend whose single-stream kernel one-shot hashing uses
+//   batch   Backend whose batch path wins (its multi-buffer kernel, or a
+//           loop over single streams if it has none)
+
+typedef struct tune_table
+{
+    uint8_t single[TUNE_FAMILIES][TUNE_BUCKETS];
+    uint8_t batch[TUNE_FAMILIES][TUNE_BUCKETS];
+
+} tune_table;
+
+// tune_bucket()
+// Size bucket a message of the given length falls into
+static inline uint8_t
+tune_bucket(const uint64_t message_len)
+{
+    return (message_len < UINT64_C(512)) ? 0 : (message_len < UINT64_C(8192)) ? 1 : 2;
+}
+
+// backend_supported()
+// Nonzero if the backend is known and the host can run it
+int
+backend_supported(const ShaBackend backend);
+
+// apply_tuning()
+// Rebinds the automatic backend's kernels per size bucket from a decision table
+void
+apply_tuning(const tune_table * table);
+
+//===================//
+// CPU Feature Flags //
+//===================//
+
+#define CPU_FEATURE_SSSE3   (UINT32_C(1) << 0)
+#define CPU_FEATURE_SSE41   (UINT32_C(1) << 1)
+#define CPU_FEATURE_SHA     (UINT32_C(1) << 2)
+#define CPU_FEATURE_AVX     (UINT32_C(1) << 3)
+#define CPU_FEATURE_AVX2    (UINT32_C(1) << 4)
+#define CPU_FEATURE_AVX512  (UINT32_C(1) << 5)
+
+// cpu_probe()
+// Probes the host CPU and caches its features (called once, from the load-time constructor)
+void
+cpu_probe(void);
+
+// cpu_features()
+// Bitmask of CPU_FEATURE_* flags usable on this host (cached by cpu_probe(); zero before it)
+uint32_t
+cpu_features(void);
+
+// cpu_model()
+// Writes the host CPU's brand string (at most name_len - 1 characters)
+void
+cpu_model(char * name, const size_t name_len);
+
+//===================//
+// Padding Functions //
+//===================//
+
+uint8_t
+pad_final_512(
+    uint8_t * tail,
+    const uint8_t * remainder,
+    const uint8_t remainder_len,
+    const uint64_t message_len
+);
+
+uint8_t
+pad_final_1024(
+    uint8_t * tail,
+    const uint8_t * remainder,
+    const uint8_t remainder_len,
+    const uint64_t message_len
+);
+
+//===================//
+// Streaming Helpers //
+//===================//
+
+void
+stream_update_32(
+    uint32_t * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const compressor_32_t compress,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+void
+stream_update_64(
+    uint64_t * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const compressor_64_t compress,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+void
+stream_final_32(
+    uint32_t * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    const compressor_32_t compress
+);
+
+void
+stream_final_64(
+    uint64_t * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    const compressor_64_t compress
+);
+
+// stream_suffix_32()
+// Absorbs a suffix and finalizes, starting from a copy of a midstate's chaining
+// value in hash_words (the midstate's buffer is only read)
+void
+stream_suffix_32(
+    uint32_t * hash_words,
+    const uint8_t * buffer,
+    const uint64_t prefix_len,
+    const compressor_32_t compress,
+    const uint8_t * suffix,
+    const uint64_t suffix_len
+);
+
+// stream_suffix_64()
+// Absorbs a suffix and finalizes, starting from a copy of a midstate's chaining
+// value in hash_words (the midstate's buffer is only read)
+void
+stream_suffix_64(
+    uint64_t * hash_words,
+    const uint8_t * buffer,
+    const uint64_t prefix_len,
+    const compressor_64_t compress,
+    const uint8_t * suffix,
+    const uint64_t suffix_len
+);
+
+// stream_copy_32()
+// Copies input to destination a few blocks at a time, absorbing each run
+// from the copy while it is still in L1 (the buffers must not overlap)
+void
+stream_copy_32(
+    uint32_t * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const compressor_32_t compress,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+// stream_copy_64()
+// Copies input to destination a few blocks at a time, absorbing each run
+// from the copy while it is still in L1 (the buffers must not overlap)
+void
+stream_copy_64(
+    uint64_t * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const compressor_64_t compress,
+    uint8_t * destination,
+    const uint8_t * message,
     const uint64_t message_len
 );
 
@@ -87,4 +1008,112 @@ unpack_64(
     const ShaDigestFormat format
 );
 
+//=================//
+// Digest Encoding //
+//=================//
+
+// encoded_len()
+// Characters in the encoding of raw_len bytes, terminator excluded
+// (BASE64 pads to whole 4-character groups; BASE64URL stops at the last data character)
+static inline size_t
+encoded_len(const size_t raw_len, const ShaDigestFormat format)
+{
+    switch (format)
+    {
+        case HEX_STRING_LOWER:
+        case HEX_STRING_UPPER:
+            return raw_len * 2;
+        case BASE64:
+            return (raw_len + 2) / 3 * 4;
+        case BASE64URL:
+            return raw_len / 3 * 4 + (raw_len % 3 ? raw_len % 3 + 1 : 0);
+        default:
+            return raw_len;
+    }
+}
+
+// digest_stride()
+// Bytes occupied by one formatted digest (text formats include the terminator)
+static inline size_t
+digest_stride(const uint8_t digest_len, const ShaDigestFormat format)
+{
+    return encoded_len(digest_len, format) + (format != OCTET_ARRAY);
+}
+
+// valid_format()
+// Nonzero if the format is one unpack_32/64() can produce
+static inline int
+valid_format(const ShaDigestFormat format)
+{
+    switch (format)
+    {
+        case OCTET_ARRAY:
+        case HEX_STRING_LOWER:
+        case HEX_STRING_UPPER:
+        case BASE64:
+        case BASE64URL:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// encode_digest()
+// Writes raw_len bytes in the given format (text formats are null-terminated)
+void
+encode_digest(
+    uint8_t * encoded,
+    const uint8_t * raw,
+    const size_t raw_len,
+    const ShaDigestFormat format
+);
+
+// decode_digest()
+// Reads the encoding of raw_len bytes back into raw; nonzero if it was well formed
+int
+decode_digest(
+    uint8_t * raw,
+    const uint8_t * encoded,
+    const size_t raw_len,
+    const ShaDigestFormat format
+);
+
+#ifdef SHARP2TH_X86
+
+// SSSE3 codecs (src/x86/encode_ssse3.c); each handles a whole number of vectors
+// and returns the raw bytes it covered, leaving the tail to the portable code
+// (decoders also stop at the first vector holding an invalid character)
+size_t
+hex_encode_ssse3(
+    uint8_t * encoded,
+    const uint8_t * raw,
+    const size_t raw_len,
+    const char * digits
+);
+
+size_t
+hex_decode_ssse3(
+    uint8_t * raw,
+    const uint8_t * encoded,
+    const size_t raw_len
+);
+
+size_t
+base64_encode_ssse3(
+    uint8_t * encoded,
+    const uint8_t * raw,
+    const size_t raw_len,
+    const char * alphabet
+);
+
+size_t
+base64_decode_ssse3(
+    uint8_t * raw,
+    const uint8_t * encoded,
+    const size_t raw_len,
+    const char * alphabet
+);
+
+#endif // SHARP2TH_X86
+
 #endif // SHARP2TH_INTERNAL_H
@@ -0,0 +1,182 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/job.c                                 //
+// Description: Resumable bounded-work hashing            //
+//                                                        //
+//********************************************************//
+
+#include <string.h>
+#include "sharptwoth/internal.h"
+
+//==================//
+// Static Functions //
+//==================//
+
+static uint64_t
+padded_blocks(const sha_descriptor * algorithm, const uint64_t message_len);
+
+static void
+compress_run(
+    const sha_descriptor * algorithm,
+    sha_job * job,
+    const uint8_t * blocks,
+    const uint64_t block_count
+);
+
+//================//
+// Step Interface //
+//================//
+
+ShaComputationResult
+sha_job_init(
+    sha_job * job,
+    ShaType algorithm,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    // Validate arguments
+    if (!job)
+        return NULL_CONTEXT_POINTER;
+
+    if ((unsigned)algorithm > SHA512_256)
+        return INVALID_ALGORITHM;
+
+    const sha_descriptor * descriptor = &SHA_DESCRIPTORS[algorithm];
+
+    if (!message && message_len)
+        return NULL_MESSAGE_POINTER;
+
+    if (message_len > descriptor->max_message_len)
+        return UNSUPPORTED_DATA_SIZE;
+
+    job->algorithm = algorithm;
+    job->message = message;
+    job->message_len = message_len;
+    job->block_count = padded_blocks(descriptor, message_len);
+    job->blocks_done = 0;
+    memcpy(&job->hash_words, descriptor->initial_hash, descriptor->word_count * descriptor->word_size);
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+sha_job_step(
+    sha_job * job,
+    const uint64_t max_blocks,
+    uint64_t * blocks_left
+)
+{
+    if (!job)
+        return NULL_CONTEXT_POINTER;
+
+    const sha_descriptor * algorithm = &SHA_DESCRIPTORS[job->algorithm];
+    uint64_t message_blocks = job->message_len / algorithm->block_len;
+    uint64_t budget = job->block_count - job->blocks_done;
+    uint64_t run;
+
+    if (max_blocks < budget)
+        budget = max_blocks;
+
+    // Complete message blocks are compressed straight from the message
+    if (budget && job->blocks_done < message_blocks)
+    {
+        run = message_blocks - job->blocks_done;
+
+        if (budget < run)
+            run = budget;
+
+        compress_run(algorithm, job, job->message + job->blocks_done * algorithm->block_len, run);
+        job->blocks_done += run;
+        budget -= run;
+    }
+
+    // The padded tail is rebuilt by whichever step reaches it (a budget
+    // of one block may end between its two blocks)
+    if (budget)
+    {
+        uint8_t tail[256];
+        uint8_t remainder_len = (uint8_t)(job->message_len % algorithm->block_len);
+
+        // An empty message may be NULL, which must not be offset (pad_final_*
+        // copies nothing for a zero-length remainder)
+        const uint8_t * remainder = remainder_len
+            ? job->message + (job->message_len - remainder_len) : NULL;
+
+        if (algorithm->block_len == 64)
+            pad_final_512(tail, remainder, remainder_len, job->message_len);
+        else
+            pad_final_1024(tail, remainder, remainder_len, job->message_len);
+
+        compress_run(algorithm, job, tail + (job->blocks_done - message_blocks) * algorithm->block_len, budget);
+        job->blocks_done += budget;
+    }
+
+    if (blocks_left)
+        *blocks_left = job->block_count - job->blocks_done;
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+sha_job_final(
+    sha_job * job,
+    uint8_t * digest,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!job)
+        return NULL_CONTEXT_POINTER;
+
+    if (!digest)
+        return NULL_DIGEST_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    const sha_descriptor * algorithm = &SHA_DESCRIPTORS[job->algorithm];
+
+    // Finish whatever the steps left, then format digest
+    sha_job_step(job, UINT64_MAX, NULL);
+
+    if (algorithm->word_size == 4)
+        unpack_32(digest, job->hash_words.words_32, algorithm->digest_len, format);
+    else
+        unpack_64(digest, job->hash_words.words_64, algorithm->digest_len, format);
+
+    return HASH_COMPUTED;
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static uint64_t
+padded_blocks(const sha_descriptor * algorithm, const uint64_t message_len)
+{
+    // The remainder, the 0x80 marker and the length field (twice the word size)
+    // take one padded block if they fit, two otherwise
+    uint64_t tail_len = message_len % algorithm->block_len + 1 + 2 * algorithm->word_size;
+
+    return message_len / algorithm->block_len + ((tail_len > algorithm->block_len) ? 2 : 1);
+}
+
+static void
+compress_run(
+    const sha_descriptor * algorithm,
+    sha_job * job,
+    const uint8_t * blocks,
+    const uint64_t block_count
+)
+{
+    // The kernel is picked for the whole message, as the one-shot path would
+    if (algorithm->word_size == 4)
+        algorithm->compressor_32(job->message_len)(job->hash_words.words_32, blocks, block_count);
+    else
+        algorithm->compressor_64(job->message_len)(job->hash_words.words_64, blocks, block_count);
+}
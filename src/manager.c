@@ -0,0 +1,244 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/manager.c                             //
+// Description: Multi-stream lane manager                 //
+//                                                        //
+//********************************************************//
+
+#include <string.h>
+#include "sharptwoth/internal.h"
+
+// stream_fields
+// Members of a streaming context, whichever context type holds them
+//
+// Members:
+//   hash_words   Chaining value (uint32_t or uint64_t words)
+//   message_len  Total number of bytes absorbed so far
+//   buffer       Bytes of a partial block awaiting more input
+
+typedef struct stream_fields
+{
+    void * hash_words;
+    uint64_t * message_len;
+    uint8_t * buffer;
+
+} stream_fields;
+
+//==================//
+// Static Functions //
+//==================//
+
+static void
+context_fields(const ShaType algorithm, void * context, stream_fields * fields);
+
+static int
+holds_context(const sha_manager * manager, const void * context);
+
+static void
+run_pending(sha_manager * manager);
+
+//===================//
+// Manager Interface //
+//===================//
+
+ShaComputationResult
+sha_manager_init(sha_manager * manager, ShaType algorithm)
+{
+    if (!manager)
+        return NULL_CONTEXT_POINTER;
+
+    if ((unsigned)algorithm > SHA512_256)
+        return INVALID_ALGORITHM;
+
+    manager->algorithm = algorithm;
+    manager->queued = 0;
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+sha_manager_submit(
+    sha_manager * manager,
+    void * context,
+    const uint8_t * chunk,
+    const uint64_t chunk_len
+)
+{
+    // Validate arguments
+    if (!manager || !context)
+        return NULL_CONTEXT_POINTER;
+
+    if (!chunk && chunk_len)
+        return NULL_MESSAGE_POINTER;
+
+    const sha_descriptor * algorithm = &SHA_DESCRIPTORS[manager->algorithm];
+    stream_fields fields;
+
+    // A stream occupies one lane at a time, so its queued chunk runs first
+    // (which also brings its absorbed length up to date)
+    if (holds_context(manager, context))
+        run_pending(manager);
+
+    context_fields(manager->algorithm, context, &fields);
+
+    if (chunk_len > algorithm->max_message_len - *fields.message_len)
+        return UNSUPPORTED_DATA_SIZE;
+
+    // Chunks that complete no block are only buffered; there is nothing to interleave
+    if (*fields.message_len % algorithm->block_len + chunk_len < algorithm->block_len)
+        return hash_update(algorithm, fields.hash_words, fields.buffer, fields.message_len, chunk, chunk_len);
+
+    // Queue longest first, so long chunks start early and short ones fill the
+    // lanes that free up behind them
+    size_t slot = manager->queued++;
+
+    for (; slot && manager->pending[slot - 1].chunk_len < chunk_len; --slot)
+        manager->pending[slot] = manager->pending[slot - 1];
+
+    manager->pending[slot].context = context;
+    manager->pending[slot].chunk = chunk;
+    manager->pending[slot].chunk_len = chunk_len;
+
+    if (manager->queued == SHA_MANAGER_SLOTS)
+        run_pending(manager);
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+sha_manager_flush(sha_manager * manager)
+{
+    if (!manager)
+        return NULL_CONTEXT_POINTER;
+
+    run_pending(manager);
+
+    return HASH_COMPUTED;
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static void
+context_fields(const ShaType algorithm, void * context, stream_fields * fields)
+{
+    switch (algorithm)
+    {
+        case SHA1:
+        {
+            sha1_ctx * ctx = context;
+            fields->hash_words = ctx->hash_words;
+            fields->message_len = &ctx->message_len;
+            fields->buffer = ctx->buffer;
+            break;
+        }
+
+        case SHA224:
+        case SHA256:
+        {
+            sha256_ctx * ctx = context;
+            fields->hash_words = ctx->hash_words;
+            fields->message_len = &ctx->message_len;
+            fields->buffer = ctx->buffer;
+            break;
+        }
+
+        default:
+        {
+            sha512_ctx * ctx = context;
+            fields->hash_words = ctx->hash_words;
+            fields->message_len = &ctx->message_len;
+            fields->buffer = ctx->buffer;
+            break;
+        }
+    }
+}
+
+static int
+holds_context(const sha_manager * manager, const void * context)
+{
+    for (size_t i = 0; i < manager->queued; ++i)
+    {
+        if (manager->pending[i].context == context)
+            return 1;
+    }
+
+    return 0;
+}
+
+static void
+run_pending(sha_manager * manager)
+{
+    const sha_descriptor * algorithm = &SHA_DESCRIPTORS[manager->algorithm];
+    const sha_manager_entry * pending = manager->pending;
+    stream_fields fields[SHA_MANAGER_SLOTS];
+    mb_job jobs[SHA_MANAGER_SLOTS];
+    size_t queued = manager->queued;
+    int lanes = 0;
+
+    manager->queued = 0;
+
+    // Each job continues its stream from the buffered partial block and
+    // compresses complete blocks only
+    for (size_t i = 0; i < queued; ++i)
+    {
+        context_fields(manager->algorithm, pending[i].context, &fields[i]);
+
+        uint8_t buffered = (uint8_t)(*fields[i].message_len % algorithm->block_len);
+
+        jobs[i].message = pending[i].chunk;
+        jobs[i].message_len = pending[i].chunk_len;
+        jobs[i].hash_words = fields[i].hash_words;
+        jobs[i].absorbed_len = *fields[i].message_len - buffered;
+        jobs[i].prefix = fields[i].buffer;
+        jobs[i].prefix_len = buffered;
+        jobs[i].unpadded = 1;
+    }
+
+    // A lone submission, or a host without lanes, takes the single-stream path
+    if (algorithm->word_size == 4)
+    {
+        mb_compressor_32_t mb_compress = (queued >= 2)
+            ? algorithm->mb_compressor_32(pending[0].chunk_len) : NULL;
+
+        if (mb_compress)
+        {
+            mb_compute_32(mb_compress, algorithm->word_count, jobs, queued, NULL, NULL);
+            lanes = 1;
+        }
+    }
+    else
+    {
+        mb_compressor_64_t mb_compress = (queued >= 2)
+            ? algorithm->mb_compressor_64(pending[0].chunk_len) : NULL;
+
+        if (mb_compress)
+        {
+            mb_compute_64(mb_compress, algorithm->word_count, jobs, queued, NULL, NULL);
+            lanes = 1;
+        }
+    }
+
+    for (size_t i = 0; i < queued; ++i)
+    {
+        if (!lanes)
+        {
+            hash_update(algorithm, fields[i].hash_words, fields[i].buffer, fields[i].message_len,
+                pending[i].chunk, pending[i].chunk_len);
+            continue;
+        }
+
+        // The lanes stopped at the last complete block; the bytes past it
+        // (always inside the chunk, since prefix and chunk filled a block)
+        // become the stream's new partial block
+        uint8_t remainder_len = (uint8_t)((jobs[i].prefix_len + pending[i].chunk_len) % algorithm->block_len);
+
+        memcpy(fields[i].buffer, pending[i].chunk + (pending[i].chunk_len - remainder_len), remainder_len);
+        *fields[i].message_len += pending[i].chunk_len;
+    }
+}
@@ -0,0 +1,322 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/multi.c                               //
+// Description: Several algorithms in one pass            //
+//                                                        //
+//********************************************************//
+
+#include <string.h>
+#include "sharptwoth/internal.h"
+
+// Input walked per pass over the requested algorithms (small enough to stay
+// in L1 from the first algorithm to the last, and a whole number of blocks
+// for both block lengths)
+#define MULTI_CHUNK 8192
+
+// Algorithm families sharing a compression function, and each algorithm's
+// family and slot within it (slots double as multi-buffer lanes)
+#define MULTI_FAMILIES 3
+#define MULTI_SLOTS 4
+
+static const uint8_t FAMILY_OF[7] = { 0, 1, 1, 2, 2, 2, 2 };
+static const uint8_t SLOT_OF[7] = { 0, 0, 1, 0, 1, 2, 3 };
+static const ShaType FAMILY_FIRST[MULTI_FAMILIES] = { SHA1, SHA224, SHA384 };
+
+// multi_pass
+// Progress of one algorithm family over the shared input
+//
+// Members:
+//   algorithm      Descriptor of a requested member (block length and kernels are shared)
+//   requested      Nonzero for each slot whose algorithm was asked for
+//   compress_32/64     Single-stream kernel, used once per requested slot
+//   mb_compress_32/64  Multi-buffer kernel, used instead when two or more slots share
+//                      each block (NULL otherwise)
+//   hash_words     Chaining value per slot
+//   state          Chaining values transposed for the multi-buffer kernel
+
+typedef struct multi_pass
+{
+    const sha_descriptor * algorithm;
+    uint8_t requested[MULTI_SLOTS];
+    compressor_32_t compress_32;
+    compressor_64_t compress_64;
+    mb_compressor_32_t mb_compress_32;
+    mb_compressor_64_t mb_compress_64;
+
+    union
+    {
+        uint32_t words_32[MULTI_SLOTS][8];
+        uint64_t words_64[MULTI_SLOTS][8];
+
+    } hash_words;
+
+    union
+    {
+        uint32_t state_32[8 * MB_LANES];
+        uint64_t state_64[8 * MB_LANES];
+
+    } state;
+
+} multi_pass;
+
+//==================//
+// Static Functions //
+//==================//
+
+static ShaComputationResult
+validate_multi(
+    const ShaType * algorithms,
+    const size_t count,
+    uint8_t * const * digests,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+static void
+pass_start(multi_pass * pass, const uint8_t family, const uint64_t message_len);
+
+static void
+pass_absorb(multi_pass * pass, const uint8_t * blocks, const uint64_t block_count);
+
+static void
+pass_finish(multi_pass * pass, const uint8_t * remainder, const uint64_t message_len);
+
+//======================//
+// Multi-Algorithm Pass //
+//======================//
+
+ShaComputationResult
+sha_multi(
+    const ShaType * algorithms,
+    const size_t count,
+    uint8_t * const * digests,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    ShaComputationResult result =
+        validate_multi(algorithms, count, digests, message, message_len, format);
+
+    if (result != HASH_COMPUTED || !count)
+        return result;
+
+    multi_pass passes[MULTI_FAMILIES];
+    uint64_t whole = message_len - message_len % UINT64_C(128);
+    uint64_t run;
+
+    memset(passes, 0, sizeof(passes));
+
+    // Each algorithm is computed once, however many times it was asked for
+    for (size_t i = 0; i < count; ++i)
+    {
+        passes[FAMILY_OF[algorithms[i]]].algorithm = &SHA_DESCRIPTORS[algorithms[i]];
+        passes[FAMILY_OF[algorithms[i]]].requested[SLOT_OF[algorithms[i]]] = 1;
+    }
+
+    for (uint8_t f = 0; f < MULTI_FAMILIES; ++f)
+    {
+        if (passes[f].algorithm)
+            pass_start(&passes[f], f, message_len);
+    }
+
+    // Every family takes its turn on a chunk before the next chunk is touched
+    for (uint64_t offset = 0; offset < whole; offset += run)
+    {
+        run = (whole - offset < MULTI_CHUNK) ? (whole - offset) : MULTI_CHUNK;
+
+        for (uint8_t f = 0; f < MULTI_FAMILIES; ++f)
+        {
+            if (passes[f].algorithm)
+                pass_absorb(&passes[f], message + offset, run / passes[f].algorithm->block_len);
+        }
+    }
+
+    for (uint8_t f = 0; f < MULTI_FAMILIES; ++f)
+    {
+        if (passes[f].algorithm)
+            pass_finish(&passes[f], message + whole, message_len);
+    }
+
+    // Format digests
+    for (size_t i = 0; i < count; ++i)
+    {
+        const multi_pass * pass = &passes[FAMILY_OF[algorithms[i]]];
+        uint8_t slot = SLOT_OF[algorithms[i]];
+        uint8_t digest_len = SHA_DESCRIPTORS[algorithms[i]].digest_len;
+
+        if (pass->algorithm->word_size == 4)
+            unpack_32(digests[i], pass->hash_words.words_32[slot], digest_len, format);
+        else
+            unpack_64(digests[i], pass->hash_words.words_64[slot], digest_len, format);
+    }
+
+    return HASH_COMPUTED;
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static ShaComputationResult
+validate_multi(
+    const ShaType * algorithms,
+    const size_t count,
+    uint8_t * const * digests,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    if (!count)
+        return HASH_COMPUTED;
+
+    if (!algorithms)
+        return INVALID_ALGORITHM;
+
+    if (!digests)
+        return NULL_DIGEST_POINTER;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if ((unsigned)algorithms[i] > SHA512_256)
+            return INVALID_ALGORITHM;
+
+        if (!digests[i])
+            return NULL_DIGEST_POINTER;
+    }
+
+    if (!message && message_len)
+        return NULL_MESSAGE_POINTER;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (message_len > SHA_DESCRIPTORS[algorithms[i]].max_message_len)
+            return UNSUPPORTED_DATA_SIZE;
+    }
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    return HASH_COMPUTED;
+}
+
+static void
+pass_start(multi_pass * pass, const uint8_t family, const uint64_t message_len)
+{
+    const sha_descriptor * algorithm = pass->algorithm;
+    uint8_t requested = 0;
+
+    for (uint8_t s = 0; s < MULTI_SLOTS; ++s)
+    {
+        if (!pass->requested[s])
+            continue;
+
+        const sha_descriptor * member = &SHA_DESCRIPTORS[FAMILY_FIRST[family] + s];
+
+        if (algorithm->word_size == 4)
+            memcpy(pass->hash_words.words_32[s], member->initial_hash, member->word_count * sizeof(uint32_t));
+        else
+            memcpy(pass->hash_words.words_64[s], member->initial_hash, member->word_count * sizeof(uint64_t));
+
+        ++requested;
+    }
+
+    // IV variants of one family read each block once, through the lanes of
+    // one multi-buffer call (idle slots ride along and are ignored)
+    if (algorithm->word_size == 4)
+    {
+        pass->compress_32 = algorithm->compressor_32(message_len);
+        pass->mb_compress_32 = (requested >= 2) ? algorithm->mb_compressor_32(message_len) : NULL;
+
+        for (uint8_t s = 0; s < MULTI_SLOTS && pass->mb_compress_32; ++s)
+        {
+            for (uint8_t w = 0; w < algorithm->word_count; ++w)
+                pass->state.state_32[w * MB_LANES + s] = pass->hash_words.words_32[s][w];
+        }
+    }
+    else
+    {
+        pass->compress_64 = algorithm->compressor_64(message_len);
+        pass->mb_compress_64 = (requested >= 2) ? algorithm->mb_compressor_64(message_len) : NULL;
+
+        for (uint8_t s = 0; s < MULTI_SLOTS && pass->mb_compress_64; ++s)
+        {
+            for (uint8_t w = 0; w < algorithm->word_count; ++w)
+                pass->state.state_64[w * MB_LANES + s] = pass->hash_words.words_64[s][w];
+        }
+    }
+}
+
+static void
+pass_absorb(multi_pass * pass, const uint8_t * blocks, const uint64_t block_count)
+{
+    const uint8_t block_len = pass->algorithm->block_len;
+    const uint8_t * lane_blocks[MB_LANES];
+
+    if (pass->mb_compress_32 || pass->mb_compress_64)
+    {
+        for (uint64_t b = 0; b < block_count; ++b, blocks += block_len)
+        {
+            for (uint8_t l = 0; l < MB_LANES; ++l)
+                lane_blocks[l] = blocks;
+
+            if (pass->mb_compress_32)
+                pass->mb_compress_32(pass->state.state_32, lane_blocks);
+            else
+                pass->mb_compress_64(pass->state.state_64, lane_blocks);
+        }
+
+        return;
+    }
+
+    for (uint8_t s = 0; s < MULTI_SLOTS; ++s)
+    {
+        if (!pass->requested[s])
+            continue;
+
+        if (pass->algorithm->word_size == 4)
+            pass->compress_32(pass->hash_words.words_32[s], blocks, block_count);
+        else
+            pass->compress_64(pass->hash_words.words_64[s], blocks, block_count);
+    }
+}
+
+static void
+pass_finish(multi_pass * pass, const uint8_t * remainder, const uint64_t message_len)
+{
+    const sha_descriptor * algorithm = pass->algorithm;
+    uint8_t tail[256];
+    uint8_t tail_blocks;
+
+    // Past the last 128-byte boundary a 64-byte family may still have a
+    // whole block; the padded tail (the same for every member) follows it
+    uint8_t remainder_len = (uint8_t)(message_len % UINT64_C(128));
+    uint8_t block_count = remainder_len / algorithm->block_len;
+
+    pass_absorb(pass, remainder, block_count);
+    remainder += block_count * algorithm->block_len;
+    remainder_len -= block_count * algorithm->block_len;
+
+    if (algorithm->block_len == 64)
+        tail_blocks = pad_final_512(tail, remainder, remainder_len, message_len);
+    else
+        tail_blocks = pad_final_1024(tail, remainder, remainder_len, message_len);
+
+    pass_absorb(pass, tail, tail_blocks);
+
+    // Hand lane results back to their slots
+    for (uint8_t s = 0; s < MULTI_SLOTS; ++s)
+    {
+        for (uint8_t w = 0; w < algorithm->word_count && pass->mb_compress_32; ++w)
+            pass->hash_words.words_32[s][w] = pass->state.state_32[w * MB_LANES + s];
+
+        for (uint8_t w = 0; w < algorithm->word_count && pass->mb_compress_64; ++w)
+            pass->hash_words.words_64[s][w] = pass->state.state_64[w * MB_LANES + s];
+    }
+}
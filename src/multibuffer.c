@@ -0,0 +1,301 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/multibuffer.c                         //
+// Description: Lane scheduling for multi-buffer kernels  //
+//                                                        //
+//********************************************************//
+
+#include "sharptwoth/internal.h"
+
+//==================//
+// Lane Bookkeeping //
+//==================//
+
+// mb_lane
+// Progress of the job currently occupying one lane
+//
+// Members:
+//   job             Job in this lane (NULL once the lane has gone idle)
+//   next_block      Block the lane feeds to the next kernel call
+//   message         First complete message block after the head block
+//   message_blocks  Complete message blocks not yet fed
+//   blocks_left     Head, message and padding blocks not yet fed
+//   head            Job prefix completed with the first message bytes
+//   tail            Final one or two padded blocks
+//   fixed_pad       Whether the tail is the constant padding block of a
+//                   one-block message (so its schedule can be precomputed)
+
+typedef struct mb_lane
+{
+    mb_job * job;
+    const uint8_t * next_block;
+    const uint8_t * message;
+    uint64_t message_blocks;
+    uint64_t blocks_left;
+    uint8_t head[128];
+    uint8_t tail[256];
+    int fixed_pad;
+
+} mb_lane;
+
+// Idle lanes still feed the kernel; they read this block and discard the result
+static const uint8_t IDLE_BLOCK[128] = { 0x00 };
+
+//==================//
+// Static Functions //
+//==================//
+
+static void
+lane_start(mb_lane * lane, mb_job * job, const uint8_t block_len);
+
+static void
+lane_advance(mb_lane * lane, const uint8_t block_len);
+
+static int
+lanes_on_fixed_pad(const mb_lane * lanes);
+
+//=====================//
+// Multi-Buffer Engine //
+//=====================//
+
+void
+mb_compute_32(
+    const mb_compressor_32_t compress,
+    const uint8_t word_count,
+    mb_job * jobs,
+    const size_t job_count,
+    const word_compressor_32_t sched_compress,
+    const uint32_t * pad_schedule
+)
+{
+    uint32_t state[8 * MB_LANES];
+    const uint8_t * blocks[MB_LANES];
+    mb_lane lanes[MB_LANES];
+    size_t next_job = 0;
+    int active = 0;
+
+    // Fill every lane that has a job waiting
+    for (int l = 0; l < MB_LANES; ++l)
+    {
+        lanes[l].job = NULL;
+
+        if (next_job < job_count)
+        {
+            lane_start(&lanes[l], &jobs[next_job++], 64);
+            ++active;
+
+            for (uint8_t w = 0; w < word_count; ++w)
+                state[w * MB_LANES + l] = ((uint32_t *)lanes[l].job->hash_words)[w];
+        }
+    }
+
+    while (active)
+    {
+        // Busy lanes all on the same padding block share one precomputed schedule
+        if (sched_compress && pad_schedule && lanes_on_fixed_pad(lanes))
+        {
+            sched_compress(state, pad_schedule);
+        }
+        else
+        {
+            for (int l = 0; l < MB_LANES; ++l)
+                blocks[l] = lanes[l].job ? lanes[l].next_block : IDLE_BLOCK;
+
+            compress(state, blocks);
+        }
+
+        for (int l = 0; l < MB_LANES; ++l)
+        {
+            if (!lanes[l].job)
+                continue;
+
+            lane_advance(&lanes[l], 64);
+
+            if (lanes[l].blocks_left)
+                continue;
+
+            // Lane finished: hand its chaining value back, then refill it
+            uint32_t * hash_words = lanes[l].job->hash_words;
+
+            for (uint8_t w = 0; w < word_count; ++w)
+                hash_words[w] = state[w * MB_LANES + l];
+
+            if (next_job < job_count)
+            {
+                lane_start(&lanes[l], &jobs[next_job++], 64);
+                hash_words = lanes[l].job->hash_words;
+
+                for (uint8_t w = 0; w < word_count; ++w)
+                    state[w * MB_LANES + l] = hash_words[w];
+            }
+            else
+            {
+                lanes[l].job = NULL;
+                --active;
+            }
+        }
+    }
+}
+
+void
+mb_compute_64(
+    const mb_compressor_64_t compress,
+    const uint8_t word_count,
+    mb_job * jobs,
+    const size_t job_count,
+    const word_compressor_64_t sched_compress,
+    const uint64_t * pad_schedule
+)
+{
+    uint64_t state[8 * MB_LANES];
+    const uint8_t * blocks[MB_LANES];
+    mb_lane lanes[MB_LANES];
+    size_t next_job = 0;
+    int active = 0;
+
+    // Fill every lane that has a job waiting
+    for (int l = 0; l < MB_LANES; ++l)
+    {
+        lanes[l].job = NULL;
+
+        if (next_job < job_count)
+        {
+            lane_start(&lanes[l], &jobs[next_job++], 128);
+            ++active;
+
+            for (uint8_t w = 0; w < word_count; ++w)
+                state[w * MB_LANES + l] = ((uint64_t *)lanes[l].job->hash_words)[w];
+        }
+    }
+
+    while (active)
+    {
+        // Busy lanes all on the same padding block share one precomputed schedule
+        if (sched_compress && pad_schedule && lanes_on_fixed_pad(lanes))
+        {
+            sched_compress(state, pad_schedule);
+        }
+        else
+        {
+            for (int l = 0; l < MB_LANES; ++l)
+                blocks[l] = lanes[l].job ? lanes[l].next_block : IDLE_BLOCK;
+
+            compress(state, blocks);
+        }
+
+        for (int l = 0; l < MB_LANES; ++l)
+        {
+            if (!lanes[l].job)
+                continue;
+
+            lane_advance(&lanes[l], 128);
+
+            if (lanes[l].blocks_left)
+                continue;
+
+            // Lane finished: hand its chaining value back, then refill it
+            uint64_t * hash_words = lanes[l].job->hash_words;
+
+            for (uint8_t w = 0; w < word_count; ++w)
+                hash_words[w] = state[w * MB_LANES + l];
+
+            if (next_job < job_count)
+            {
+                lane_start(&lanes[l], &jobs[next_job++], 128);
+                hash_words = lanes[l].job->hash_words;
+
+                for (uint8_t w = 0; w < word_count; ++w)
+                    state[w * MB_LANES + l] = hash_words[w];
+            }
+            else
+            {
+                lanes[l].job = NULL;
+                --active;
+            }
+        }
+    }
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static void
+lane_start(mb_lane * lane, mb_job * job, const uint8_t block_len)
+{
+    const uint8_t * message = job->message;
+    uint64_t message_len = job->message_len;
+    uint64_t total_len = job->absorbed_len + job->prefix_len + message_len;
+    uint8_t head_blocks = 0;
+
+    // A prefix that reaches a block boundary is completed into a head block
+    // from the first message bytes
+    if (job->prefix_len && job->prefix_len + message_len >= block_len)
+    {
+        uint8_t fill = block_len - job->prefix_len;
+
+        memcpy(lane->head, job->prefix, job->prefix_len);
+        memcpy(lane->head + job->prefix_len, message, fill);
+        message += fill;
+        message_len -= fill;
+        head_blocks = 1;
+    }
+
+    uint8_t remainder_len = (uint8_t)(message_len % block_len);
+    const uint8_t * remainder = message + (message_len - remainder_len);
+
+    // Otherwise prefix and message share the padded tail
+    if (job->prefix_len && !head_blocks)
+    {
+        memcpy(lane->head, job->prefix, job->prefix_len);
+        memcpy(lane->head + job->prefix_len, message, remainder_len);
+        remainder = lane->head;
+        remainder_len += job->prefix_len;
+    }
+
+    // Streaming input keeps its remainder for later, so there is no tail
+    uint8_t tail_blocks = job->unpadded ? 0
+        : (block_len == 64)
+        ? pad_final_512(lane->tail, remainder, remainder_len, total_len)
+        : pad_final_1024(lane->tail, remainder, remainder_len, total_len);
+
+    // The padding block depends on nothing but the total length
+    lane->fixed_pad = !job->unpadded && total_len == block_len;
+    lane->job = job;
+    lane->message = message;
+    lane->message_blocks = message_len / block_len;
+    lane->blocks_left = head_blocks + lane->message_blocks + tail_blocks;
+    lane->next_block = head_blocks ? lane->head
+                     : lane->message_blocks ? message : lane->tail;
+}
+
+static void
+lane_advance(mb_lane * lane, const uint8_t block_len)
+{
+    --lane->blocks_left;
+
+    // Step from the head block into the message (or straight into the tail),
+    // and from the last complete message block into the padded tail
+    if (lane->next_block == lane->head)
+        lane->next_block = lane->message_blocks ? lane->message : lane->tail;
+    else if (lane->message_blocks && !--lane->message_blocks)
+        lane->next_block = lane->tail;
+    else
+        lane->next_block += block_len;
+}
+
+static int
+lanes_on_fixed_pad(const mb_lane * lanes)
+{
+    for (int l = 0; l < MB_LANES; ++l)
+    {
+        if (lanes[l].job && (!lanes[l].fixed_pad || lanes[l].next_block != lanes[l].tail))
+            return 0;
+    }
+
+    return 1;
+}
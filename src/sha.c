@@ -21,34 +21,92 @@ sha(
     const ShaDigestFormat format
 )
 {
-    hasher_t hasher;
-
-    switch (algorithm)
-    {
-        case SHA1:
-            hasher = sha1;
-            break;
-        case SHA224:
-            hasher = sha224;
-            break;
-        case SHA256:
-            hasher = sha256;
-            break;
-        case SHA384:
-            hasher = sha384;
-            break;
-        case SHA512:
-            hasher = sha512;
-            break;
-        case SHA512_224:
-            hasher = sha512_224;
-            break;
-        case SHA512_256:
-            hasher = sha512_256;
-            break;
-        default:
-            return INVALID_ALGORITHM;
-    }
-
-    return hasher(digest, message, message_len, format);
+    // The descriptor table is indexed by ShaType, so no per-algorithm wrapper
+    // sits between this and the generic path
+    if ((unsigned)algorithm > SHA512_256)
+        return INVALID_ALGORITHM;
+
+    return hash_oneshot(&SHA_DESCRIPTORS[algorithm], digest, message, message_len, format);
+}
+
+ShaComputationResult
+sha_iov(
+    ShaType algorithm,
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+)
+{
+    if ((unsigned)algorithm > SHA512_256)
+        return INVALID_ALGORITHM;
+
+    return hash_iov(&SHA_DESCRIPTORS[algorithm], digest, segments, count, format);
+}
+
+ShaComputationResult
+sha_batch(
+    ShaType algorithm,
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format,
+    ShaComputationResult * statuses
+)
+{
+    if ((unsigned)algorithm > SHA512_256)
+        return INVALID_ALGORITHM;
+
+    return hash_batch_each(
+        &SHA_DESCRIPTORS[algorithm], digests, messages, message_lens, count, format, statuses);
+}
+
+ShaComputationResult
+sha_copy(
+    ShaType algorithm,
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    if ((unsigned)algorithm > SHA512_256)
+        return INVALID_ALGORITHM;
+
+    return hash_copy(&SHA_DESCRIPTORS[algorithm], digest, destination, message, message_len, format);
+}
+
+ShaComputationResult
+sha_verify(
+    ShaType algorithm,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+)
+{
+    if ((unsigned)algorithm > SHA512_256)
+        return INVALID_ALGORITHM;
+
+    return hash_verify(&SHA_DESCRIPTORS[algorithm], message, message_len, expected, format);
+}
+
+ShaComputationResult
+sha_verify_batch(
+    ShaType algorithm,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const uint8_t * expected,
+    const ShaDigestFormat format,
+    ShaComputationResult * statuses
+)
+{
+    if ((unsigned)algorithm > SHA512_256)
+        return INVALID_ALGORITHM;
+
+    return hash_verify_batch(
+        &SHA_DESCRIPTORS[algorithm], messages, message_lens, count, expected, format, statuses);
 }
@@ -10,8 +10,12 @@
 //                                                        //
 //********************************************************//
 
+#include <string.h>
 #include "sharptwoth/internal.h"
 
+// Parameters driving the generic paths (src/descriptor.c)
+static const sha_descriptor * const ALGORITHM = &SHA_DESCRIPTORS[SHA1];
+
 ShaComputationResult
 sha1(
     uint8_t * digest,
@@ -20,41 +24,238 @@ sha1(
     const ShaDigestFormat format
 )
 {
-    // Validate arguments
-    if (!digest)
-        return NULL_DIGEST_POINTER;
-
-    if (!message && message_len)
-        return NULL_MESSAGE_POINTER;
-
-    if (message_len > SHA1_MAX_MSG_LEN)
-        return UNSUPPORTED_DATA_SIZE;
-    
-    switch (format)
-    {
-        case OCTET_ARRAY:
-        case HEX_STRING_LOWER:
-        case HEX_STRING_UPPER:
-            break;
-        default:
-            return INVALID_DIGEST_FORMAT;
-    }
-
-    // Initialize hash
-    uint32_t hash_words[5] = 
-    {
-        UINT32_C(0x67452301),
-        UINT32_C(0xefcdab89),
-        UINT32_C(0x98badcfe),
-        UINT32_C(0x10325476),
-        UINT32_C(0xc3d2e1f0)
-    };
-
-    // Compute digest
-    compute_160(hash_words, message, message_len);
-    
-    // Format digest
-    unpack_32(digest, hash_words, SHA1_DIGEST_LEN, format);    
+    return hash_oneshot(ALGORITHM, digest, message, message_len, format);
+}
+
+ShaComputationResult
+sha1_init(sha1_ctx * context)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    memcpy(context->hash_words, ALGORITHM->initial_hash, sizeof(context->hash_words));
+    context->message_len = 0;
 
     return HASH_COMPUTED;
 }
+
+ShaComputationResult
+sha1_update(
+    sha1_ctx * context,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_update(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        &context->message_len,
+        message,
+        message_len
+    );
+}
+
+ShaComputationResult
+sha1_final(
+    sha1_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_final(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        digest,
+        format
+    );
+}
+
+ShaComputationResult
+sha1_peek(
+    const sha1_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_peek(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        digest,
+        format
+    );
+}
+
+ShaComputationResult
+sha1_export(
+    const sha1_ctx * context,
+    uint8_t * state
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_export(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        state
+    );
+}
+
+ShaComputationResult
+sha1_import(
+    sha1_ctx * context,
+    const uint8_t * state,
+    const size_t state_len
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_import(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        &context->message_len,
+        state,
+        state_len
+    );
+}
+
+ShaComputationResult
+sha1_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+)
+{
+    return hash_batch(ALGORITHM, digests, messages, message_lens, count, format);
+}
+
+ShaComputationResult
+sha1_suffix(
+    const sha1_ctx * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+)
+{
+    if (!midstate)
+        return NULL_CONTEXT_POINTER;
+
+    sha_midstate view = { midstate->hash_words, midstate->buffer, midstate->message_len };
+
+    return hash_suffix(ALGORITHM, &view, digest, suffix, suffix_len, format);
+}
+
+ShaComputationResult
+sha1_suffix_batch(
+    const sha1_ctx * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+)
+{
+    if (!midstate)
+        return NULL_CONTEXT_POINTER;
+
+    sha_midstate view = { midstate->hash_words, midstate->buffer, midstate->message_len };
+
+    return hash_suffix_batch(ALGORITHM, &view, digests, suffixes, suffix_lens, count, format);
+}
+
+ShaComputationResult
+sha1_iov(
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+)
+{
+    return hash_iov(ALGORITHM, digest, segments, count, format);
+}
+
+ShaComputationResult
+sha1_copy(
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    return hash_copy(ALGORITHM, digest, destination, message, message_len, format);
+}
+
+ShaComputationResult
+sha1_update_copy(
+    sha1_ctx * context,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_update_copy(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        &context->message_len,
+        destination,
+        message,
+        message_len
+    );
+}
+
+ShaComputationResult
+sha1_verify(
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+)
+{
+    return hash_verify(ALGORITHM, message, message_len, expected, format);
+}
+
+ShaComputationResult
+sha1_final_verify(
+    sha1_ctx * context,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_final_verify(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        expected,
+        format
+    );
+}
@@ -10,8 +10,12 @@
 //                                                        //
 //********************************************************//
 
+#include <string.h>
 #include "sharptwoth/internal.h"
 
+// Parameters driving the generic paths (src/descriptor.c)
+static const sha_descriptor * const ALGORITHM = &SHA_DESCRIPTORS[SHA224];
+
 ShaComputationResult
 sha224(
     uint8_t * digest,
@@ -20,44 +24,244 @@ sha224(
     const ShaDigestFormat format
 )
 {
-    // Validate arguments
-    if (!digest)
-        return NULL_DIGEST_POINTER;
-
-    if (!message && message_len)
-        return NULL_MESSAGE_POINTER;
-
-    if (message_len > SHA224_MAX_MSG_LEN)
-        return UNSUPPORTED_DATA_SIZE;
-    
-    switch (format)
-    {
-        case OCTET_ARRAY:
-        case HEX_STRING_LOWER:
-        case HEX_STRING_UPPER:
-            break;
-        default:
-            return INVALID_DIGEST_FORMAT;
-    }
-
-    // Initialize hash
-    uint32_t hash_words[8] = 
-    {
-        UINT32_C(0xc1059ed8),
-        UINT32_C(0x367cd507),
-        UINT32_C(0x3070dd17),
-        UINT32_C(0xf70e5939),
-        UINT32_C(0xffc00b31),
-        UINT32_C(0x68581511),
-        UINT32_C(0x64f98fa7),
-        UINT32_C(0xbefa4fa4)
-    };
-    
-    // Compute digest
-    compute_256(hash_words, message, message_len);
-
-    // Format digest
-    unpack_32(digest, hash_words, SHA224_DIGEST_LEN, format);
+    return hash_oneshot(ALGORITHM, digest, message, message_len, format);
+}
+
+ShaComputationResult
+sha224_init(sha224_ctx * context)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    memcpy(context->hash_words, ALGORITHM->initial_hash, sizeof(context->hash_words));
+    context->message_len = 0;
+    context->digest_len = SHA224_DIGEST_LEN;
 
     return HASH_COMPUTED;
 }
+
+ShaComputationResult
+sha224_update(
+    sha224_ctx * context,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_update(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        &context->message_len,
+        message,
+        message_len
+    );
+}
+
+ShaComputationResult
+sha224_final(
+    sha224_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_final(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        digest,
+        format
+    );
+}
+
+ShaComputationResult
+sha224_peek(
+    const sha224_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_peek(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        digest,
+        format
+    );
+}
+
+ShaComputationResult
+sha224_export(
+    const sha224_ctx * context,
+    uint8_t * state
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_export(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        state
+    );
+}
+
+ShaComputationResult
+sha224_import(
+    sha224_ctx * context,
+    const uint8_t * state,
+    const size_t state_len
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    ShaComputationResult result = hash_import(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        &context->message_len,
+        state,
+        state_len
+    );
+
+    if (result == HASH_COMPUTED)
+        context->digest_len = SHA224_DIGEST_LEN;
+
+    return result;
+}
+
+ShaComputationResult
+sha224_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+)
+{
+    return hash_batch(ALGORITHM, digests, messages, message_lens, count, format);
+}
+
+ShaComputationResult
+sha224_suffix(
+    const sha224_ctx * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+)
+{
+    if (!midstate)
+        return NULL_CONTEXT_POINTER;
+
+    sha_midstate view = { midstate->hash_words, midstate->buffer, midstate->message_len };
+
+    return hash_suffix(ALGORITHM, &view, digest, suffix, suffix_len, format);
+}
+
+ShaComputationResult
+sha224_suffix_batch(
+    const sha224_ctx * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+)
+{
+    if (!midstate)
+        return NULL_CONTEXT_POINTER;
+
+    sha_midstate view = { midstate->hash_words, midstate->buffer, midstate->message_len };
+
+    return hash_suffix_batch(ALGORITHM, &view, digests, suffixes, suffix_lens, count, format);
+}
+
+ShaComputationResult
+sha224_iov(
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+)
+{
+    return hash_iov(ALGORITHM, digest, segments, count, format);
+}
+
+ShaComputationResult
+sha224_copy(
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    return hash_copy(ALGORITHM, digest, destination, message, message_len, format);
+}
+
+ShaComputationResult
+sha224_update_copy(
+    sha224_ctx * context,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_update_copy(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        &context->message_len,
+        destination,
+        message,
+        message_len
+    );
+}
+
+ShaComputationResult
+sha224_verify(
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+)
+{
+    return hash_verify(ALGORITHM, message, message_len, expected, format);
+}
+
+ShaComputationResult
+sha224_final_verify(
+    sha224_ctx * context,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_final_verify(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        expected,
+        format
+    );
+}
@@ -0,0 +1,156 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/sha256d.c                             //
+// Description: Double SHA-256 (SHA-256d) functions       //
+//                                                        //
+//********************************************************//
+
+#include <string.h>
+#include "sharptwoth/internal.h"
+
+// Parameters driving the first hash (src/descriptor.c)
+static const sha_descriptor * const ALGORITHM = &SHA_DESCRIPTORS[SHA256];
+
+//==================//
+// Static Functions //
+//==================//
+
+static void
+first_hash(uint32_t * hash_words, const uint8_t * message, const uint64_t message_len);
+
+static void
+second_hash(uint32_t * hash_words);
+
+static void
+second_hashes(uint32_t (* hash_words)[8], const size_t count);
+
+//================//
+// SHA-256d Paths //
+//================//
+
+ShaComputationResult
+sha256d(
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!digest)
+        return NULL_DIGEST_POINTER;
+
+    if (!message && message_len)
+        return NULL_MESSAGE_POINTER;
+
+    if (message_len > ALGORITHM->max_message_len)
+        return UNSUPPORTED_DATA_SIZE;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    uint32_t hash_words[8];
+
+    first_hash(hash_words, message, message_len);
+    second_hash(hash_words);
+    unpack_32(digest, hash_words, SHA256_DIGEST_LEN, format);
+
+    return HASH_COMPUTED;
+}
+
+ShaComputationResult
+sha256d_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+)
+{
+    // Validate arguments
+    if (!digests && count)
+        return NULL_DIGEST_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    ShaComputationResult result =
+        validate_batch(messages, message_lens, count, ALGORITHM->max_message_len);
+
+    if (result != HASH_COMPUTED)
+        return result;
+
+    // First hashes go through the batch path (ordered longest first, one size
+    // bucket at a time, lanes and all); each chunk of first digests is then
+    // hashed again before it is formatted
+    batch_rehash_32(ALGORITHM, NULL, digests, messages, message_lens, count, format, NULL, second_hashes);
+
+    return HASH_COMPUTED;
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static void
+first_hash(uint32_t * hash_words, const uint8_t * message, const uint64_t message_len)
+{
+    memcpy(hash_words, ALGORITHM->initial_hash, 8 * sizeof(uint32_t));
+
+    if (!compute_short_32(ALGORITHM, hash_words, message, message_len))
+        compute_32(ALGORITHM->compressor_32(message_len), hash_words, message, message_len);
+}
+
+static void
+second_hash(uint32_t * hash_words)
+{
+    // The first digest's words are the second message's words as they stand
+    // (no byte round trip), and its padding is constant
+    uint32_t words[8];
+
+    memcpy(words, hash_words, sizeof(words));
+    memcpy(hash_words, ALGORITHM->initial_hash, sizeof(words));
+
+    half_compressor_256(SHA256_DIGEST_LEN)(hash_words, words);
+}
+
+static void
+second_hashes(uint32_t (* hash_words)[8], const size_t count)
+{
+    word_compressor_32_t mb_half = (count >= 2) ? mb_half_compressor_256(SHA256_DIGEST_LEN) : NULL;
+    const uint32_t * initial_hash = ALGORITHM->initial_hash;
+    uint32_t state[8 * MB_LANES];
+    uint32_t words[8 * MB_LANES];
+    size_t i = 0;
+
+    // Eight digests at a time, transposed into the kernel's layout (lanes past
+    // the last digest repeat it and are discarded)
+    for (; mb_half && i < count; i += MB_LANES)
+    {
+        for (int l = 0; l < MB_LANES; ++l)
+        {
+            const uint32_t * source = hash_words[(i + l < count) ? i + l : count - 1];
+
+            for (uint8_t w = 0; w < 8; ++w)
+            {
+                words[w * MB_LANES + l] = source[w];
+                state[w * MB_LANES + l] = initial_hash[w];
+            }
+        }
+
+        mb_half(state, words);
+
+        for (int l = 0; l < MB_LANES && i + l < count; ++l)
+        {
+            for (uint8_t w = 0; w < 8; ++w)
+                hash_words[i + l][w] = state[w * MB_LANES + l];
+        }
+    }
+
+    for (; i < count; ++i)
+        second_hash(hash_words[i]);
+}
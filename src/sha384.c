@@ -10,8 +10,12 @@
 //                                                        //
 //********************************************************//
 
+#include <string.h>
 #include "sharptwoth/internal.h"
 
+// Parameters driving the generic paths (src/descriptor.c)
+static const sha_descriptor * const ALGORITHM = &SHA_DESCRIPTORS[SHA384];
+
 ShaComputationResult
 sha384(
     uint8_t * digest,
@@ -20,41 +24,244 @@ sha384(
     const ShaDigestFormat format
 )
 {
-    // Validate arguments
-    if (!digest)
-        return NULL_DIGEST_POINTER;
-
-    if (!message && message_len)
-        return NULL_MESSAGE_POINTER;
-    
-    switch (format)
-    {
-        case OCTET_ARRAY:
-        case HEX_STRING_LOWER:
-        case HEX_STRING_UPPER:
-            break;
-        default:
-            return INVALID_DIGEST_FORMAT;
-    }
-
-    // Initialize hash
-    uint64_t hash_words[8] = 
-    {
-        UINT64_C(0xcbbb9d5dc1059ed8),
-        UINT64_C(0x629a292a367cd507),
-        UINT64_C(0x9159015a3070dd17),
-        UINT64_C(0x152fecd8f70e5939),
-        UINT64_C(0x67332667ffc00b31),
-        UINT64_C(0x8eb44a8768581511),
-        UINT64_C(0xdb0c2e0d64f98fa7),
-        UINT64_C(0x47b5481dbefa4fa4)
-    };
-
-    // Compute digest
-    compute_512(hash_words, message, message_len);
-
-    // Format digest
-    unpack_64(digest, hash_words, SHA384_DIGEST_LEN, format);
+    return hash_oneshot(ALGORITHM, digest, message, message_len, format);
+}
+
+ShaComputationResult
+sha384_init(sha384_ctx * context)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    memcpy(context->hash_words, ALGORITHM->initial_hash, sizeof(context->hash_words));
+    context->message_len = 0;
+    context->digest_len = SHA384_DIGEST_LEN;
 
     return HASH_COMPUTED;
 }
+
+ShaComputationResult
+sha384_update(
+    sha384_ctx * context,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_update(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        &context->message_len,
+        message,
+        message_len
+    );
+}
+
+ShaComputationResult
+sha384_final(
+    sha384_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_final(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        digest,
+        format
+    );
+}
+
+ShaComputationResult
+sha384_peek(
+    const sha384_ctx * context,
+    uint8_t * digest,
+    const ShaDigestFormat format
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_peek(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        digest,
+        format
+    );
+}
+
+ShaComputationResult
+sha384_export(
+    const sha384_ctx * context,
+    uint8_t * state
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_export(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        state
+    );
+}
+
+ShaComputationResult
+sha384_import(
+    sha384_ctx * context,
+    const uint8_t * state,
+    const size_t state_len
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    ShaComputationResult result = hash_import(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        &context->message_len,
+        state,
+        state_len
+    );
+
+    if (result == HASH_COMPUTED)
+        context->digest_len = SHA384_DIGEST_LEN;
+
+    return result;
+}
+
+ShaComputationResult
+sha384_batch(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const ShaDigestFormat format
+)
+{
+    return hash_batch(ALGORITHM, digests, messages, message_lens, count, format);
+}
+
+ShaComputationResult
+sha384_suffix(
+    const sha384_ctx * midstate,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+)
+{
+    if (!midstate)
+        return NULL_CONTEXT_POINTER;
+
+    sha_midstate view = { midstate->hash_words, midstate->buffer, midstate->message_len };
+
+    return hash_suffix(ALGORITHM, &view, digest, suffix, suffix_len, format);
+}
+
+ShaComputationResult
+sha384_suffix_batch(
+    const sha384_ctx * midstate,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+)
+{
+    if (!midstate)
+        return NULL_CONTEXT_POINTER;
+
+    sha_midstate view = { midstate->hash_words, midstate->buffer, midstate->message_len };
+
+    return hash_suffix_batch(ALGORITHM, &view, digests, suffixes, suffix_lens, count, format);
+}
+
+ShaComputationResult
+sha384_iov(
+    uint8_t * digest,
+    const struct iovec * segments,
+    const int count,
+    const ShaDigestFormat format
+)
+{
+    return hash_iov(ALGORITHM, digest, segments, count, format);
+}
+
+ShaComputationResult
+sha384_copy(
+    uint8_t * digest,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    return hash_copy(ALGORITHM, digest, destination, message, message_len, format);
+}
+
+ShaComputationResult
+sha384_update_copy(
+    sha384_ctx * context,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_update_copy(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        &context->message_len,
+        destination,
+        message,
+        message_len
+    );
+}
+
+ShaComputationResult
+sha384_verify(
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+)
+{
+    return hash_verify(ALGORITHM, message, message_len, expected, format);
+}
+
+ShaComputationResult
+sha384_final_verify(
+    sha384_ctx * context,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+)
+{
+    if (!context)
+        return NULL_CONTEXT_POINTER;
+
+    return hash_final_verify(
+        ALGORITHM,
+        context->hash_words,
+        context->buffer,
+        context->message_len,
+        expected,
+        format
+    );
+}
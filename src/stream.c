@@ -0,0 +1,217 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/stream.c                              //
+// Description: Shared init/update/final helpers          //
+//                                                        //
+//********************************************************//
+
+#include <string.h>
+#include "sharptwoth/internal.h"
+
+// Bytes copied per step of a fused copy (a whole number of blocks, hashed
+// from the destination while the copy is still in L1)
+#define COPY_CHUNK 4096
+
+//===================//
+// Streaming Helpers //
+//===================//
+
+void
+stream_update_32(
+    uint32_t * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const compressor_32_t compress,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    if (!message_len)
+        return;
+
+    uint8_t buffered = (uint8_t)(*total_len % UINT64_C(64));
+    uint64_t remaining = message_len;
+    *total_len += message_len;
+
+    // Top up a partially-filled block before touching the caller's data
+    if (buffered)
+    {
+        uint8_t fill = 64 - buffered;
+
+        if (remaining < fill)
+        {
+            memcpy(buffer + buffered, message, remaining);
+            return;
+        }
+
+        memcpy(buffer + buffered, message, fill);
+        compress(hash_words, buffer, 1);
+        message += fill;
+        remaining -= fill;
+    }
+
+    // Complete blocks are compressed in place
+    uint64_t block_count = remaining / UINT64_C(64);
+    compress(hash_words, message, block_count);
+
+    // Hold on to the trailing partial block until more data arrives
+    message += block_count << 6;
+    memcpy(buffer, message, remaining % UINT64_C(64));
+}
+
+void
+stream_update_64(
+    uint64_t * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const compressor_64_t compress,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    if (!message_len)
+        return;
+
+    uint8_t buffered = (uint8_t)(*total_len % UINT64_C(128));
+    uint64_t remaining = message_len;
+    *total_len += message_len;
+
+    // Top up a partially-filled block before touching the caller's data
+    if (buffered)
+    {
+        uint8_t fill = 128 - buffered;
+
+        if (remaining < fill)
+        {
+            memcpy(buffer + buffered, message, remaining);
+            return;
+        }
+
+        memcpy(buffer + buffered, message, fill);
+        compress(hash_words, buffer, 1);
+        message += fill;
+        remaining -= fill;
+    }
+
+    // Complete blocks are compressed in place
+    uint64_t block_count = remaining / UINT64_C(128);
+    compress(hash_words, message, block_count);
+
+    // Hold on to the trailing partial block until more data arrives
+    message += block_count << 7;
+    memcpy(buffer, message, remaining % UINT64_C(128));
+}
+
+void
+stream_final_32(
+    uint32_t * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    const compressor_32_t compress
+)
+{
+    uint8_t tail[128];
+    uint8_t tail_blocks = pad_final_512(
+        tail, buffer, (uint8_t)(total_len % UINT64_C(64)), total_len);
+
+    compress(hash_words, tail, tail_blocks);
+}
+
+void
+stream_final_64(
+    uint64_t * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    const compressor_64_t compress
+)
+{
+    uint8_t tail[256];
+    uint8_t tail_blocks = pad_final_1024(
+        tail, buffer, (uint8_t)(total_len % UINT64_C(128)), total_len);
+
+    compress(hash_words, tail, tail_blocks);
+}
+
+void
+stream_suffix_32(
+    uint32_t * hash_words,
+    const uint8_t * buffer,
+    const uint64_t prefix_len,
+    const compressor_32_t compress,
+    const uint8_t * suffix,
+    const uint64_t suffix_len
+)
+{
+    // The midstate's buffer is shared, so its partial block is topped up in a copy
+    uint8_t block[64];
+    uint64_t total_len = prefix_len;
+    memcpy(block, buffer, (size_t)(prefix_len % UINT64_C(64)));
+
+    stream_update_32(hash_words, block, &total_len, compress, suffix, suffix_len);
+    stream_final_32(hash_words, block, total_len, compress);
+}
+
+void
+stream_suffix_64(
+    uint64_t * hash_words,
+    const uint8_t * buffer,
+    const uint64_t prefix_len,
+    const compressor_64_t compress,
+    const uint8_t * suffix,
+    const uint64_t suffix_len
+)
+{
+    // The midstate's buffer is shared, so its partial block is topped up in a copy
+    uint8_t block[128];
+    uint64_t total_len = prefix_len;
+    memcpy(block, buffer, (size_t)(prefix_len % UINT64_C(128)));
+
+    stream_update_64(hash_words, block, &total_len, compress, suffix, suffix_len);
+    stream_final_64(hash_words, block, total_len, compress);
+}
+
+void
+stream_copy_32(
+    uint32_t * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const compressor_32_t compress,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    uint64_t run;
+
+    for (uint64_t offset = 0; offset < message_len; offset += run)
+    {
+        run = (message_len - offset < COPY_CHUNK) ? (message_len - offset) : COPY_CHUNK;
+        memcpy(destination + offset, message + offset, run);
+        stream_update_32(hash_words, buffer, total_len, compress, destination + offset, run);
+    }
+}
+
+void
+stream_copy_64(
+    uint64_t * hash_words,
+    uint8_t * buffer,
+    uint64_t * total_len,
+    const compressor_64_t compress,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    uint64_t run;
+
+    for (uint64_t offset = 0; offset < message_len; offset += run)
+    {
+        run = (message_len - offset < COPY_CHUNK) ? (message_len - offset) : COPY_CHUNK;
+        memcpy(destination + offset, message + offset, run);
+        stream_update_64(hash_words, buffer, total_len, compress, destination + offset, run);
+    }
+}
@@ -0,0 +1,172 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/verify.c                              //
+// Description: Digest verification                       //
+//                                                        //
+//********************************************************//
+
+#include <string.h>
+#include "sharptwoth/internal.h"
+
+// Messages verified per batch window: one multi-buffer engine chunk, so the raw
+// digests take 4 KB of stack on top of the batch path's own frame
+#define VERIFY_WINDOW 64
+
+//==================//
+// Static Functions //
+//==================//
+
+static ShaComputationResult
+compare_digest(
+    const uint8_t * computed,
+    const uint8_t * expected,
+    const uint8_t digest_len,
+    const ShaDigestFormat format
+);
+
+//==============//
+// Verification //
+//==============//
+
+ShaComputationResult
+hash_verify(
+    const sha_descriptor * algorithm,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+)
+{
+    uint8_t computed[64];
+
+    // Validate arguments
+    if (!expected)
+        return NULL_DIGEST_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    // The raw digest is only the chaining value stored big-endian; nothing is encoded
+    ShaComputationResult result = hash_oneshot(algorithm, computed, message, message_len, OCTET_ARRAY);
+
+    if (result != HASH_COMPUTED)
+        return result;
+
+    return compare_digest(computed, expected, algorithm->digest_len, format);
+}
+
+ShaComputationResult
+hash_final_verify(
+    const sha_descriptor * algorithm,
+    void * hash_words,
+    const uint8_t * buffer,
+    const uint64_t total_len,
+    const uint8_t * expected,
+    const ShaDigestFormat format
+)
+{
+    uint8_t computed[64];
+
+    // Validate arguments
+    if (!expected)
+        return NULL_DIGEST_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    hash_final(algorithm, hash_words, buffer, total_len, computed, OCTET_ARRAY);
+
+    return compare_digest(computed, expected, algorithm->digest_len, format);
+}
+
+ShaComputationResult
+hash_verify_batch(
+    const sha_descriptor * algorithm,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens,
+    const size_t count,
+    const uint8_t * expected,
+    const ShaDigestFormat format,
+    ShaComputationResult * statuses
+)
+{
+    uint8_t computed[VERIFY_WINDOW * 64];
+    ShaComputationResult window_statuses[VERIFY_WINDOW];
+    ShaComputationResult first = HASH_COMPUTED;
+    size_t stride = digest_stride(algorithm->digest_len, format);
+    size_t window;
+
+    // Validate arguments (errors that apply to the whole batch come first)
+    if (!expected && count)
+        return NULL_DIGEST_POINTER;
+
+    if (!valid_format(format))
+        return INVALID_DIGEST_FORMAT;
+
+    if (!count)
+        return HASH_COMPUTED;
+
+    if (!messages || !message_lens)
+        return NULL_MESSAGE_POINTER;
+
+    // Raw digests for a window at a time go through the batch path (lanes and
+    // all), then each is compared with its expected value
+    for (size_t base = 0; base < count; base += window)
+    {
+        window = (count - base < VERIFY_WINDOW) ? (count - base) : VERIFY_WINDOW;
+
+        validate_each(messages + base, message_lens + base, window, algorithm->max_message_len, window_statuses);
+
+        if (algorithm->word_size == 4)
+            batch_32(algorithm, NULL, computed, messages + base, message_lens + base, window, OCTET_ARRAY, window_statuses);
+        else
+            batch_64(algorithm, NULL, computed, messages + base, message_lens + base, window, OCTET_ARRAY, window_statuses);
+
+        for (size_t i = 0; i < window; ++i)
+        {
+            if (window_statuses[i] == HASH_COMPUTED)
+            {
+                window_statuses[i] = compare_digest(computed + i * algorithm->digest_len, 
+                    expected + (base + i) * stride, algorithm->digest_len, format);
+            }
+
+            if (first == HASH_COMPUTED)
+                first = window_statuses[i];
+        }
+
+        if (statuses)
+            memcpy(statuses + base, window_statuses, window * sizeof(ShaComputationResult));
+    }
+
+    return first;
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static ShaComputationResult
+compare_digest(
+    const uint8_t * computed,
+    const uint8_t * expected,
+    const uint8_t digest_len,
+    const ShaDigestFormat format
+)
+{
+    uint8_t raw[64];
+    uint8_t diff = 0;
+
+    // An expected value that is not an encoding of a digest cannot match one
+    if (!decode_digest(raw, expected, digest_len, format))
+        return DIGEST_MISMATCH;
+
+    // Constant time: every byte is compared, whatever the first difference
+    for (uint8_t i = 0; i < digest_len; ++i)
+        diff |= computed[i] ^ raw[i];
+
+    return diff ? DIGEST_MISMATCH : HASH_COMPUTED;
+}
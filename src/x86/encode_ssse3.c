@@ -0,0 +1,225 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/x86/encode_ssse3.c                    //
+// Description: Hex and base64 codecs (SSSE3)             //
+//                                                        //
+//********************************************************//
+
+#include <immintrin.h>
+#include "sharptwoth/internal.h"
+
+//==================//
+// Static Functions //
+//==================//
+
+// in_range()
+// Mask of the characters in [first, first + count) (the subtraction moves the
+// range to start at 0, where one signed comparison pair bounds it)
+static inline __m128i
+in_range(const __m128i c, const char first, const char count)
+{
+    __m128i offset = _mm_sub_epi8(c, _mm_set1_epi8(first));
+
+    return _mm_and_si128(_mm_cmpgt_epi8(offset, _mm_set1_epi8(-1)),
+        _mm_cmplt_epi8(offset, _mm_set1_epi8(count)));
+}
+
+// blend()
+// Bytes of a where the mask is set, of b elsewhere
+static inline __m128i
+blend(const __m128i mask, const __m128i a, const __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// hex_digits()
+// Interleaves the digit characters of each byte's high and low nibble
+static inline void
+hex_digits(const __m128i bytes, const __m128i table, __m128i * first, __m128i * second)
+{
+    __m128i low_nibbles = _mm_set1_epi8(0x0f);
+    __m128i high = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibbles));
+    __m128i low = _mm_shuffle_epi8(table, _mm_and_si128(bytes, low_nibbles));
+
+    *first = _mm_unpacklo_epi8(high, low);
+    *second = _mm_unpackhi_epi8(high, low);
+}
+
+// hex_values()
+// Nibble values of sixteen hex digits in either case, and whether all were digits
+static inline __m128i
+hex_values(const __m128i c, int * valid)
+{
+    __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    __m128i is_digit = in_range(c, '0', 10);
+    __m128i is_letter = in_range(lower, 'a', 6);
+
+    *valid = _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) == 0xffff;
+
+    return blend(is_digit, _mm_sub_epi8(c, _mm_set1_epi8('0')),
+        _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+//============//
+// Hex Codecs //
+//============//
+
+size_t
+hex_encode_ssse3(
+    uint8_t * encoded,
+    const uint8_t * raw,
+    const size_t raw_len,
+    const char * digits
+)
+{
+    __m128i table = _mm_loadu_si128((const __m128i *)digits);
+    __m128i first, second;
+    size_t i = 0;
+
+    for (; i + 16 <= raw_len; i += 16)
+    {
+        hex_digits(_mm_loadu_si128((const __m128i *)(raw + i)), table, &first, &second);
+        _mm_storeu_si128((__m128i *)(encoded + 2 * i), first);
+        _mm_storeu_si128((__m128i *)(encoded + 2 * i + 16), second);
+    }
+
+    // Half a vector more (the SHA-224 and SHA-512/224 tails: 28 = 16 + 8 + 4)
+    if (i + 8 <= raw_len)
+    {
+        hex_digits(_mm_loadl_epi64((const __m128i *)(raw + i)), table, &first, &second);
+        _mm_storeu_si128((__m128i *)(encoded + 2 * i), first);
+        i += 8;
+    }
+
+    return i;
+}
+
+size_t
+hex_decode_ssse3(
+    uint8_t * raw,
+    const uint8_t * encoded,
+    const size_t raw_len
+)
+{
+    // Weights folding each digit pair into a byte: high * 16 + low
+    __m128i pair_weights = _mm_set1_epi16(0x0110);
+    __m128i high, low;
+    int high_valid, low_valid;
+    size_t i = 0;
+
+    for (; i + 16 <= raw_len; i += 16)
+    {
+        high = hex_values(_mm_loadu_si128((const __m128i *)(encoded + 2 * i)), &high_valid);
+        low = hex_values(_mm_loadu_si128((const __m128i *)(encoded + 2 * i + 16)), &low_valid);
+
+        if (!high_valid || !low_valid)
+            break;
+
+        high = _mm_maddubs_epi16(high, pair_weights);
+        low = _mm_maddubs_epi16(low, pair_weights);
+        _mm_storeu_si128((__m128i *)(raw + i), _mm_packus_epi16(high, low));
+    }
+
+    return i;
+}
+
+//===============//
+// Base64 Codecs //
+//===============//
+
+size_t
+base64_encode_ssse3(
+    uint8_t * encoded,
+    const uint8_t * raw,
+    const size_t raw_len,
+    const char * alphabet
+)
+{
+    // Each 32-bit lane gets one 3-byte group as bytes 1, 0, 2, 1, so that
+    // every sextet can be shifted into its own byte with 16-bit multiplies
+    __m128i spread = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    __m128i in, indices, offsets;
+    size_t i = 0;
+
+    // Offsets from sextet to character: 'A' below 26, 'a' - 26 below 52,
+    // '0' - 52 below 62, then the alphabet's own last two characters
+    __m128i upper = _mm_set1_epi8('A');
+    __m128i lower = _mm_set1_epi8('a' - 26);
+    __m128i digit = _mm_set1_epi8('0' - 52);
+    __m128i char_62 = _mm_set1_epi8((char)(alphabet[62] - 62));
+    __m128i char_63 = _mm_set1_epi8((char)(alphabet[63] - 63));
+
+    // Sixteen bytes are loaded for the twelve each step consumes
+    for (; i + 16 <= raw_len; i += 12)
+    {
+        in = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(raw + i)), spread);
+
+        indices = _mm_or_si128(
+            _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040)),
+            _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010)));
+
+        offsets = blend(_mm_cmpgt_epi8(indices, _mm_set1_epi8(25)), lower, upper);
+        offsets = blend(_mm_cmpgt_epi8(indices, _mm_set1_epi8(51)), digit, offsets);
+        offsets = blend(_mm_cmpeq_epi8(indices, _mm_set1_epi8(62)), char_62, offsets);
+        offsets = blend(_mm_cmpeq_epi8(indices, _mm_set1_epi8(63)), char_63, offsets);
+
+        _mm_storeu_si128((__m128i *)(encoded + i / 3 * 4), _mm_add_epi8(indices, offsets));
+    }
+
+    return i;
+}
+
+size_t
+base64_decode_ssse3(
+    uint8_t * raw,
+    const uint8_t * encoded,
+    const size_t raw_len,
+    const char * alphabet
+)
+{
+    // Gathers the three bytes of each 32-bit lane, most significant first
+    __m128i gather = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    __m128i c, is_upper, is_lower, is_digit, is_62, is_63, offsets, values;
+    uint8_t bytes[16];
+    size_t i = 0;
+
+    // Only whole 4-character groups; the last partial group and its padding
+    // are left to the portable decoder
+    for (; i + 12 <= raw_len / 3 * 3; i += 12)
+    {
+        c = _mm_loadu_si128((const __m128i *)(encoded + i / 3 * 4));
+
+        is_upper = in_range(c, 'A', 26);
+        is_lower = in_range(c, 'a', 26);
+        is_digit = in_range(c, '0', 10);
+        is_62 = _mm_cmpeq_epi8(c, _mm_set1_epi8(alphabet[62]));
+        is_63 = _mm_cmpeq_epi8(c, _mm_set1_epi8(alphabet[63]));
+
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(is_upper, is_lower),
+                _mm_or_si128(is_digit, _mm_or_si128(is_62, is_63)))) != 0xffff)
+            break;
+
+        // The masks are disjoint, so their offsets can simply be combined
+        offsets = _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(is_upper, _mm_set1_epi8(-'A')),
+                         _mm_and_si128(is_lower, _mm_set1_epi8(26 - 'a'))),
+            _mm_or_si128(_mm_and_si128(is_digit, _mm_set1_epi8(52 - '0')),
+                         _mm_or_si128(_mm_and_si128(is_62, _mm_set1_epi8((char)(62 - alphabet[62]))),
+                                      _mm_and_si128(is_63, _mm_set1_epi8((char)(63 - alphabet[63]))))));
+
+        values = _mm_add_epi8(c, offsets);
+
+        // Sextet pairs into 12-bit values, then pairs of those into 24-bit groups
+        values = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        values = _mm_madd_epi16(values, _mm_set1_epi32(0x00011000));
+
+        _mm_storeu_si128((__m128i *)bytes, _mm_shuffle_epi8(values, gather));
+        memcpy(raw + i, bytes, 12);
+    }
+
+    return i;
+}
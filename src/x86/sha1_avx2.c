@@ -0,0 +1,94 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/x86/sha1_avx2.c                       //
+// Description: 8-lane multi-buffer SHA-1 kernel (AVX2)   //
+//                                                        //
+//********************************************************//
+
+#include <immintrin.h>
+#include "sharptwoth/internal.h"
+#include "transpose_avx2.h"
+
+//========================//
+// Vector Function Macros //
+//========================//
+
+// Each __m256i holds the same word from all eight lanes
+#define ADD(x, y)       _mm256_add_epi32((x), (y))
+#define XOR(x, y)       _mm256_xor_si256((x), (y))
+#define ROTL_V(x, r)    _mm256_or_si256(_mm256_slli_epi32((x), (r)), _mm256_srli_epi32((x), 32 - (r)))
+
+#define CH_V(x, y, z)       XOR(_mm256_and_si256((x), (y)), _mm256_andnot_si256((x), (z)))
+#define MAJ_V(x, y, z)      XOR(_mm256_and_si256((x), XOR((y), (z))), _mm256_and_si256((y), (z)))
+#define PARITY_V(x, y, z)   XOR(XOR((x), (y)), (z))
+
+// Message-schedule ring, as in the scalar kernel
+#define W(t) w[(t) & 15]
+
+#define ROUND_V(a, b, c, d, e, f, k, t)                                     \
+    do                                                                      \
+    {                                                                       \
+        if ((t) >= 16)                                                      \
+            W(t) = ROTL_V(XOR(XOR(W((t) - 3), W((t) - 8)),                  \
+                              XOR(W((t) - 14), W(t))), 1);                  \
+        (e) = ADD(ADD((e), ADD(ROTL_V((a), 5), f((b), (c), (d)))),          \
+                  ADD((k), W(t)));                                          \
+        (b) = ROTL_V((b), 30);                                              \
+    } while (0)
+
+#define ROUNDS5_V(f, k, t)                         \
+    ROUND_V(a, b, c, d, e, f, k, (t));             \
+    ROUND_V(e, a, b, c, d, f, k, (t) + 1);         \
+    ROUND_V(d, e, a, b, c, f, k, (t) + 2);         \
+    ROUND_V(c, d, e, a, b, f, k, (t) + 3);         \
+    ROUND_V(b, c, d, e, a, f, k, (t) + 4)
+
+#define ROUNDS20_V(f, k, t)                        \
+    ROUNDS5_V(f, k, (t));                          \
+    ROUNDS5_V(f, k, (t) + 5);                      \
+    ROUNDS5_V(f, k, (t) + 10);                     \
+    ROUNDS5_V(f, k, (t) + 15)
+
+// Adds a working variable back into its row of the transposed state
+#define FEED_FORWARD(x, i)                                          \
+    _mm256_storeu_si256((__m256i *)(state + (i) * MB_LANES),        \
+        ADD((x), _mm256_loadu_si256((const __m256i *)(state + (i) * MB_LANES))))
+
+//=====================//
+// Multi-Buffer Kernel //
+//=====================//
+
+void
+compress_160x8_avx2(
+    uint32_t * state,
+    const uint8_t * const * blocks
+)
+{
+    __m256i w[16];
+    __m256i a, b, c, d, e;
+
+    // Message words 0..7 and 8..15, one vector per word
+    load_transposed_32(w, blocks, 0);
+    load_transposed_32(w + 8, blocks, 32);
+
+    a = _mm256_loadu_si256((const __m256i *)(state + 0 * MB_LANES));
+    b = _mm256_loadu_si256((const __m256i *)(state + 1 * MB_LANES));
+    c = _mm256_loadu_si256((const __m256i *)(state + 2 * MB_LANES));
+    d = _mm256_loadu_si256((const __m256i *)(state + 3 * MB_LANES));
+    e = _mm256_loadu_si256((const __m256i *)(state + 4 * MB_LANES));
+
+    ROUNDS20_V(CH_V, _mm256_set1_epi32((int)SHA1_CONSTANTS[0]), 0);
+    ROUNDS20_V(PARITY_V, _mm256_set1_epi32((int)SHA1_CONSTANTS[1]), 20);
+    ROUNDS20_V(MAJ_V, _mm256_set1_epi32((int)SHA1_CONSTANTS[2]), 40);
+    ROUNDS20_V(PARITY_V, _mm256_set1_epi32((int)SHA1_CONSTANTS[3]), 60);
+
+    FEED_FORWARD(a, 0);
+    FEED_FORWARD(b, 1);
+    FEED_FORWARD(c, 2);
+    FEED_FORWARD(d, 3);
+    FEED_FORWARD(e, 4);
+}
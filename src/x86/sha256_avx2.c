@@ -0,0 +1,218 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/x86/sha256_avx2.c                     //
+// Description: 8-lane multi-buffer SHA-256 kernel (AVX2) //
+//                                                        //
+//********************************************************//
+
+#include <immintrin.h>
+#include "sharptwoth/internal.h"
+#include "transpose_avx2.h"
+
+//========================//
+// Vector Function Macros //
+//========================//
+
+// Each __m256i holds the same word from all eight lanes
+#define ADD(x, y)       _mm256_add_epi32((x), (y))
+#define XOR(x, y)       _mm256_xor_si256((x), (y))
+#define ROTR_V(x, r)    _mm256_or_si256(_mm256_srli_epi32((x), (r)), _mm256_slli_epi32((x), 32 - (r)))
+
+#define CH_V(x, y, z)   XOR(_mm256_and_si256((x), (y)), _mm256_andnot_si256((x), (z)))
+#define MAJ_V(x, y, z)  XOR(_mm256_and_si256((x), XOR((y), (z))), _mm256_and_si256((y), (z)))
+
+#define SIGMA0_V(x)     XOR(XOR(ROTR_V((x), 2), ROTR_V((x), 13)), ROTR_V((x), 22))
+#define SIGMA1_V(x)     XOR(XOR(ROTR_V((x), 6), ROTR_V((x), 11)), ROTR_V((x), 25))
+#define LSIGMA0_V(x)    XOR(XOR(ROTR_V((x), 7), ROTR_V((x), 18)), _mm256_srli_epi32((x), 3))
+#define LSIGMA1_V(x)    XOR(XOR(ROTR_V((x), 17), ROTR_V((x), 19)), _mm256_srli_epi32((x), 10))
+
+// Message-schedule ring, as in the scalar kernel
+#define W(t) w[(t) & 15]
+
+#define ROUND_V(a, b, c, d, e, f, g, h, t)                                  \
+    do                                                                      \
+    {                                                                       \
+        if ((t) >= 16)                                                      \
+            W(t) = ADD(ADD(W(t), LSIGMA1_V(W((t) - 2))),                    \
+                       ADD(W((t) - 7), LSIGMA0_V(W((t) - 15))));            \
+        tmp = ADD(ADD(ADD((h), SIGMA1_V((e))), ADD(CH_V((e), (f), (g)),     \
+                  _mm256_set1_epi32((int)SHA256_CONSTANTS[t]))), W(t));     \
+        (d) = ADD((d), tmp);                                                \
+        (h) = ADD(tmp, ADD(SIGMA0_V((a)), MAJ_V((a), (b), (c))));           \
+    } while (0)
+
+// Rounds over a precomputed schedule shared by all lanes (K[t] + W[t])
+#define SCHED_ROUND_V(a, b, c, d, e, f, g, h, t)                            \
+    do                                                                      \
+    {                                                                       \
+        tmp = ADD(ADD((h), SIGMA1_V((e))), ADD(CH_V((e), (f), (g)),         \
+                  _mm256_set1_epi32((int)schedule[t])));                    \
+        (d) = ADD((d), tmp);                                                \
+        (h) = ADD(tmp, ADD(SIGMA0_V((a)), MAJ_V((a), (b), (c))));           \
+    } while (0)
+
+// Rounds over eight 32-byte messages' blocks (schedule words 8..15 are padding;
+// see HALF_ROUND_256 in src/compute.c)
+#define HALF_TERM(s, x) (HALF_PADDING(s) ? _mm256_setzero_si256() : (x))
+#define HALF_PAD_V(t)   _mm256_set1_epi32((int)SHA256_HALF_PAD_WORDS[t])
+
+// Round constant, with the whole schedule word folded in where it is padding
+#define HALF_K(t)       (SHA256_CONSTANTS[t] + (HALF_PADDING(t) ? SHA256_HALF_PAD_WORDS[t] : 0))
+
+#define HALF_ROUND_V(a, b, c, d, e, f, g, h, t)                             \
+    do                                                                      \
+    {                                                                       \
+        if ((t) >= 16)                                                      \
+            W(t) = ADD(ADD(HALF_PAD_V(t),                                   \
+                           HALF_TERM((t) - 2, LSIGMA1_V(W((t) - 2)))),      \
+                       ADD(HALF_TERM((t) - 7, W((t) - 7)),                  \
+                           ADD(HALF_TERM((t) - 15, LSIGMA0_V(W((t) - 15))), \
+                               HALF_TERM((t) - 16, W((t) - 16)))));         \
+        tmp = ADD(ADD((h), SIGMA1_V((e))), ADD(CH_V((e), (f), (g)),         \
+                  _mm256_set1_epi32((int)HALF_K(t))));                      \
+        if (!HALF_PADDING(t))                                               \
+            tmp = ADD(tmp, W(t));                                           \
+        (d) = ADD((d), tmp);                                                \
+        (h) = ADD(tmp, ADD(SIGMA0_V((a)), MAJ_V((a), (b), (c))));           \
+    } while (0)
+
+#define ROUNDS8_V(ROUND, t)                            \
+    ROUND(a, b, c, d, e, f, g, h, (t));                \
+    ROUND(h, a, b, c, d, e, f, g, (t) + 1);            \
+    ROUND(g, h, a, b, c, d, e, f, (t) + 2);            \
+    ROUND(f, g, h, a, b, c, d, e, (t) + 3);            \
+    ROUND(e, f, g, h, a, b, c, d, (t) + 4);            \
+    ROUND(d, e, f, g, h, a, b, c, (t) + 5);            \
+    ROUND(c, d, e, f, g, h, a, b, (t) + 6);            \
+    ROUND(b, c, d, e, f, g, h, a, (t) + 7)
+
+// Adds a working variable back into its row of the transposed state
+#define FEED_FORWARD(x, i)                                          \
+    _mm256_storeu_si256((__m256i *)(state + (i) * MB_LANES),        \
+        ADD((x), _mm256_loadu_si256((const __m256i *)(state + (i) * MB_LANES))))
+
+//======================//
+// Multi-Buffer Kernels //
+//======================//
+
+void
+compress_256x8_avx2(
+    uint32_t * state,
+    const uint8_t * const * blocks
+)
+{
+    __m256i w[16];
+    __m256i a, b, c, d, e, f, g, h, tmp;
+
+    // Message words 0..7 and 8..15, one vector per word
+    load_transposed_32(w, blocks, 0);
+    load_transposed_32(w + 8, blocks, 32);
+
+    a = _mm256_loadu_si256((const __m256i *)(state + 0 * MB_LANES));
+    b = _mm256_loadu_si256((const __m256i *)(state + 1 * MB_LANES));
+    c = _mm256_loadu_si256((const __m256i *)(state + 2 * MB_LANES));
+    d = _mm256_loadu_si256((const __m256i *)(state + 3 * MB_LANES));
+    e = _mm256_loadu_si256((const __m256i *)(state + 4 * MB_LANES));
+    f = _mm256_loadu_si256((const __m256i *)(state + 5 * MB_LANES));
+    g = _mm256_loadu_si256((const __m256i *)(state + 6 * MB_LANES));
+    h = _mm256_loadu_si256((const __m256i *)(state + 7 * MB_LANES));
+
+    ROUNDS8_V(ROUND_V, 0);
+    ROUNDS8_V(ROUND_V, 8);
+    ROUNDS8_V(ROUND_V, 16);
+    ROUNDS8_V(ROUND_V, 24);
+    ROUNDS8_V(ROUND_V, 32);
+    ROUNDS8_V(ROUND_V, 40);
+    ROUNDS8_V(ROUND_V, 48);
+    ROUNDS8_V(ROUND_V, 56);
+
+    FEED_FORWARD(a, 0);
+    FEED_FORWARD(b, 1);
+    FEED_FORWARD(c, 2);
+    FEED_FORWARD(d, 3);
+    FEED_FORWARD(e, 4);
+    FEED_FORWARD(f, 5);
+    FEED_FORWARD(g, 6);
+    FEED_FORWARD(h, 7);
+}
+
+void
+compress_sched_256x8_avx2(
+    uint32_t * state,
+    const uint32_t * schedule
+)
+{
+    __m256i a, b, c, d, e, f, g, h, tmp;
+
+    a = _mm256_loadu_si256((const __m256i *)(state + 0 * MB_LANES));
+    b = _mm256_loadu_si256((const __m256i *)(state + 1 * MB_LANES));
+    c = _mm256_loadu_si256((const __m256i *)(state + 2 * MB_LANES));
+    d = _mm256_loadu_si256((const __m256i *)(state + 3 * MB_LANES));
+    e = _mm256_loadu_si256((const __m256i *)(state + 4 * MB_LANES));
+    f = _mm256_loadu_si256((const __m256i *)(state + 5 * MB_LANES));
+    g = _mm256_loadu_si256((const __m256i *)(state + 6 * MB_LANES));
+    h = _mm256_loadu_si256((const __m256i *)(state + 7 * MB_LANES));
+
+    ROUNDS8_V(SCHED_ROUND_V, 0);
+    ROUNDS8_V(SCHED_ROUND_V, 8);
+    ROUNDS8_V(SCHED_ROUND_V, 16);
+    ROUNDS8_V(SCHED_ROUND_V, 24);
+    ROUNDS8_V(SCHED_ROUND_V, 32);
+    ROUNDS8_V(SCHED_ROUND_V, 40);
+    ROUNDS8_V(SCHED_ROUND_V, 48);
+    ROUNDS8_V(SCHED_ROUND_V, 56);
+
+    FEED_FORWARD(a, 0);
+    FEED_FORWARD(b, 1);
+    FEED_FORWARD(c, 2);
+    FEED_FORWARD(d, 3);
+    FEED_FORWARD(e, 4);
+    FEED_FORWARD(f, 5);
+    FEED_FORWARD(g, 6);
+    FEED_FORWARD(h, 7);
+}
+
+void
+compress_half_256x8_avx2(
+    uint32_t * state,
+    const uint32_t * words
+)
+{
+    __m256i w[16];
+    __m256i a, b, c, d, e, f, g, h, tmp;
+
+    // Message words 0..7, already transposed (padding words are never loaded)
+    for (int t = 0; t < 8; ++t)
+        w[t] = _mm256_loadu_si256((const __m256i *)(words + t * MB_LANES));
+
+    a = _mm256_loadu_si256((const __m256i *)(state + 0 * MB_LANES));
+    b = _mm256_loadu_si256((const __m256i *)(state + 1 * MB_LANES));
+    c = _mm256_loadu_si256((const __m256i *)(state + 2 * MB_LANES));
+    d = _mm256_loadu_si256((const __m256i *)(state + 3 * MB_LANES));
+    e = _mm256_loadu_si256((const __m256i *)(state + 4 * MB_LANES));
+    f = _mm256_loadu_si256((const __m256i *)(state + 5 * MB_LANES));
+    g = _mm256_loadu_si256((const __m256i *)(state + 6 * MB_LANES));
+    h = _mm256_loadu_si256((const __m256i *)(state + 7 * MB_LANES));
+
+    ROUNDS8_V(HALF_ROUND_V, 0);
+    ROUNDS8_V(HALF_ROUND_V, 8);
+    ROUNDS8_V(HALF_ROUND_V, 16);
+    ROUNDS8_V(HALF_ROUND_V, 24);
+    ROUNDS8_V(HALF_ROUND_V, 32);
+    ROUNDS8_V(HALF_ROUND_V, 40);
+    ROUNDS8_V(HALF_ROUND_V, 48);
+    ROUNDS8_V(HALF_ROUND_V, 56);
+
+    FEED_FORWARD(a, 0);
+    FEED_FORWARD(b, 1);
+    FEED_FORWARD(c, 2);
+    FEED_FORWARD(d, 3);
+    FEED_FORWARD(e, 4);
+    FEED_FORWARD(f, 5);
+    FEED_FORWARD(g, 6);
+    FEED_FORWARD(h, 7);
+}
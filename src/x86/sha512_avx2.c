@@ -0,0 +1,143 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/x86/sha512_avx2.c                     //
+// Description: SHA-512 kernel with AVX2 message schedule //
+//                                                        //
+//********************************************************//
+
+#include <immintrin.h>
+#include "sharptwoth/internal.h"
+
+//========================//
+// Vector Function Macros //
+//========================//
+
+// Each __m256i holds four consecutive schedule words of one message
+#define ADD(x, y)       _mm256_add_epi64((x), (y))
+#define XOR(x, y)       _mm256_xor_si256((x), (y))
+#define ROTR_V(x, r)    _mm256_or_si256(_mm256_srli_epi64((x), (r)), _mm256_slli_epi64((x), 64 - (r)))
+
+#define LSIGMA0_V(x)    XOR(XOR(ROTR_V((x), 1), ROTR_V((x), 8)), _mm256_srli_epi64((x), 7))
+#define LSIGMA1_V(x)    XOR(XOR(ROTR_V((x), 19), ROTR_V((x), 61)), _mm256_srli_epi64((x), 6))
+
+// Words 1..4 of the eight-word window (lo, hi)
+#define WINDOW_1(lo, hi) \
+    _mm256_alignr_epi8(_mm256_permute2x128_si256((lo), (hi), 0x21), (lo), 8)
+
+// Schedules W[t..t+3] from the previous sixteen words held in w0..w3
+// (W[t + 2] and W[t + 3] depend on W[t] and W[t + 1], so sigma1 runs twice),
+// rotates the window, and stores W + K for the scalar rounds
+#define SCHEDULE4(w0, w1, w2, w3, t)                                        \
+    do                                                                      \
+    {                                                                       \
+        tmp = ADD(ADD((w0), LSIGMA0_V(WINDOW_1((w0), (w1)))),               \
+                  WINDOW_1((w2), (w3)));                                    \
+        tmp = ADD(tmp, _mm256_permute2x128_si256(                           \
+                  LSIGMA1_V((w3)), LSIGMA1_V((w3)), 0x81));                 \
+        tmp = ADD(tmp, _mm256_permute2x128_si256(                           \
+                  LSIGMA1_V(tmp), LSIGMA1_V(tmp), 0x08));                   \
+        (w0) = tmp;                                                         \
+        STORE_WK((w0), (t));                                                \
+    } while (0)
+
+#define STORE_WK(w, t)                                                      \
+    _mm256_storeu_si256((__m256i *)(wk + (t)),                              \
+        ADD((w), _mm256_loadu_si256((const __m256i *)(SHA512_CONSTANTS + (t)))))
+
+// Scalar round consuming a precomputed W + K
+#define ROUND_WK(a, b, c, d, e, f, g, h, t)                                 \
+    do                                                                      \
+    {                                                                       \
+        tmp1 = (h) + SIGMA1_512((e)) + CH((e), (f), (g)) + wk[t];           \
+        (d) += tmp1;                                                        \
+        (h) = tmp1 + SIGMA0_512((a)) + MAJ((a), (b), (c));                  \
+    } while (0)
+
+#define ROUNDS8_WK(t)                                  \
+    ROUND_WK(a, b, c, d, e, f, g, h, (t));             \
+    ROUND_WK(h, a, b, c, d, e, f, g, (t) + 1);         \
+    ROUND_WK(g, h, a, b, c, d, e, f, (t) + 2);         \
+    ROUND_WK(f, g, h, a, b, c, d, e, (t) + 3);         \
+    ROUND_WK(e, f, g, h, a, b, c, d, (t) + 4);         \
+    ROUND_WK(d, e, f, g, h, a, b, c, (t) + 5);         \
+    ROUND_WK(c, d, e, f, g, h, a, b, (t) + 6);         \
+    ROUND_WK(b, c, d, e, f, g, h, a, (t) + 7)
+
+//====================//
+// Compression Kernel //
+//====================//
+
+void
+compress_512_avx2(
+    uint64_t * hash_words,
+    const uint8_t * blocks,
+    const uint64_t block_count
+)
+{
+    // Byte-swaps each 64-bit element (big-endian message words)
+    const __m256i byte_mask = _mm256_set_epi64x(
+        INT64_C(0x08090a0b0c0d0e0f), INT64_C(0x0001020304050607),
+        INT64_C(0x08090a0b0c0d0e0f), INT64_C(0x0001020304050607));
+
+    uint64_t wk[80];
+    __m256i w0, w1, w2, w3, tmp;
+    uint64_t a, b, c, d, e, f, g, h, tmp1;
+
+    for (uint64_t i = 0; i < block_count; ++i, blocks += 128)
+    {
+        // Message-schedule preparation (W + K for all 80 rounds)
+        // t = 0..16 (64-bit words from message block)
+        w0 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(blocks + 0)), byte_mask);
+        w1 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(blocks + 32)), byte_mask);
+        w2 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(blocks + 64)), byte_mask);
+        w3 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(blocks + 96)), byte_mask);
+
+        STORE_WK(w0, 0);
+        STORE_WK(w1, 4);
+        STORE_WK(w2, 8);
+        STORE_WK(w3, 12);
+
+        // t = 16..80, four words at a time
+        for (int t = 16; t < 80; t += 16)
+        {
+            SCHEDULE4(w0, w1, w2, w3, t);
+            SCHEDULE4(w1, w2, w3, w0, t + 4);
+            SCHEDULE4(w2, w3, w0, w1, t + 8);
+            SCHEDULE4(w3, w0, w1, w2, t + 12);
+        }
+
+        // Hash calculations
+        a = hash_words[0];
+        b = hash_words[1];
+        c = hash_words[2];
+        d = hash_words[3];
+        e = hash_words[4];
+        f = hash_words[5];
+        g = hash_words[6];
+        h = hash_words[7];
+
+        ROUNDS8_WK(0);
+        ROUNDS8_WK(8);
+        ROUNDS8_WK(16);
+        ROUNDS8_WK(24);
+        ROUNDS8_WK(32);
+        ROUNDS8_WK(40);
+        ROUNDS8_WK(48);
+        ROUNDS8_WK(56);
+        ROUNDS8_WK(64);
+        ROUNDS8_WK(72);
+
+        hash_words[0] += a;
+        hash_words[1] += b;
+        hash_words[2] += c;
+        hash_words[3] += d;
+        hash_words[4] += e;
+        hash_words[5] += f;
+        hash_words[6] += g;
+        hash_words[7] += h;
+    }
+}
@@ -0,0 +1,212 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/x86/sha512_avx512.c                   //
+// Description: 8-lane SHA-512 family kernel (AVX-512)    //
+//                                                        //
+//********************************************************//
+
+#include <immintrin.h>
+#include "sharptwoth/internal.h"
+
+//========================//
+// Vector Function Macros //
+//========================//
+
+// Each __m512i holds the same word from all eight lanes
+// (vpternlogq truth tables: 0x96 = x ^ y ^ z, 0xca = CH, 0xe8 = MAJ)
+#define ADD(x, y)       _mm512_add_epi64((x), (y))
+#define XOR3(x, y, z)   _mm512_ternarylogic_epi64((x), (y), (z), 0x96)
+#define CH_V(x, y, z)   _mm512_ternarylogic_epi64((x), (y), (z), 0xca)
+#define MAJ_V(x, y, z)  _mm512_ternarylogic_epi64((x), (y), (z), 0xe8)
+
+#define SIGMA0_V(x)     XOR3(_mm512_ror_epi64((x), 28), _mm512_ror_epi64((x), 34), _mm512_ror_epi64((x), 39))
+#define SIGMA1_V(x)     XOR3(_mm512_ror_epi64((x), 14), _mm512_ror_epi64((x), 18), _mm512_ror_epi64((x), 41))
+#define LSIGMA0_V(x)    XOR3(_mm512_ror_epi64((x), 1), _mm512_ror_epi64((x), 8), _mm512_srli_epi64((x), 7))
+#define LSIGMA1_V(x)    XOR3(_mm512_ror_epi64((x), 19), _mm512_ror_epi64((x), 61), _mm512_srli_epi64((x), 6))
+
+// Message-schedule ring, as in the scalar kernel
+#define W(t) w[(t) & 15]
+
+#define ROUND_V(a, b, c, d, e, f, g, h, t)                                  \
+    do                                                                      \
+    {                                                                       \
+        if ((t) >= 16)                                                      \
+            W(t) = ADD(ADD(W(t), LSIGMA1_V(W((t) - 2))),                    \
+                       ADD(W((t) - 7), LSIGMA0_V(W((t) - 15))));            \
+        tmp = ADD(ADD(ADD((h), SIGMA1_V((e))), ADD(CH_V((e), (f), (g)),     \
+                  _mm512_set1_epi64((long long)SHA512_CONSTANTS[t]))), W(t)); \
+        (d) = ADD((d), tmp);                                                \
+        (h) = ADD(tmp, ADD(SIGMA0_V((a)), MAJ_V((a), (b), (c))));           \
+    } while (0)
+
+// Rounds over a precomputed schedule shared by all lanes (K[t] + W[t])
+#define SCHED_ROUND_V(a, b, c, d, e, f, g, h, t)                            \
+    do                                                                      \
+    {                                                                       \
+        tmp = ADD(ADD((h), SIGMA1_V((e))), ADD(CH_V((e), (f), (g)),         \
+                  _mm512_set1_epi64((long long)schedule[t])));              \
+        (d) = ADD((d), tmp);                                                \
+        (h) = ADD(tmp, ADD(SIGMA0_V((a)), MAJ_V((a), (b), (c))));           \
+    } while (0)
+
+#define ROUNDS8_V(ROUND, t)                            \
+    ROUND(a, b, c, d, e, f, g, h, (t));                \
+    ROUND(h, a, b, c, d, e, f, g, (t) + 1);            \
+    ROUND(g, h, a, b, c, d, e, f, (t) + 2);            \
+    ROUND(f, g, h, a, b, c, d, e, (t) + 3);            \
+    ROUND(e, f, g, h, a, b, c, d, (t) + 4);            \
+    ROUND(d, e, f, g, h, a, b, c, (t) + 5);            \
+    ROUND(c, d, e, f, g, h, a, b, (t) + 6);            \
+    ROUND(b, c, d, e, f, g, h, a, (t) + 7)
+
+// Adds a working variable back into its row of the transposed state
+#define FEED_FORWARD(x, i)                                          \
+    _mm512_storeu_si512((void *)(state + (i) * MB_LANES),           \
+        ADD((x), _mm512_loadu_si512((const void *)(state + (i) * MB_LANES))))
+
+//==================//
+// Static Functions //
+//==================//
+
+static void
+load_transposed(__m512i * w, const uint8_t * const * blocks, const int offset);
+
+//======================//
+// Multi-Buffer Kernels //
+//======================//
+
+void
+compress_512x8_avx512(
+    uint64_t * state,
+    const uint8_t * const * blocks
+)
+{
+    __m512i w[16];
+    __m512i a, b, c, d, e, f, g, h, tmp;
+
+    // Message words 0..7 and 8..15, one vector per word
+    load_transposed(w, blocks, 0);
+    load_transposed(w + 8, blocks, 64);
+
+    a = _mm512_loadu_si512((const void *)(state + 0 * MB_LANES));
+    b = _mm512_loadu_si512((const void *)(state + 1 * MB_LANES));
+    c = _mm512_loadu_si512((const void *)(state + 2 * MB_LANES));
+    d = _mm512_loadu_si512((const void *)(state + 3 * MB_LANES));
+    e = _mm512_loadu_si512((const void *)(state + 4 * MB_LANES));
+    f = _mm512_loadu_si512((const void *)(state + 5 * MB_LANES));
+    g = _mm512_loadu_si512((const void *)(state + 6 * MB_LANES));
+    h = _mm512_loadu_si512((const void *)(state + 7 * MB_LANES));
+
+    ROUNDS8_V(ROUND_V, 0);
+    ROUNDS8_V(ROUND_V, 8);
+    ROUNDS8_V(ROUND_V, 16);
+    ROUNDS8_V(ROUND_V, 24);
+    ROUNDS8_V(ROUND_V, 32);
+    ROUNDS8_V(ROUND_V, 40);
+    ROUNDS8_V(ROUND_V, 48);
+    ROUNDS8_V(ROUND_V, 56);
+    ROUNDS8_V(ROUND_V, 64);
+    ROUNDS8_V(ROUND_V, 72);
+
+    FEED_FORWARD(a, 0);
+    FEED_FORWARD(b, 1);
+    FEED_FORWARD(c, 2);
+    FEED_FORWARD(d, 3);
+    FEED_FORWARD(e, 4);
+    FEED_FORWARD(f, 5);
+    FEED_FORWARD(g, 6);
+    FEED_FORWARD(h, 7);
+}
+
+void
+compress_sched_512x8_avx512(
+    uint64_t * state,
+    const uint64_t * schedule
+)
+{
+    __m512i a, b, c, d, e, f, g, h, tmp;
+
+    a = _mm512_loadu_si512((const void *)(state + 0 * MB_LANES));
+    b = _mm512_loadu_si512((const void *)(state + 1 * MB_LANES));
+    c = _mm512_loadu_si512((const void *)(state + 2 * MB_LANES));
+    d = _mm512_loadu_si512((const void *)(state + 3 * MB_LANES));
+    e = _mm512_loadu_si512((const void *)(state + 4 * MB_LANES));
+    f = _mm512_loadu_si512((const void *)(state + 5 * MB_LANES));
+    g = _mm512_loadu_si512((const void *)(state + 6 * MB_LANES));
+    h = _mm512_loadu_si512((const void *)(state + 7 * MB_LANES));
+
+    ROUNDS8_V(SCHED_ROUND_V, 0);
+    ROUNDS8_V(SCHED_ROUND_V, 8);
+    ROUNDS8_V(SCHED_ROUND_V, 16);
+    ROUNDS8_V(SCHED_ROUND_V, 24);
+    ROUNDS8_V(SCHED_ROUND_V, 32);
+    ROUNDS8_V(SCHED_ROUND_V, 40);
+    ROUNDS8_V(SCHED_ROUND_V, 48);
+    ROUNDS8_V(SCHED_ROUND_V, 56);
+    ROUNDS8_V(SCHED_ROUND_V, 64);
+    ROUNDS8_V(SCHED_ROUND_V, 72);
+
+    FEED_FORWARD(a, 0);
+    FEED_FORWARD(b, 1);
+    FEED_FORWARD(c, 2);
+    FEED_FORWARD(d, 3);
+    FEED_FORWARD(e, 4);
+    FEED_FORWARD(f, 5);
+    FEED_FORWARD(g, 6);
+    FEED_FORWARD(h, 7);
+}
+
+//=============================//
+// Static-Function Definitions //
+//=============================//
+
+static void
+load_transposed(__m512i * w, const uint8_t * const * blocks, const int offset)
+{
+    // Byte-swaps each 64-bit element (big-endian message words)
+    const __m512i byte_mask = _mm512_set_epi64(
+        INT64_C(0x08090a0b0c0d0e0f), INT64_C(0x0001020304050607),
+        INT64_C(0x08090a0b0c0d0e0f), INT64_C(0x0001020304050607),
+        INT64_C(0x08090a0b0c0d0e0f), INT64_C(0x0001020304050607),
+        INT64_C(0x08090a0b0c0d0e0f), INT64_C(0x0001020304050607));
+
+    __m512i r[8], t[8], u[8];
+
+    // r[lane] = eight consecutive words of one lane's block
+    for (int lane = 0; lane < MB_LANES; ++lane)
+    {
+        r[lane] = _mm512_shuffle_epi8(
+            _mm512_loadu_si512((const void *)(blocks[lane] + offset)), byte_mask);
+    }
+
+    // 8x8 transpose of 64-bit elements
+    // t: pairs of lanes interleaved (even words in t[i], odd words in t[i + 1])
+    for (int i = 0; i < MB_LANES; i += 2)
+    {
+        t[i] = _mm512_unpacklo_epi64(r[i], r[i + 1]);
+        t[i + 1] = _mm512_unpackhi_epi64(r[i], r[i + 1]);
+    }
+
+    // u: four lanes per vector, two words each
+    // (u[0] = words 0/4, u[1] = 2/6, u[2] = 1/5, u[3] = 3/7; u[4..7] likewise for lanes 4..7)
+    for (int i = 0; i < MB_LANES; i += 4)
+    {
+        u[i] = _mm512_shuffle_i64x2(t[i], t[i + 2], 0x88);
+        u[i + 1] = _mm512_shuffle_i64x2(t[i], t[i + 2], 0xdd);
+        u[i + 2] = _mm512_shuffle_i64x2(t[i + 1], t[i + 3], 0x88);
+        u[i + 3] = _mm512_shuffle_i64x2(t[i + 1], t[i + 3], 0xdd);
+    }
+
+    w[0] = _mm512_shuffle_i64x2(u[0], u[4], 0x88);
+    w[4] = _mm512_shuffle_i64x2(u[0], u[4], 0xdd);
+    w[2] = _mm512_shuffle_i64x2(u[1], u[5], 0x88);
+    w[6] = _mm512_shuffle_i64x2(u[1], u[5], 0xdd);
+    w[1] = _mm512_shuffle_i64x2(u[2], u[6], 0x88);
+    w[5] = _mm512_shuffle_i64x2(u[2], u[6], 0xdd);
+    w[3] = _mm512_shuffle_i64x2(u[3], u[7], 0x88);
+    w[7] = _mm512_shuffle_i64x2(u[3], u[7], 0xdd);
+}
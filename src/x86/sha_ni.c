@@ -0,0 +1,291 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/x86/sha_ni.c                          //
+// Description: SHA-1/SHA-256 kernels (Intel SHA-NI)      //
+//                                                        //
+//********************************************************//
+
+#include <immintrin.h>
+#include "sharptwoth/internal.h"
+
+//==========================//
+// SHA-1 Quad-Round Helpers //
+//==========================//
+
+// Four rounds of SHA-1 on message vector m0, interleaved with the schedule
+// work for later quads (m1 = next, m2 = two back, m3 = previous)
+// e_in carries E + W for this quad, e_out captures ABCD for the next one
+#define QUAD_160(i, e_in, e_out, m0, m1, m2, m3)               \
+    do                                                         \
+    {                                                          \
+        if ((i) == 0)                                          \
+            e_in = _mm_add_epi32(e_in, m0);                    \
+        else                                                   \
+            e_in = _mm_sha1nexte_epu32(e_in, m0);              \
+        e_out = abcd;                                          \
+        if ((i) >= 3 && (i) <= 18)                             \
+            m1 = _mm_sha1msg2_epu32(m1, m0);                   \
+        abcd = _mm_sha1rnds4_epu32(abcd, e_in, (i) / 5);       \
+        if ((i) >= 1 && (i) <= 16)                             \
+            m3 = _mm_sha1msg1_epu32(m3, m0);                   \
+        if ((i) >= 2 && (i) <= 17)                             \
+            m2 = _mm_xor_si128(m2, m0);                        \
+    } while (0)
+
+//============================//
+// SHA-256 Quad-Round Helpers //
+//============================//
+
+// Four rounds of SHA-256 on message vector m0, interleaved with the schedule
+// work for later quads (m1 = next, m3 = previous)
+#define QUAD_256(i, m0, m1, m3)                                                 \
+    do                                                                          \
+    {                                                                           \
+        msg = _mm_add_epi32(m0,                                                 \
+            _mm_loadu_si128((const __m128i *)(SHA256_CONSTANTS + ((i) << 2)))); \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);                    \
+        if ((i) >= 3 && (i) <= 14)                                              \
+        {                                                                       \
+            tmp = _mm_alignr_epi8(m0, m3, 4);                                   \
+            m1 = _mm_add_epi32(m1, tmp);                                        \
+            m1 = _mm_sha256msg2_epu32(m1, m0);                                  \
+        }                                                                       \
+        msg = _mm_shuffle_epi32(msg, 0x0e);                                     \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);                    \
+        if ((i) >= 1 && (i) <= 12)                                              \
+            m3 = _mm_sha256msg1_epu32(m3, m0);                                  \
+    } while (0)
+
+// Four rounds of SHA-256 on a precomputed schedule (K + W) vector
+#define SCHED_QUAD_256(i)                                                       \
+    do                                                                          \
+    {                                                                           \
+        msg = _mm_loadu_si128((const __m128i *)(schedule + ((i) << 2)));        \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);                    \
+        msg = _mm_shuffle_epi32(msg, 0x0e);                                     \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, msg);                    \
+    } while (0)
+
+// load_state_256()
+// The rnds2 instruction wants the state split as ABEF/CDGH
+static inline void
+load_state_256(const uint32_t * hash_words, __m128i * abef, __m128i * cdgh)
+{
+    __m128i tmp = _mm_loadu_si128((const __m128i *)hash_words);
+    __m128i state1 = _mm_loadu_si128((const __m128i *)(hash_words + 4));
+
+    tmp = _mm_shuffle_epi32(tmp, 0xb1);
+    state1 = _mm_shuffle_epi32(state1, 0x1b);
+    *abef = _mm_alignr_epi8(tmp, state1, 8);
+    *cdgh = _mm_blend_epi16(state1, tmp, 0xf0);
+}
+
+// store_state_256()
+// Back from ABEF/CDGH to ABCD/EFGH
+static inline void
+store_state_256(uint32_t * hash_words, const __m128i abef, const __m128i cdgh)
+{
+    __m128i tmp = _mm_shuffle_epi32(abef, 0x1b);
+    __m128i state1 = _mm_shuffle_epi32(cdgh, 0xb1);
+
+    _mm_storeu_si128((__m128i *)hash_words, _mm_blend_epi16(tmp, state1, 0xf0));
+    _mm_storeu_si128((__m128i *)(hash_words + 4), _mm_alignr_epi8(state1, tmp, 8));
+}
+
+//============================//
+// SHA-NI Compression Kernels //
+//============================//
+
+void
+compress_160_shani(
+    uint32_t * hash_words,
+    const uint8_t * blocks,
+    const uint64_t block_count
+)
+{
+    // Byte-reverses the whole vector: big-endian words, W[0] in the top lane
+    const __m128i byte_mask = _mm_set_epi64x(
+        INT64_C(0x0001020304050607), INT64_C(0x08090a0b0c0d0e0f));
+
+    __m128i abcd, abcd_save, e0, e0_save, e1;
+    __m128i msg0, msg1, msg2, msg3;
+
+    abcd = _mm_loadu_si128((const __m128i *)hash_words);
+    abcd = _mm_shuffle_epi32(abcd, 0x1b);
+    e0 = _mm_set_epi32((int)hash_words[4], 0, 0, 0);
+
+    for (uint64_t i = 0; i < block_count; ++i, blocks += 64)
+    {
+        abcd_save = abcd;
+        e0_save = e0;
+
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 0)), byte_mask);
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 16)), byte_mask);
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 32)), byte_mask);
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 48)), byte_mask);
+
+        QUAD_160(0, e0, e1, msg0, msg1, msg2, msg3);
+        QUAD_160(1, e1, e0, msg1, msg2, msg3, msg0);
+        QUAD_160(2, e0, e1, msg2, msg3, msg0, msg1);
+        QUAD_160(3, e1, e0, msg3, msg0, msg1, msg2);
+        QUAD_160(4, e0, e1, msg0, msg1, msg2, msg3);
+        QUAD_160(5, e1, e0, msg1, msg2, msg3, msg0);
+        QUAD_160(6, e0, e1, msg2, msg3, msg0, msg1);
+        QUAD_160(7, e1, e0, msg3, msg0, msg1, msg2);
+        QUAD_160(8, e0, e1, msg0, msg1, msg2, msg3);
+        QUAD_160(9, e1, e0, msg1, msg2, msg3, msg0);
+        QUAD_160(10, e0, e1, msg2, msg3, msg0, msg1);
+        QUAD_160(11, e1, e0, msg3, msg0, msg1, msg2);
+        QUAD_160(12, e0, e1, msg0, msg1, msg2, msg3);
+        QUAD_160(13, e1, e0, msg1, msg2, msg3, msg0);
+        QUAD_160(14, e0, e1, msg2, msg3, msg0, msg1);
+        QUAD_160(15, e1, e0, msg3, msg0, msg1, msg2);
+        QUAD_160(16, e0, e1, msg0, msg1, msg2, msg3);
+        QUAD_160(17, e1, e0, msg1, msg2, msg3, msg0);
+        QUAD_160(18, e0, e1, msg2, msg3, msg0, msg1);
+        QUAD_160(19, e1, e0, msg3, msg0, msg1, msg2);
+
+        e0 = _mm_sha1nexte_epu32(e0, e0_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+
+    abcd = _mm_shuffle_epi32(abcd, 0x1b);
+    _mm_storeu_si128((__m128i *)hash_words, abcd);
+    hash_words[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+void
+compress_256_shani(
+    uint32_t * hash_words,
+    const uint8_t * blocks,
+    const uint64_t block_count
+)
+{
+    // Byte-swaps each 32-bit lane (big-endian message words)
+    const __m128i byte_mask = _mm_set_epi64x(
+        INT64_C(0x0c0d0e0f08090a0b), INT64_C(0x0405060700010203));
+
+    __m128i state0, state1, abef_save, cdgh_save;
+    __m128i msg, tmp, msg0, msg1, msg2, msg3;
+
+    load_state_256(hash_words, &state0, &state1);
+
+    for (uint64_t i = 0; i < block_count; ++i, blocks += 64)
+    {
+        abef_save = state0;
+        cdgh_save = state1;
+
+        msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 0)), byte_mask);
+        msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 16)), byte_mask);
+        msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 32)), byte_mask);
+        msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 48)), byte_mask);
+
+        QUAD_256(0, msg0, msg1, msg3);
+        QUAD_256(1, msg1, msg2, msg0);
+        QUAD_256(2, msg2, msg3, msg1);
+        QUAD_256(3, msg3, msg0, msg2);
+        QUAD_256(4, msg0, msg1, msg3);
+        QUAD_256(5, msg1, msg2, msg0);
+        QUAD_256(6, msg2, msg3, msg1);
+        QUAD_256(7, msg3, msg0, msg2);
+        QUAD_256(8, msg0, msg1, msg3);
+        QUAD_256(9, msg1, msg2, msg0);
+        QUAD_256(10, msg2, msg3, msg1);
+        QUAD_256(11, msg3, msg0, msg2);
+        QUAD_256(12, msg0, msg1, msg3);
+        QUAD_256(13, msg1, msg2, msg0);
+        QUAD_256(14, msg2, msg3, msg1);
+        QUAD_256(15, msg3, msg0, msg2);
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    store_state_256(hash_words, state0, state1);
+}
+
+//=========================================//
+// SHA-NI Fixed-Length Compression Kernels //
+//=========================================//
+
+void
+compress_sched_256_shani(
+    uint32_t * hash_words,
+    const uint32_t * schedule
+)
+{
+    __m128i state0, state1, abef_save, cdgh_save, msg;
+
+    load_state_256(hash_words, &state0, &state1);
+    abef_save = state0;
+    cdgh_save = state1;
+
+    // No message words to expand: only the rounds remain
+    SCHED_QUAD_256(0);
+    SCHED_QUAD_256(1);
+    SCHED_QUAD_256(2);
+    SCHED_QUAD_256(3);
+    SCHED_QUAD_256(4);
+    SCHED_QUAD_256(5);
+    SCHED_QUAD_256(6);
+    SCHED_QUAD_256(7);
+    SCHED_QUAD_256(8);
+    SCHED_QUAD_256(9);
+    SCHED_QUAD_256(10);
+    SCHED_QUAD_256(11);
+    SCHED_QUAD_256(12);
+    SCHED_QUAD_256(13);
+    SCHED_QUAD_256(14);
+    SCHED_QUAD_256(15);
+
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+
+    store_state_256(hash_words, state0, state1);
+}
+
+void
+compress_half_256_shani(
+    uint32_t * hash_words,
+    const uint32_t * words
+)
+{
+    __m128i state0, state1, abef_save, cdgh_save;
+    __m128i msg, tmp, msg0, msg1, msg2, msg3;
+
+    load_state_256(hash_words, &state0, &state1);
+    abef_save = state0;
+    cdgh_save = state1;
+
+    // Words already in host order, then the padding of a 32-byte message
+    msg0 = _mm_loadu_si128((const __m128i *)words);
+    msg1 = _mm_loadu_si128((const __m128i *)(words + 4));
+    msg2 = _mm_setr_epi32((int)0x80000000, 0, 0, 0);
+    msg3 = _mm_setr_epi32(0, 0, 0, 256);
+
+    QUAD_256(0, msg0, msg1, msg3);
+    QUAD_256(1, msg1, msg2, msg0);
+    QUAD_256(2, msg2, msg3, msg1);
+    QUAD_256(3, msg3, msg0, msg2);
+    QUAD_256(4, msg0, msg1, msg3);
+    QUAD_256(5, msg1, msg2, msg0);
+    QUAD_256(6, msg2, msg3, msg1);
+    QUAD_256(7, msg3, msg0, msg2);
+    QUAD_256(8, msg0, msg1, msg3);
+    QUAD_256(9, msg1, msg2, msg0);
+    QUAD_256(10, msg2, msg3, msg1);
+    QUAD_256(11, msg3, msg0, msg2);
+    QUAD_256(12, msg0, msg1, msg3);
+    QUAD_256(13, msg1, msg2, msg0);
+    QUAD_256(14, msg2, msg3, msg1);
+    QUAD_256(15, msg3, msg0, msg2);
+
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+
+    store_state_256(hash_words, state0, state1);
+}
@@ -0,0 +1,262 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/x86/sha_ssse3.c                       //
+// Description: SHA-1/SHA-256 kernels with SSSE3 schedule //
+//                                                        //
+//********************************************************//
+
+#include <immintrin.h>
+#include "sharptwoth/internal.h"
+
+//========================//
+// Vector Function Macros //
+//========================//
+
+// Each __m128i holds four consecutive schedule words of one message
+#define ADD(x, y)       _mm_add_epi32((x), (y))
+#define XOR(x, y)       _mm_xor_si128((x), (y))
+#define ROTL_V(x, r)    _mm_or_si128(_mm_slli_epi32((x), (r)), _mm_srli_epi32((x), 32 - (r)))
+#define ROTR_V(x, r)    _mm_or_si128(_mm_srli_epi32((x), (r)), _mm_slli_epi32((x), 32 - (r)))
+
+#define LSIGMA0_V(x)    XOR(XOR(ROTR_V((x), 7), ROTR_V((x), 18)), _mm_srli_epi32((x), 3))
+#define LSIGMA1_V(x)    XOR(XOR(ROTR_V((x), 17), ROTR_V((x), 19)), _mm_srli_epi32((x), 10))
+
+// Stores W + K for the scalar rounds
+#define STORE_WK(w, k, t) \
+    _mm_storeu_si128((__m128i *)(wk + (t)), ADD((w), (k)))
+
+//===========================//
+// SHA-1 W + K Round Helpers //
+//===========================//
+
+// Schedules W[t..t+3] from the previous sixteen words held in w0..w3
+// (W[t + 3] needs W[t], which is folded in afterwards as ROTL2 of lane 0)
+#define SCHEDULE4_160(w0, w1, w2, w3, k, t)                                 \
+    do                                                                      \
+    {                                                                       \
+        tmp = XOR(XOR((w0), _mm_alignr_epi8((w1), (w0), 8)),                \
+                  XOR((w2), _mm_srli_si128((w3), 4)));                      \
+        (w0) = XOR(ROTL_V(tmp, 1), ROTL_V(_mm_slli_si128(tmp, 12), 2));     \
+        STORE_WK((w0), (k), (t));                                           \
+    } while (0)
+
+#define ROUND_WK_160(a, b, c, d, e, f, t)                                   \
+    do                                                                      \
+    {                                                                       \
+        (e) += ROTL((a), 5) + f((b), (c), (d)) + wk[t];                     \
+        (b) = ROTL((b), 30);                                                \
+    } while (0)
+
+#define ROUNDS5_WK_160(f, t)                       \
+    ROUND_WK_160(a, b, c, d, e, f, (t));           \
+    ROUND_WK_160(e, a, b, c, d, f, (t) + 1);       \
+    ROUND_WK_160(d, e, a, b, c, f, (t) + 2);       \
+    ROUND_WK_160(c, d, e, a, b, f, (t) + 3);       \
+    ROUND_WK_160(b, c, d, e, a, f, (t) + 4)
+
+#define ROUNDS20_WK_160(f, t)                      \
+    ROUNDS5_WK_160(f, (t));                        \
+    ROUNDS5_WK_160(f, (t) + 5);                    \
+    ROUNDS5_WK_160(f, (t) + 10);                   \
+    ROUNDS5_WK_160(f, (t) + 15)
+
+//=============================//
+// SHA-256 W + K Round Helpers //
+//=============================//
+
+// Schedules W[t..t+3] from the previous sixteen words held in w0..w3
+// (W[t + 2] and W[t + 3] depend on W[t] and W[t + 1], so sigma1 runs twice)
+#define SCHEDULE4_256(w0, w1, w2, w3, t)                                    \
+    do                                                                      \
+    {                                                                       \
+        tmp = ADD(ADD((w0), LSIGMA0_V(_mm_alignr_epi8((w1), (w0), 4))),     \
+                  _mm_alignr_epi8((w3), (w2), 4));                          \
+        tmp = ADD(tmp, _mm_srli_si128(LSIGMA1_V((w3)), 8));                 \
+        (w0) = ADD(tmp, _mm_slli_si128(LSIGMA1_V(tmp), 8));                 \
+        STORE_WK((w0), _mm_loadu_si128(                                     \
+            (const __m128i *)(SHA256_CONSTANTS + (t))), (t));               \
+    } while (0)
+
+#define ROUND_WK_256(a, b, c, d, e, f, g, h, t)                             \
+    do                                                                      \
+    {                                                                       \
+        tmp1 = (h) + SIGMA1_256((e)) + CH((e), (f), (g)) + wk[t];           \
+        (d) += tmp1;                                                        \
+        (h) = tmp1 + SIGMA0_256((a)) + MAJ((a), (b), (c));                  \
+    } while (0)
+
+#define ROUNDS8_WK_256(t)                                  \
+    ROUND_WK_256(a, b, c, d, e, f, g, h, (t));             \
+    ROUND_WK_256(h, a, b, c, d, e, f, g, (t) + 1);         \
+    ROUND_WK_256(g, h, a, b, c, d, e, f, (t) + 2);         \
+    ROUND_WK_256(f, g, h, a, b, c, d, e, (t) + 3);         \
+    ROUND_WK_256(e, f, g, h, a, b, c, d, (t) + 4);         \
+    ROUND_WK_256(d, e, f, g, h, a, b, c, (t) + 5);         \
+    ROUND_WK_256(c, d, e, f, g, h, a, b, (t) + 6);         \
+    ROUND_WK_256(b, c, d, e, f, g, h, a, (t) + 7)
+
+//=====================//
+// Compression Kernels //
+//=====================//
+
+void
+compress_160_ssse3(
+    uint32_t * hash_words,
+    const uint8_t * blocks,
+    const uint64_t block_count
+)
+{
+    // Byte-swaps each 32-bit lane (big-endian message words)
+    const __m128i byte_mask = _mm_set_epi64x(
+        INT64_C(0x0c0d0e0f08090a0b), INT64_C(0x0405060700010203));
+
+    __m128i k[4];
+    uint32_t wk[80];
+    __m128i w0, w1, w2, w3, tmp;
+    uint32_t a, b, c, d, e;
+
+    for (int i = 0; i < 4; ++i)
+        k[i] = _mm_set1_epi32((int)SHA1_CONSTANTS[i]);
+
+    for (uint64_t i = 0; i < block_count; ++i, blocks += 64)
+    {
+        // Message-schedule preparation (W + K)
+        // t = 0..16 (32-bit words from message block)
+        w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 0)), byte_mask);
+        w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 16)), byte_mask);
+        w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 32)), byte_mask);
+        w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 48)), byte_mask);
+
+        STORE_WK(w0, k[0], 0);
+        STORE_WK(w1, k[0], 4);
+        STORE_WK(w2, k[0], 8);
+        STORE_WK(w3, k[0], 12);
+
+        SCHEDULE4_160(w0, w1, w2, w3, k[0], 16);
+
+        // Hash calculations
+        // t = 20..80 are scheduled four at a time between the rounds, each
+        // group staying well ahead of the round that consumes it
+        // (every group lies within one twenty-round stage, so it takes a single constant)
+        a = hash_words[0];
+        b = hash_words[1];
+        c = hash_words[2];
+        d = hash_words[3];
+        e = hash_words[4];
+
+        ROUNDS5_WK_160(CH, 0);
+        SCHEDULE4_160(w1, w2, w3, w0, k[1], 20);
+        ROUNDS5_WK_160(CH, 5);
+        SCHEDULE4_160(w2, w3, w0, w1, k[1], 24);
+        ROUNDS5_WK_160(CH, 10);
+        SCHEDULE4_160(w3, w0, w1, w2, k[1], 28);
+        ROUNDS5_WK_160(CH, 15);
+        SCHEDULE4_160(w0, w1, w2, w3, k[1], 32);
+        SCHEDULE4_160(w1, w2, w3, w0, k[1], 36);
+
+        ROUNDS5_WK_160(PARITY, 20);
+        SCHEDULE4_160(w2, w3, w0, w1, k[2], 40);
+        ROUNDS5_WK_160(PARITY, 25);
+        SCHEDULE4_160(w3, w0, w1, w2, k[2], 44);
+        ROUNDS5_WK_160(PARITY, 30);
+        SCHEDULE4_160(w0, w1, w2, w3, k[2], 48);
+        ROUNDS5_WK_160(PARITY, 35);
+        SCHEDULE4_160(w1, w2, w3, w0, k[2], 52);
+        SCHEDULE4_160(w2, w3, w0, w1, k[2], 56);
+
+        ROUNDS5_WK_160(MAJ, 40);
+        SCHEDULE4_160(w3, w0, w1, w2, k[3], 60);
+        ROUNDS5_WK_160(MAJ, 45);
+        SCHEDULE4_160(w0, w1, w2, w3, k[3], 64);
+        ROUNDS5_WK_160(MAJ, 50);
+        SCHEDULE4_160(w1, w2, w3, w0, k[3], 68);
+        ROUNDS5_WK_160(MAJ, 55);
+        SCHEDULE4_160(w2, w3, w0, w1, k[3], 72);
+        SCHEDULE4_160(w3, w0, w1, w2, k[3], 76);
+
+        ROUNDS20_WK_160(PARITY, 60);
+
+        hash_words[0] += a;
+        hash_words[1] += b;
+        hash_words[2] += c;
+        hash_words[3] += d;
+        hash_words[4] += e;
+    }
+}
+
+void
+compress_256_ssse3(
+    uint32_t * hash_words,
+    const uint8_t * blocks,
+    const uint64_t block_count
+)
+{
+    // Byte-swaps each 32-bit lane (big-endian message words)
+    const __m128i byte_mask = _mm_set_epi64x(
+        INT64_C(0x0c0d0e0f08090a0b), INT64_C(0x0405060700010203));
+
+    uint32_t wk[64];
+    __m128i w0, w1, w2, w3, tmp;
+    uint32_t a, b, c, d, e, f, g, h, tmp1;
+
+    for (uint64_t i = 0; i < block_count; ++i, blocks += 64)
+    {
+        // Message-schedule preparation (W + K)
+        // t = 0..16 (32-bit words from message block)
+        w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 0)), byte_mask);
+        w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 16)), byte_mask);
+        w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 32)), byte_mask);
+        w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 48)), byte_mask);
+
+        STORE_WK(w0, _mm_loadu_si128((const __m128i *)(SHA256_CONSTANTS + 0)), 0);
+        STORE_WK(w1, _mm_loadu_si128((const __m128i *)(SHA256_CONSTANTS + 4)), 4);
+        STORE_WK(w2, _mm_loadu_si128((const __m128i *)(SHA256_CONSTANTS + 8)), 8);
+        STORE_WK(w3, _mm_loadu_si128((const __m128i *)(SHA256_CONSTANTS + 12)), 12);
+
+        // Hash calculations
+        // t = 16..64 are scheduled four at a time between the rounds, each
+        // group staying at least eight rounds ahead of its consumer
+        a = hash_words[0];
+        b = hash_words[1];
+        c = hash_words[2];
+        d = hash_words[3];
+        e = hash_words[4];
+        f = hash_words[5];
+        g = hash_words[6];
+        h = hash_words[7];
+
+        ROUNDS8_WK_256(0);
+        SCHEDULE4_256(w0, w1, w2, w3, 16);
+        SCHEDULE4_256(w1, w2, w3, w0, 20);
+        ROUNDS8_WK_256(8);
+        SCHEDULE4_256(w2, w3, w0, w1, 24);
+        SCHEDULE4_256(w3, w0, w1, w2, 28);
+        ROUNDS8_WK_256(16);
+        SCHEDULE4_256(w0, w1, w2, w3, 32);
+        SCHEDULE4_256(w1, w2, w3, w0, 36);
+        ROUNDS8_WK_256(24);
+        SCHEDULE4_256(w2, w3, w0, w1, 40);
+        SCHEDULE4_256(w3, w0, w1, w2, 44);
+        ROUNDS8_WK_256(32);
+        SCHEDULE4_256(w0, w1, w2, w3, 48);
+        SCHEDULE4_256(w1, w2, w3, w0, 52);
+        ROUNDS8_WK_256(40);
+        SCHEDULE4_256(w2, w3, w0, w1, 56);
+        SCHEDULE4_256(w3, w0, w1, w2, 60);
+        ROUNDS8_WK_256(48);
+        ROUNDS8_WK_256(56);
+
+        hash_words[0] += a;
+        hash_words[1] += b;
+        hash_words[2] += c;
+        hash_words[3] += d;
+        hash_words[4] += e;
+        hash_words[5] += f;
+        hash_words[6] += g;
+        hash_words[7] += h;
+    }
+}
@@ -0,0 +1,60 @@
+//********************************************************//
+//                                                        //
+// libsharptwoth                                               //
+//                                                        //
+// Repository:  https://github.com/croqueue/sharptwoth          //
+// Author:      Danielle Thompson, Ph.D (2022)              //
+// File:        src/x86/transpose_avx2.h                  //
+// Description: Transposed block loads for AVX2 kernels   //
+//                                                        //
+//********************************************************//
+
+#ifndef SHARP2TH_TRANSPOSE_AVX2_H
+#define SHARP2TH_TRANSPOSE_AVX2_H
+
+#include <immintrin.h>
+#include "sharptwoth/internal.h"
+
+// load_transposed_32()
+// Loads eight big-endian 32-bit words at offset from each lane's block
+// into w[0..7], one vector per word with lane l in element l
+static inline void
+load_transposed_32(__m256i * w, const uint8_t * const * blocks, const int offset)
+{
+    // Byte-swaps each 32-bit element (big-endian message words)
+    const __m256i byte_mask = _mm256_set_epi8(
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+    __m256i r[8], t[8], u[8];
+
+    // r[lane] = eight consecutive words of one lane's block
+    for (int lane = 0; lane < MB_LANES; ++lane)
+    {
+        r[lane] = _mm256_shuffle_epi8(
+            _mm256_loadu_si256((const __m256i *)(blocks[lane] + offset)), byte_mask);
+    }
+
+    // 8x8 transpose of 32-bit elements: 2x2 blocks, then 4x4, then 128-bit halves
+    for (int i = 0; i < MB_LANES; i += 2)
+    {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+
+    for (int i = 0; i < MB_LANES; i += 4)
+    {
+        u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        w[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+        w[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+    }
+}
+
+#endif // SHARP2TH_TRANSPOSE_AVX2_H
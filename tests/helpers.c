@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/uio.h>
 #include "sharptwoth/tests/helpers.h"
 
 static const char * MESSAGE_PATHS = "./data/message%d.txt";
@@ -14,6 +15,57 @@ static const char * HASH_MISMATCH =
     "---EXPECTED: %s\n"
     "---COMPUTED: %s\n\n";
 
+static const char * KERNEL_MISMATCH = 
+    "Compression kernel disagrees with reference after %d block(s)\n";
+
+static const char * LANE_MISMATCH = 
+    "Multi-buffer kernel lane %d disagrees with reference after %d block(s)\n";
+
+static const char * ENGINE_MISMATCH = 
+    "Multi-buffer engine result for job %d (%llu bytes) disagrees with reference\n";
+
+static const char * BATCH_MISMATCH = 
+    "Batch digest %d (%llu bytes, format %d) does not match one-shot digest\n";
+
+static const char * BACKEND_MISMATCH = 
+    "Digests computed under backend %d do not match the portable kernels\n";
+
+static const char * TUNING_MISMATCH = 
+    "Digests computed under the autotuned kernels do not match the portable kernels\n";
+
+static const char * PEEK_MISMATCH = 
+    "Peeked digest after %llu bytes does not match one-shot digest of the prefix\n";
+
+static const char * STATE_ACCEPTED = 
+    "Import accepted a corrupted exported context (case %d)\n";
+
+static const char * SUFFIX_MISMATCH = 
+    "Digest of suffix %d (%llu bytes) after a %llu-byte prefix does not match streaming digest%s\n";
+
+static const char * STATUS_MISMATCH = 
+    "Generic batch message %d (%llu bytes): status %d, expected %d\n";
+
+static const char * JOB_MISMATCH = 
+    "Stepped job (%llu bytes, %llu blocks per step) does not match one-shot digest%s\n";
+
+static const char * VERIFY_FAILED = 
+    "Verification of file '%s' failed (raw %d, lowercase hex %d, uppercase hex %d)\n";
+
+static const char * MULTI_MISMATCH = 
+    "Single-pass %s digest (%llu bytes, set %d, backend %d) does not match one-shot digest\n";
+
+static const char * MANAGER_MISMATCH = 
+    "Managed stream %d (%llu bytes, backend %d) does not match one-shot digest\n";
+
+static const char * ENCODING_MISMATCH = 
+    "%s encoding of %d bytes failed (%s)\n";
+
+static const char * SHORT_MISMATCH = 
+    "%s %s digest of %d bytes (backend %d) does not match streaming digest\n";
+
+static const char * DOUBLE_MISMATCH = 
+    "SHA-256d %s of %llu bytes (backend %d) does not match SHA-256 of the SHA-256 digest\n";
+
 static const char * ALGORITHM_STRINGS[7] =
 {
     "sha1",
@@ -25,12 +77,154 @@ static const char * ALGORITHM_STRINGS[7] =
     "sha512_256"
 };
 
+static const uint8_t DIGEST_LENS[7] =
+{
+    SHA1_DIGEST_LEN, SHA224_DIGEST_LEN, SHA256_DIGEST_LEN, SHA384_DIGEST_LEN,
+    SHA512_DIGEST_LEN, SHA512_224_DIGEST_LEN, SHA512_256_DIGEST_LEN
+};
+
+static const size_t STATE_LENS[7] =
+{
+    SHA1_STATE_LEN, SHA224_STATE_LEN, SHA256_STATE_LEN, SHA384_STATE_LEN,
+    SHA512_STATE_LEN, SHA512_224_STATE_LEN, SHA512_256_STATE_LEN
+};
+
+// Any streaming context, for helpers that handle every algorithm
+typedef union any_ctx
+{
+    sha1_ctx sha1;
+    sha256_ctx sha256;
+    sha512_ctx sha512;
+
+} any_ctx;
+
 static void
 hex_to_bytes(uint8_t * dest, const char * hex, uint8_t byte_count);
 
 static bool
 sequence_equal(const uint8_t * a, const uint8_t * b, const uint8_t len);
 
+static uint64_t
+next_random(uint64_t * state);
+
+static void
+digest_all_algorithms(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens
+);
+
+static bool
+scalar_reference(const uint8_t ** messages, uint64_t * message_lens);
+
+static bool
+matches_reference(const uint8_t * const * messages, const uint64_t * message_lens);
+
+static size_t
+reference_encode(char * encoded, const uint8_t * raw, const size_t raw_len, const ShaDigestFormat format);
+
+static ShaComputationResult
+stream_hash(
+    ShaType algorithm,
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+static ShaComputationResult
+scatter_hash(
+    iov_hasher_t hash_function,
+    ShaType algorithm,
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+static ShaComputationResult
+copy_hash(
+    copy_hasher_t hash_function,
+    ShaType algorithm,
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+static ShaComputationResult
+verify_hash(
+    verifier_t verify_function,
+    ShaType algorithm,
+    const uint8_t * expected,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+static ShaComputationResult
+checkpoint_hash(
+    ShaType algorithm,
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+);
+
+static ShaComputationResult
+context_init(ShaType algorithm, any_ctx * ctx);
+
+static ShaComputationResult
+context_update(ShaType algorithm, any_ctx * ctx, const uint8_t * message, const uint64_t message_len);
+
+static ShaComputationResult
+context_update_copy(
+    ShaType algorithm,
+    any_ctx * ctx,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+);
+
+static ShaComputationResult
+context_final(ShaType algorithm, any_ctx * ctx, uint8_t * digest, const ShaDigestFormat format);
+
+static ShaComputationResult
+context_final_verify(ShaType algorithm, any_ctx * ctx, const uint8_t * expected, const ShaDigestFormat format);
+
+static ShaComputationResult
+context_peek(ShaType algorithm, const any_ctx * ctx, uint8_t * digest, const ShaDigestFormat format);
+
+static ShaComputationResult
+context_export(ShaType algorithm, const any_ctx * ctx, uint8_t * state);
+
+static ShaComputationResult
+context_import(ShaType algorithm, any_ctx * ctx, const uint8_t * state, const size_t state_len);
+
+static ShaComputationResult
+context_suffix(
+    ShaType algorithm,
+    const any_ctx * ctx,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+);
+
+static ShaComputationResult
+context_suffix_batch(
+    ShaType algorithm,
+    const any_ctx * ctx,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+);
+
+static bool
+rejects_corrupted_state(ShaType algorithm, const uint8_t * state, const size_t state_len);
+
 TestContext * 
 TestContext_Init(
     const int test_message_number,
@@ -208,77 +402,2229 @@ TestContext_RunGeneric(TestContext * context, ShaType algorithm)
     }
 }
 
-void
-TestContext_Free(TestContext * context)
-{
-    free(context->file_contents);
-    free(context);
-}
-
 bool
-load_expected_digests(char hashes[NUM_TESTS][HEX_DIGEST_BUFFER_LEN], ShaType algorithm)
+TestContext_RunStreaming(TestContext * context, ShaType algorithm)
 {
-    char file_path[30] = { '\0' };
-    sprintf(file_path, HASH_PATHS, ALGORITHM_STRINGS[algorithm]);
+    if (!context)
+        return false;
 
-    FILE * file_handle = fopen(file_path, "r");
+    context->results[0] = stream_hash(
+        algorithm,
+        context->actual_hashes.raw, 
+        context->file_contents, 
+        context->file_size, 
+        OCTET_ARRAY
+    );
+    
+    context->results[1] = stream_hash(
+        algorithm,
+        context->actual_hashes.hex_lower,
+        context->file_contents,
+        context->file_size,
+        HEX_STRING_LOWER
+    );
 
-    if (!file_handle)
+    context->results[2] = stream_hash(
+        algorithm,
+        context->actual_hashes.hex_upper,
+        context->file_contents,
+        context->file_size,
+        HEX_STRING_UPPER
+    );
+
+    context->match[0] = sequence_equal(
+        context->expected_hashes.raw, 
+        context->actual_hashes.raw, 
+        context->expected_hashes.digest_len
+    );
+
+    context->match[1] = !strcmp(
+        context->expected_hashes.hex_lower, 
+        context->actual_hashes.hex_lower
+    );
+
+    context->match[2] = !strcmp(
+        context->expected_hashes.hex_upper, 
+        context->actual_hashes.hex_upper
+    );
+
+    if (context->match[0] && context->match[1] && context->match[2])
     {
-        printf(DIGEST_READ_FAIL, file_path);
+        return true;
+    }
+    else
+    {
+        printf(HASH_MISMATCH, 
+            context->file_path, 
+            context->expected_hashes.hex_lower, 
+            context->actual_hashes.hex_lower);
+        
         return false;
     }
+}
+
+bool
+TestContext_RunScatterGather(TestContext * context, iov_hasher_t hash_function, ShaType algorithm)
+{
+    if (!context || !hash_function)
+        return false;
+
+    context->results[0] = scatter_hash(
+        hash_function,
+        algorithm,
+        context->actual_hashes.raw, 
+        context->file_contents, 
+        context->file_size, 
+        OCTET_ARRAY
+    );
     
-    memset(hashes, '\0', NUM_TESTS * HEX_DIGEST_BUFFER_LEN);
-    
-    int c;
+    context->results[1] = scatter_hash(
+        hash_function,
+        algorithm,
+        context->actual_hashes.hex_lower,
+        context->file_contents,
+        context->file_size,
+        HEX_STRING_LOWER
+    );
 
-    for (int i = 0; i < NUM_TESTS; ++i)
-    {
-        int j = 0;
+    context->results[2] = scatter_hash(
+        hash_function,
+        algorithm,
+        context->actual_hashes.hex_upper,
+        context->file_contents,
+        context->file_size,
+        HEX_STRING_UPPER
+    );
 
-        while ((c = fgetc(file_handle)) != EOF)
-        {
-            if (c == '\n')
-                break;
+    context->match[0] = context->results[0] == HASH_COMPUTED && sequence_equal(
+        context->expected_hashes.raw, 
+        context->actual_hashes.raw, 
+        context->expected_hashes.digest_len
+    );
 
-            hashes[i][j++] = (char)c;
-        }
-    }
+    context->match[1] = context->results[1] == HASH_COMPUTED && !strcmp(
+        context->expected_hashes.hex_lower, 
+        context->actual_hashes.hex_lower
+    );
 
-    fclose(file_handle);
-    return true;
+    context->match[2] = context->results[2] == HASH_COMPUTED && !strcmp(
+        context->expected_hashes.hex_upper, 
+        context->actual_hashes.hex_upper
+    );
+
+    if (context->match[0] && context->match[1] && context->match[2])
+    {
+        return true;
+    }
+    else
+    {
+        printf(HASH_MISMATCH, 
+            context->file_path, 
+            context->expected_hashes.hex_lower, 
+            context->actual_hashes.hex_lower);
+        
+        return false;
+    }
 }
 
-static void
-hex_to_bytes(uint8_t * dest, const char * hex, uint8_t byte_count)
+bool
+TestContext_RunCopy(TestContext * context, copy_hasher_t hash_function, ShaType algorithm)
 {
-    char c;
-    uint8_t byte;
+    if (!context || !hash_function)
+        return false;
 
-    for (uint8_t i = 0; i < byte_count; ++i)
-    {
-        byte = 0x00;
+    context->results[0] = copy_hash(
+        hash_function,
+        algorithm,
+        context->actual_hashes.raw, 
+        context->file_contents, 
+        context->file_size, 
+        OCTET_ARRAY
+    );
+    
+    context->results[1] = copy_hash(
+        hash_function,
+        algorithm,
+        context->actual_hashes.hex_lower,
+        context->file_contents,
+        context->file_size,
+        HEX_STRING_LOWER
+    );
 
-        for (uint8_t j = 0; j < 2; ++j)
-        {
-            byte *= 16;
-            c = tolower(*hex++);
-            byte += c - (c <= '9' ? '0': 'a' - 10);
-        }
+    context->results[2] = copy_hash(
+        hash_function,
+        algorithm,
+        context->actual_hashes.hex_upper,
+        context->file_contents,
+        context->file_size,
+        HEX_STRING_UPPER
+    );
 
-        dest[i] = byte;
+    context->match[0] = context->results[0] == HASH_COMPUTED && sequence_equal(
+        context->expected_hashes.raw, 
+        context->actual_hashes.raw, 
+        context->expected_hashes.digest_len
+    );
+
+    context->match[1] = context->results[1] == HASH_COMPUTED && !strcmp(
+        context->expected_hashes.hex_lower, 
+        context->actual_hashes.hex_lower
+    );
+
+    context->match[2] = context->results[2] == HASH_COMPUTED && !strcmp(
+        context->expected_hashes.hex_upper, 
+        context->actual_hashes.hex_upper
+    );
+
+    if (context->match[0] && context->match[1] && context->match[2])
+    {
+        return true;
+    }
+    else
+    {
+        printf(HASH_MISMATCH, 
+            context->file_path, 
+            context->expected_hashes.hex_lower, 
+            context->actual_hashes.hex_lower);
+        
+        return false;
     }
 }
 
-static bool
-sequence_equal(const uint8_t * a, const uint8_t * b, const uint8_t len)
+bool
+TestContext_RunVerify(TestContext * context, verifier_t verify_function, ShaType algorithm)
 {
-    for (uint8_t i = 0; i < len; ++i)
-    {
-        if (a[i] != b[i])
-            return false;
-    }
+    if (!context || !verify_function)
+        return false;
 
-    return true;
+    context->results[0] = verify_hash(
+        verify_function,
+        algorithm,
+        context->expected_hashes.raw,
+        (const uint8_t *)context->file_contents,
+        context->file_size,
+        OCTET_ARRAY
+    );
+
+    context->results[1] = verify_hash(
+        verify_function,
+        algorithm,
+        (const uint8_t *)context->expected_hashes.hex_lower,
+        (const uint8_t *)context->file_contents,
+        context->file_size,
+        HEX_STRING_LOWER
+    );
+
+    context->results[2] = verify_hash(
+        verify_function,
+        algorithm,
+        (const uint8_t *)context->expected_hashes.hex_upper,
+        (const uint8_t *)context->file_contents,
+        context->file_size,
+        HEX_STRING_UPPER
+    );
+
+    for (int i = 0; i < 3; ++i)
+        context->match[i] = context->results[i] == HASH_COMPUTED;
+
+    if (context->match[0] && context->match[1] && context->match[2])
+    {
+        return true;
+    }
+    else
+    {
+        printf(VERIFY_FAILED, 
+            context->file_path, 
+            context->results[0], 
+            context->results[1], 
+            context->results[2]);
+        
+        return false;
+    }
+}
+
+bool
+TestContext_RunCheckpointed(TestContext * context, ShaType algorithm)
+{
+    if (!context)
+        return false;
+
+    context->results[0] = checkpoint_hash(
+        algorithm,
+        context->actual_hashes.raw, 
+        context->file_contents, 
+        context->file_size, 
+        OCTET_ARRAY
+    );
+    
+    context->results[1] = checkpoint_hash(
+        algorithm,
+        context->actual_hashes.hex_lower,
+        context->file_contents,
+        context->file_size,
+        HEX_STRING_LOWER
+    );
+
+    context->results[2] = checkpoint_hash(
+        algorithm,
+        context->actual_hashes.hex_upper,
+        context->file_contents,
+        context->file_size,
+        HEX_STRING_UPPER
+    );
+
+    context->match[0] = context->results[0] == HASH_COMPUTED && sequence_equal(
+        context->expected_hashes.raw, 
+        context->actual_hashes.raw, 
+        context->expected_hashes.digest_len
+    );
+
+    context->match[1] = context->results[1] == HASH_COMPUTED && !strcmp(
+        context->expected_hashes.hex_lower, 
+        context->actual_hashes.hex_lower
+    );
+
+    context->match[2] = context->results[2] == HASH_COMPUTED && !strcmp(
+        context->expected_hashes.hex_upper, 
+        context->actual_hashes.hex_upper
+    );
+
+    if (context->match[0] && context->match[1] && context->match[2])
+    {
+        return true;
+    }
+    else
+    {
+        printf(HASH_MISMATCH, 
+            context->file_path, 
+            context->expected_hashes.hex_lower, 
+            context->actual_hashes.hex_lower);
+        
+        return false;
+    }
+}
+
+void
+TestContext_Free(TestContext * context)
+{
+    free(context->file_contents);
+    free(context);
+}
+
+bool
+load_expected_digests(char hashes[NUM_TESTS][HEX_DIGEST_BUFFER_LEN], ShaType algorithm)
+{
+    char file_path[30] = { '\0' };
+    sprintf(file_path, HASH_PATHS, ALGORITHM_STRINGS[algorithm]);
+
+    FILE * file_handle = fopen(file_path, "r");
+
+    if (!file_handle)
+    {
+        printf(DIGEST_READ_FAIL, file_path);
+        return false;
+    }
+    
+    memset(hashes, '\0', NUM_TESTS * HEX_DIGEST_BUFFER_LEN);
+    
+    int c;
+
+    for (int i = 0; i < NUM_TESTS; ++i)
+    {
+        int j = 0;
+
+        while ((c = fgetc(file_handle)) != EOF)
+        {
+            if (c == '\n')
+                break;
+
+            hashes[i][j++] = (char)c;
+        }
+    }
+
+    fclose(file_handle);
+    return true;
+}
+
+bool
+kernels_match_32(
+    compressor_32_t reference,
+    compressor_32_t candidate,
+    const uint8_t word_count
+)
+{
+    static uint8_t blocks[KERNEL_TEST_BLOCKS * 64];
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    uint32_t expected[8], actual[8];
+
+    for (int i = 0; i < KERNEL_TEST_BLOCKS * 64; ++i)
+        blocks[i] = (uint8_t)next_random(&seed);
+
+    for (int n = 0; n <= KERNEL_TEST_BLOCKS; ++n)
+    {
+        for (uint8_t w = 0; w < word_count; ++w)
+            expected[w] = actual[w] = (uint32_t)next_random(&seed);
+
+        reference(expected, blocks, n);
+        candidate(actual, blocks, n);
+
+        if (memcmp(expected, actual, word_count * sizeof(uint32_t)))
+        {
+            printf(KERNEL_MISMATCH, n);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+kernels_match_64(
+    compressor_64_t reference,
+    compressor_64_t candidate
+)
+{
+    static uint8_t blocks[KERNEL_TEST_BLOCKS * 128];
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    uint64_t expected[8], actual[8];
+
+    for (int i = 0; i < KERNEL_TEST_BLOCKS * 128; ++i)
+        blocks[i] = (uint8_t)next_random(&seed);
+
+    for (int n = 0; n <= KERNEL_TEST_BLOCKS; ++n)
+    {
+        for (uint8_t w = 0; w < 8; ++w)
+            expected[w] = actual[w] = next_random(&seed);
+
+        reference(expected, blocks, n);
+        candidate(actual, blocks, n);
+
+        if (memcmp(expected, actual, sizeof(expected)))
+        {
+            printf(KERNEL_MISMATCH, n);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+mb_kernel_matches_32(
+    compressor_32_t reference,
+    mb_compressor_32_t candidate,
+    const uint8_t word_count
+)
+{
+    static uint8_t blocks[MB_LANES][KERNEL_TEST_BLOCKS * 64];
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    uint32_t expected[MB_LANES][8], state[8 * MB_LANES];
+    const uint8_t * lane_blocks[MB_LANES];
+
+    for (int l = 0; l < MB_LANES; ++l)
+    {
+        for (int i = 0; i < KERNEL_TEST_BLOCKS * 64; ++i)
+            blocks[l][i] = (uint8_t)next_random(&seed);
+
+        for (uint8_t w = 0; w < word_count; ++w)
+            expected[l][w] = state[w * MB_LANES + l] = (uint32_t)next_random(&seed);
+    }
+
+    for (int n = 0; n < KERNEL_TEST_BLOCKS; ++n)
+    {
+        for (int l = 0; l < MB_LANES; ++l)
+        {
+            lane_blocks[l] = blocks[l] + n * 64;
+            reference(expected[l], lane_blocks[l], 1);
+        }
+
+        candidate(state, lane_blocks);
+
+        for (int l = 0; l < MB_LANES; ++l)
+        {
+            for (uint8_t w = 0; w < word_count; ++w)
+            {
+                if (expected[l][w] != state[w * MB_LANES + l])
+                {
+                    printf(LANE_MISMATCH, l, n + 1);
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool
+mb_engine_matches_32(
+    compressor_32_t reference,
+    mb_compressor_32_t candidate,
+    const uint8_t word_count
+)
+{
+    static uint8_t data[8192];
+    static uint32_t expected[BATCH_TEST_MESSAGES][8], actual[BATCH_TEST_MESSAGES][8];
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    mb_job jobs[BATCH_TEST_MESSAGES];
+    uint8_t tail[128], tail_blocks;
+    uint64_t len, full;
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    for (int i = 0; i < BATCH_TEST_MESSAGES; ++i)
+    {
+        len = (i % 10 == 7) ? 4000 + i : (uint64_t)((i * 37) % 300);
+
+        for (uint8_t w = 0; w < word_count; ++w)
+            expected[i][w] = actual[i][w] = (uint32_t)next_random(&seed);
+
+        jobs[i].message = data + i;
+        jobs[i].message_len = len;
+        jobs[i].hash_words = actual[i];
+        jobs[i].absorbed_len = 0;
+        jobs[i].prefix = NULL;
+        jobs[i].prefix_len = 0;
+        jobs[i].unpadded = 0;
+
+        // Reference: whole blocks, then the padded tail
+        full = len / 64;
+        reference(expected[i], data + i, full);
+        tail_blocks = pad_final_512(tail, data + i + full * 64, (uint8_t)(len % 64), len);
+        reference(expected[i], tail, tail_blocks);
+    }
+
+    mb_compute_32(candidate, word_count, jobs, BATCH_TEST_MESSAGES, NULL, NULL);
+
+    for (int i = 0; i < BATCH_TEST_MESSAGES; ++i)
+    {
+        if (memcmp(expected[i], actual[i], word_count * sizeof(uint32_t)))
+        {
+            printf(ENGINE_MISMATCH, i, (unsigned long long)jobs[i].message_len);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+mb_kernel_matches_64(
+    compressor_64_t reference,
+    mb_compressor_64_t candidate
+)
+{
+    static uint8_t blocks[MB_LANES][KERNEL_TEST_BLOCKS * 128];
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    uint64_t expected[MB_LANES][8], state[8 * MB_LANES];
+    const uint8_t * lane_blocks[MB_LANES];
+
+    for (int l = 0; l < MB_LANES; ++l)
+    {
+        for (int i = 0; i < KERNEL_TEST_BLOCKS * 128; ++i)
+            blocks[l][i] = (uint8_t)next_random(&seed);
+
+        for (uint8_t w = 0; w < 8; ++w)
+            expected[l][w] = state[w * MB_LANES + l] = next_random(&seed);
+    }
+
+    for (int n = 0; n < KERNEL_TEST_BLOCKS; ++n)
+    {
+        for (int l = 0; l < MB_LANES; ++l)
+        {
+            lane_blocks[l] = blocks[l] + n * 128;
+            reference(expected[l], lane_blocks[l], 1);
+        }
+
+        candidate(state, lane_blocks);
+
+        for (int l = 0; l < MB_LANES; ++l)
+        {
+            for (uint8_t w = 0; w < 8; ++w)
+            {
+                if (expected[l][w] != state[w * MB_LANES + l])
+                {
+                    printf(LANE_MISMATCH, l, n + 1);
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool
+mb_engine_matches_64(
+    compressor_64_t reference,
+    mb_compressor_64_t candidate
+)
+{
+    static uint8_t data[8192];
+    static uint64_t expected[BATCH_TEST_MESSAGES][8], actual[BATCH_TEST_MESSAGES][8];
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    mb_job jobs[BATCH_TEST_MESSAGES];
+    uint8_t tail[256], tail_blocks;
+    uint64_t len, full;
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    for (int i = 0; i < BATCH_TEST_MESSAGES; ++i)
+    {
+        len = (i % 10 == 7) ? 4000 + i : (uint64_t)((i * 37) % 300);
+
+        for (uint8_t w = 0; w < 8; ++w)
+            expected[i][w] = actual[i][w] = next_random(&seed);
+
+        jobs[i].message = data + i;
+        jobs[i].message_len = len;
+        jobs[i].hash_words = actual[i];
+        jobs[i].absorbed_len = 0;
+        jobs[i].prefix = NULL;
+        jobs[i].prefix_len = 0;
+        jobs[i].unpadded = 0;
+
+        // Reference: whole blocks, then the padded tail
+        full = len / 128;
+        reference(expected[i], data + i, full);
+        tail_blocks = pad_final_1024(tail, data + i + full * 128, (uint8_t)(len % 128), len);
+        reference(expected[i], tail, tail_blocks);
+    }
+
+    mb_compute_64(candidate, 8, jobs, BATCH_TEST_MESSAGES, NULL, NULL);
+
+    for (int i = 0; i < BATCH_TEST_MESSAGES; ++i)
+    {
+        if (memcmp(expected[i], actual[i], 8 * sizeof(uint64_t)))
+        {
+            printf(ENGINE_MISMATCH, i, (unsigned long long)jobs[i].message_len);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+batch_matches_single(
+    batch_hasher_t batch_function,
+    hasher_t hash_function,
+    const uint8_t digest_len
+)
+{
+    static const ShaDigestFormat FORMATS[3] = 
+        { OCTET_ARRAY, HEX_STRING_LOWER, HEX_STRING_UPPER };
+
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    const uint8_t * messages[BATCH_TEST_MESSAGES];
+    uint64_t message_lens[BATCH_TEST_MESSAGES];
+    uint8_t expected[HEX_DIGEST_BUFFER_LEN];
+    size_t stride, total_len = 0;
+    bool success = true;
+
+    // Mostly short messages so lanes finish at different times, plus a few
+    // multi-block ones that keep a lane busy while the others are refilled
+    for (int i = 0; i < BATCH_TEST_MESSAGES; ++i)
+    {
+        message_lens[i] = (i % 10 == 7) ? 4000 + i : (uint64_t)((i * 37) % 300);
+        total_len += message_lens[i];
+    }
+
+    uint8_t * data = malloc(total_len + 1);
+    uint8_t * digests = malloc(BATCH_TEST_MESSAGES * HEX_DIGEST_BUFFER_LEN);
+
+    if (!data || !digests)
+    {
+        free(data);
+        free(digests);
+        return false;
+    }
+
+    for (size_t i = 0; i < total_len; ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    for (int i = 0, offset = 0; i < BATCH_TEST_MESSAGES; offset += (int)message_lens[i++])
+        messages[i] = data + offset;
+
+    for (int f = 0; f < 3 && success; ++f)
+    {
+        stride = (FORMATS[f] == OCTET_ARRAY) ? digest_len : digest_len * 2 + 1;
+
+        if (batch_function(digests, messages, message_lens, 
+                BATCH_TEST_MESSAGES, FORMATS[f]) != HASH_COMPUTED)
+        {
+            success = false;
+            break;
+        }
+
+        for (int i = 0; i < BATCH_TEST_MESSAGES; ++i)
+        {
+            hash_function(expected, messages[i], message_lens[i], FORMATS[f]);
+
+            if (memcmp(expected, digests + i * stride, stride))
+            {
+                printf(BATCH_MISMATCH, i, (unsigned long long)message_lens[i], FORMATS[f]);
+                success = false;
+                break;
+            }
+        }
+    }
+
+    free(data);
+    free(digests);
+    return success;
+}
+
+bool
+backend_matches_scalar(const ShaBackend backend)
+{
+    const uint8_t * messages[BACKEND_TEST_MESSAGES];
+    uint64_t message_lens[BACKEND_TEST_MESSAGES];
+    bool success;
+
+    if (!scalar_reference(messages, message_lens))
+        return false;
+
+    if (sha_set_backend(backend) != HASH_COMPUTED || sha_get_backend() != backend)
+    {
+        sha_set_backend(BACKEND_AUTO);
+        return false;
+    }
+
+    success = matches_reference(messages, message_lens);
+
+    if (!success)
+        printf(BACKEND_MISMATCH, backend);
+
+    sha_set_backend(BACKEND_AUTO);
+
+    return success;
+}
+
+bool
+tuning_matches_scalar(const char * cache_path)
+{
+    const uint8_t * messages[BACKEND_TEST_MESSAGES];
+    uint64_t message_lens[BACKEND_TEST_MESSAGES];
+    bool success;
+
+    if (!scalar_reference(messages, message_lens))
+        return false;
+
+    if (sha_autotune(cache_path) != HASH_COMPUTED || sha_get_backend() != BACKEND_AUTO)
+    {
+        sha_set_backend(BACKEND_AUTO);
+        return false;
+    }
+
+    success = matches_reference(messages, message_lens);
+
+    if (!success)
+        printf(TUNING_MISMATCH);
+
+    sha_set_backend(BACKEND_AUTO);
+
+    return success;
+}
+
+bool
+generic_batch_matches_single(ShaType algorithm)
+{
+    static uint8_t data[GENERIC_BATCH_MESSAGES * 64 + 20000];
+    static uint8_t digests[GENERIC_BATCH_MESSAGES * HEX_DIGEST_BUFFER_LEN];
+    static const uint8_t UNTOUCHED[HEX_DIGEST_BUFFER_LEN] = { 0 };
+
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    const uint8_t * messages[GENERIC_BATCH_MESSAGES];
+    uint64_t message_lens[GENERIC_BATCH_MESSAGES];
+    ShaComputationResult statuses[GENERIC_BATCH_MESSAGES], expected_status[GENERIC_BATCH_MESSAGES];
+    ShaComputationResult first = HASH_COMPUTED, result;
+    uint8_t expected[HEX_DIGEST_BUFFER_LEN];
+    size_t stride = DIGEST_LENS[algorithm] * 2 + 1;
+    bool success = true;
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    // Every size bucket, shuffled together, with a few messages that must be
+    // rejected without holding up the rest
+    for (int i = 0; i < GENERIC_BATCH_MESSAGES; ++i)
+    {
+        messages[i] = data + i * 64;
+        message_lens[i] = (i % 17 == 3) ? 10000 + i : (i % 7 == 2) ? 1000 + i : (uint64_t)((i * 37) % 300);
+        expected_status[i] = HASH_COMPUTED;
+
+        if (i % 13 == 5)
+        {
+            messages[i] = NULL;
+            expected_status[i] = NULL_MESSAGE_POINTER;
+        }
+        else if (i % 29 == 11 && algorithm <= SHA256)
+        {
+            message_lens[i] = SHA256_MAX_MSG_LEN + 1;
+            expected_status[i] = UNSUPPORTED_DATA_SIZE;
+        }
+
+        if (first == HASH_COMPUTED)
+            first = expected_status[i];
+    }
+
+    memset(digests, 0, sizeof(digests));
+    result = sha_batch(algorithm, digests, messages, message_lens, GENERIC_BATCH_MESSAGES, 
+        HEX_STRING_LOWER, statuses);
+
+    if (result != first)
+    {
+        printf(STATUS_MISMATCH, -1, 0ULL, result, first);
+        success = false;
+    }
+
+    for (int i = 0; i < GENERIC_BATCH_MESSAGES && success; ++i)
+    {
+        if (statuses[i] != expected_status[i])
+        {
+            printf(STATUS_MISMATCH, i, (unsigned long long)message_lens[i], statuses[i], expected_status[i]);
+            success = false;
+        }
+        else if (statuses[i] != HASH_COMPUTED)
+        {
+            success = !memcmp(digests + i * stride, UNTOUCHED, stride);
+        }
+        else
+        {
+            sha(algorithm, expected, messages[i], message_lens[i], HEX_STRING_LOWER);
+            success = !memcmp(digests + i * stride, expected, stride);
+        }
+
+        if (!success)
+            printf(BATCH_MISMATCH, i, (unsigned long long)message_lens[i], HEX_STRING_LOWER);
+    }
+
+    // Without statuses the whole batch is validated up front
+    if (success && sha_batch(algorithm, digests, messages, message_lens, 
+            GENERIC_BATCH_MESSAGES, OCTET_ARRAY, NULL) != first)
+        success = false;
+
+    if (success && sha_batch((ShaType)7, digests, messages, message_lens, 
+            GENERIC_BATCH_MESSAGES, OCTET_ARRAY, statuses) != INVALID_ALGORITHM)
+        success = false;
+
+    return success;
+}
+
+bool
+midstate_matches_single(ShaType algorithm)
+{
+    // Prefixes ending at, just past and just short of block boundaries
+    static const uint64_t PREFIX_LENS[9] = { 0, 1, 55, 64, 100, 127, 128, 200, 1000 };
+
+    static const ShaBackend BACKENDS[2] = { BACKEND_AUTO, BACKEND_AVX2 };
+
+    static const ShaDigestFormat FORMATS[3] = 
+        { OCTET_ARRAY, HEX_STRING_LOWER, HEX_STRING_UPPER };
+
+    static uint8_t data[8192];
+    static uint8_t digests[MIDSTATE_TEST_SUFFIXES * HEX_DIGEST_BUFFER_LEN];
+
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    const uint8_t * suffixes[MIDSTATE_TEST_SUFFIXES];
+    uint64_t suffix_lens[MIDSTATE_TEST_SUFFIXES];
+    uint8_t expected[HEX_DIGEST_BUFFER_LEN];
+    any_ctx midstate, frozen, reference;
+    size_t digest_len = DIGEST_LENS[algorithm], stride;
+    bool success = true;
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    // Short suffixes that end inside the prefix's partial block, plus a few
+    // multi-block ones (every multi-buffer lane sees a head block)
+    for (int i = 0; i < MIDSTATE_TEST_SUFFIXES; ++i)
+    {
+        suffixes[i] = data + 1024 + i;
+        suffix_lens[i] = (i % 10 == 7) ? 4000 + i : (uint64_t)((i * 37) % 300);
+    }
+
+    for (int b = 0; b < 2 && success; ++b)
+    {
+        if (sha_set_backend(BACKENDS[b]) != HASH_COMPUTED)
+            continue;
+
+        for (int p = 0; p < 9 && success; ++p)
+        {
+            context_init(algorithm, &midstate);
+            context_update(algorithm, &midstate, data, PREFIX_LENS[p]);
+            memcpy(&frozen, &midstate, sizeof(any_ctx));
+
+            for (int f = 0; f < 3 && success; ++f)
+            {
+                stride = (FORMATS[f] == OCTET_ARRAY) ? digest_len : digest_len * 2 + 1;
+
+                success = context_suffix_batch(algorithm, &midstate, digests, suffixes, 
+                    suffix_lens, MIDSTATE_TEST_SUFFIXES, FORMATS[f]) == HASH_COMPUTED;
+
+                for (int i = 0; i < MIDSTATE_TEST_SUFFIXES && success; ++i)
+                {
+                    // Streaming from a copy of the midstate is the reference
+                    memcpy(&reference, &midstate, sizeof(any_ctx));
+                    context_update(algorithm, &reference, suffixes[i], suffix_lens[i]);
+                    context_final(algorithm, &reference, expected, FORMATS[f]);
+
+                    if (memcmp(expected, digests + i * stride, stride))
+                    {
+                        printf(SUFFIX_MISMATCH, i, (unsigned long long)suffix_lens[i], 
+                            (unsigned long long)PREFIX_LENS[p], " (batch)");
+                        success = false;
+                        break;
+                    }
+
+                    context_suffix(algorithm, &midstate, digests, suffixes[i], suffix_lens[i], FORMATS[f]);
+
+                    if (memcmp(expected, digests, stride))
+                    {
+                        printf(SUFFIX_MISMATCH, i, (unsigned long long)suffix_lens[i], 
+                            (unsigned long long)PREFIX_LENS[p], "");
+                        success = false;
+                    }
+                }
+            }
+
+            // The midstate itself is never written
+            if (success && memcmp(&frozen, &midstate, sizeof(any_ctx)))
+            {
+                printf(SUFFIX_MISMATCH, -1, 0ULL, (unsigned long long)PREFIX_LENS[p], " (midstate modified)");
+                success = false;
+            }
+        }
+    }
+
+    sha_set_backend(BACKEND_AUTO);
+
+    return success;
+}
+
+bool
+manager_matches_streaming(ShaType algorithm)
+{
+    static const ShaBackend BACKENDS[3] = { BACKEND_AUTO, BACKEND_AVX2, BACKEND_AVX512 };
+
+    // Chunk lengths each stream cycles through: empty and single bytes, block
+    // boundaries from both sides, and multi-block runs
+    static const uint64_t CHUNK_LENS[8] = { 1, 63, 64, 65, 200, 0, 1000, 127 };
+
+    static uint8_t data[MANAGER_TEST_STREAMS * 64 + MANAGER_TEST_ROUNDS * 2000];
+    static any_ctx streams[MANAGER_TEST_STREAMS];
+
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    uint64_t absorbed[MANAGER_TEST_STREAMS];
+    uint8_t expected[HEX_DIGEST_BUFFER_LEN], actual[HEX_DIGEST_BUFFER_LEN];
+    sha_manager manager;
+    bool success = true;
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    for (int b = 0; b < 3 && success; ++b)
+    {
+        if (sha_set_backend(BACKENDS[b]) != HASH_COMPUTED)
+            continue;
+
+        success = sha_manager_init(&manager, algorithm) == HASH_COMPUTED;
+
+        for (int s = 0; s < MANAGER_TEST_STREAMS; ++s)
+        {
+            context_init(algorithm, &streams[s]);
+            absorbed[s] = 0;
+        }
+
+        // Round-robin over the streams, with every fifth stream submitting twice
+        // in a row (its second chunk must wait for the first)
+        for (int r = 0; r < MANAGER_TEST_ROUNDS && success; ++r)
+        {
+            for (int s = 0; s < MANAGER_TEST_STREAMS && success; ++s)
+            {
+                for (int repeat = 0; repeat < ((s % 5) ? 1 : 2) && success; ++repeat)
+                {
+                    uint64_t chunk_len = CHUNK_LENS[(s + r + repeat) % 8];
+
+                    success = sha_manager_submit(&manager, &streams[s], 
+                        data + s * 64 + absorbed[s], chunk_len) == HASH_COMPUTED;
+                    absorbed[s] += chunk_len;
+                }
+            }
+        }
+
+        success = success && sha_manager_flush(&manager) == HASH_COMPUTED;
+
+        for (int s = 0; s < MANAGER_TEST_STREAMS && success; ++s)
+        {
+            sha(algorithm, expected, data + s * 64, absorbed[s], OCTET_ARRAY);
+            context_final(algorithm, &streams[s], actual, OCTET_ARRAY);
+
+            if (memcmp(expected, actual, DIGEST_LENS[algorithm]))
+            {
+                printf(MANAGER_MISMATCH, s, (unsigned long long)absorbed[s], BACKENDS[b]);
+                success = false;
+            }
+        }
+    }
+
+    sha_set_backend(BACKEND_AUTO);
+
+    // Argument validation
+    if (success)
+    {
+        sha_manager_init(&manager, algorithm);
+        context_init(algorithm, &streams[0]);
+
+        success = sha_manager_init(NULL, algorithm) == NULL_CONTEXT_POINTER
+            && sha_manager_init(&manager, (ShaType)7) == INVALID_ALGORITHM
+            && sha_manager_submit(NULL, &streams[0], data, 1) == NULL_CONTEXT_POINTER
+            && sha_manager_submit(&manager, NULL, data, 1) == NULL_CONTEXT_POINTER
+            && sha_manager_submit(&manager, &streams[0], NULL, 1) == NULL_MESSAGE_POINTER
+            && sha_manager_flush(NULL) == NULL_CONTEXT_POINTER;
+    }
+
+    return success;
+}
+
+bool
+job_matches_single(ShaType algorithm)
+{
+    // Lengths around both padding thresholds and block boundaries, plus long messages
+    static const uint64_t MESSAGE_LENS[10] = { 0, 1, 55, 56, 64, 111, 112, 128, 1000, 100000 };
+
+    // Step budgets, 0 meaning finalize without stepping
+    static const uint64_t BUDGETS[6] = { 0, 1, 2, 3, 7, 1000 };
+
+    static uint8_t data[100000];
+
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    uint8_t expected[HEX_DIGEST_BUFFER_LEN], actual[HEX_DIGEST_BUFFER_LEN];
+    uint64_t blocks_left, done;
+    sha_job job;
+    bool success = true;
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    for (int m = 0; m < 10 && success; ++m)
+    {
+        sha(algorithm, expected, data, MESSAGE_LENS[m], HEX_STRING_LOWER);
+
+        for (int b = 0; b < 6 && success; ++b)
+        {
+            success = sha_job_init(&job, algorithm, data, MESSAGE_LENS[m]) == HASH_COMPUTED;
+            blocks_left = job.block_count;
+
+            // No step may exceed its budget, and every step must make progress
+            while (BUDGETS[b] && blocks_left && success)
+            {
+                done = job.blocks_done;
+                success = sha_job_step(&job, BUDGETS[b], &blocks_left) == HASH_COMPUTED
+                    && job.blocks_done > done
+                    && job.blocks_done - done <= BUDGETS[b]
+                    && blocks_left == job.block_count - job.blocks_done;
+            }
+
+            if (!success)
+            {
+                printf(JOB_MISMATCH, (unsigned long long)MESSAGE_LENS[m], 
+                    (unsigned long long)BUDGETS[b], " (step out of budget)");
+                break;
+            }
+
+            success = sha_job_final(&job, actual, HEX_STRING_LOWER) == HASH_COMPUTED
+                && !strcmp((const char *)expected, (const char *)actual);
+
+            if (!success)
+                printf(JOB_MISMATCH, (unsigned long long)MESSAGE_LENS[m], (unsigned long long)BUDGETS[b], "");
+        }
+    }
+
+    // An empty message may be given as NULL
+    if (success)
+    {
+        sha(algorithm, expected, data, 0, HEX_STRING_LOWER);
+
+        success = sha_job_init(&job, algorithm, NULL, 0) == HASH_COMPUTED
+            && sha_job_step(&job, 1000, NULL) == HASH_COMPUTED
+            && sha_job_final(&job, actual, HEX_STRING_LOWER) == HASH_COMPUTED
+            && !strcmp((const char *)expected, (const char *)actual);
+
+        if (!success)
+            printf(JOB_MISMATCH, 0ULL, 1000ULL, " (NULL message)");
+    }
+
+    // Argument validation
+    if (success)
+    {
+        sha_job_init(&job, algorithm, data, 1);
+
+        success = sha_job_init(NULL, algorithm, data, 1) == NULL_CONTEXT_POINTER
+            && sha_job_init(&job, (ShaType)7, data, 1) == INVALID_ALGORITHM
+            && sha_job_init(&job, algorithm, NULL, 1) == NULL_MESSAGE_POINTER
+            && sha_job_step(NULL, 1, NULL) == NULL_CONTEXT_POINTER
+            && sha_job_final(NULL, actual, OCTET_ARRAY) == NULL_CONTEXT_POINTER
+            && sha_job_final(&job, NULL, OCTET_ARRAY) == NULL_DIGEST_POINTER
+            && sha_job_final(&job, actual, (ShaDigestFormat)(BASE64URL + 1)) == INVALID_DIGEST_FORMAT;
+
+        if (success && algorithm <= SHA256)
+            success = sha_job_init(&job, algorithm, data, SHA256_MAX_MSG_LEN + 1) == UNSUPPORTED_DATA_SIZE;
+    }
+
+    return success;
+}
+
+bool
+multi_matches_single(void)
+{
+    static const ShaBackend BACKENDS[4] = { BACKEND_AUTO, BACKEND_SCALAR, BACKEND_AVX2, BACKEND_AVX512 };
+
+    // Lengths around both block lengths and the pass's chunk boundaries
+    static const uint64_t MESSAGE_LENS[12] = { 0, 1, 63, 64, 100, 127, 128, 129, 8191, 8192, 8193, 50000 };
+
+    // Every algorithm, one per family, IV variants sharing lanes, a repeat, and a lone one
+    static const ShaType SETS[6][7] =
+    {
+        { SHA1, SHA224, SHA256, SHA384, SHA512, SHA512_224, SHA512_256 },
+        { SHA1, SHA256, SHA512 },
+        { SHA256, SHA224 },
+        { SHA384, SHA512_256 },
+        { SHA512, SHA512 },
+        { SHA512_224 }
+    };
+
+    static const size_t SET_SIZES[6] = { 7, 3, 2, 2, 2, 1 };
+
+    static uint8_t data[50000];
+    static uint8_t buffers[7][HEX_DIGEST_BUFFER_LEN];
+
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+    uint8_t expected[HEX_DIGEST_BUFFER_LEN];
+    uint8_t * digests[7];
+    bool success = true;
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    for (int d = 0; d < 7; ++d)
+        digests[d] = buffers[d];
+
+    for (int b = 0; b < 4 && success; ++b)
+    {
+        if (sha_set_backend(BACKENDS[b]) != HASH_COMPUTED)
+            continue;
+
+        for (int m = 0; m < 12 && success; ++m)
+        {
+            for (int t = 0; t < 6 && success; ++t)
+            {
+                success = sha_multi(SETS[t], SET_SIZES[t], digests, data, MESSAGE_LENS[m], 
+                    HEX_STRING_LOWER) == HASH_COMPUTED;
+
+                for (size_t i = 0; i < SET_SIZES[t] && success; ++i)
+                {
+                    sha(SETS[t][i], expected, data, MESSAGE_LENS[m], HEX_STRING_LOWER);
+
+                    if (strcmp((const char *)expected, (const char *)digests[i]))
+                    {
+                        printf(MULTI_MISMATCH, ALGORITHM_STRINGS[SETS[t][i]], 
+                            (unsigned long long)MESSAGE_LENS[m], t, BACKENDS[b]);
+                        success = false;
+                    }
+                }
+            }
+        }
+    }
+
+    sha_set_backend(BACKEND_AUTO);
+
+    // Argument validation
+    if (success)
+    {
+        static const ShaType BAD_SET[2] = { SHA256, (ShaType)7 };
+        uint8_t * null_digests[2] = { buffers[0], NULL };
+
+        success = sha_multi(SETS[1], 0, NULL, NULL, 0, OCTET_ARRAY) == HASH_COMPUTED
+            && sha_multi(NULL, 1, digests, data, 1, OCTET_ARRAY) == INVALID_ALGORITHM
+            && sha_multi(BAD_SET, 2, digests, data, 1, OCTET_ARRAY) == INVALID_ALGORITHM
+            && sha_multi(SETS[1], 2, NULL, data, 1, OCTET_ARRAY) == NULL_DIGEST_POINTER
+            && sha_multi(SETS[1], 2, null_digests, data, 1, OCTET_ARRAY) == NULL_DIGEST_POINTER
+            && sha_multi(SETS[1], 3, digests, NULL, 1, OCTET_ARRAY) == NULL_MESSAGE_POINTER
+            && sha_multi(SETS[1], 3, digests, data, SHA1_MAX_MSG_LEN + 1, OCTET_ARRAY) == UNSUPPORTED_DATA_SIZE
+            && sha_multi(SETS[1], 3, digests, data, 1, (ShaDigestFormat)(BASE64URL + 1)) == INVALID_DIGEST_FORMAT;
+    }
+
+    return success;
+}
+
+bool
+encoding_matches_reference(void)
+{
+    static const ShaDigestFormat FORMATS[4] = { HEX_STRING_LOWER, HEX_STRING_UPPER, BASE64, BASE64URL };
+    static const char * FORMAT_STRINGS[4] = { "Lowercase hex", "Uppercase hex", "Base64", "Base64url" };
+
+    uint64_t seed = UINT64_C(0x0123456789abcdef);
+    uint8_t raw[ENCODING_TEST_MAX_LEN], decoded[ENCODING_TEST_MAX_LEN];
+    uint8_t encoded[2 * ENCODING_TEST_MAX_LEN + 2];
+    char expected[2 * ENCODING_TEST_MAX_LEN + 1];
+    bool success = true;
+
+    for (int len = 0; len <= ENCODING_TEST_MAX_LEN && success; ++len)
+    {
+        for (int i = 0; i < len; ++i)
+            raw[i] = (uint8_t)next_random(&seed);
+
+        for (int f = 0; f < 4 && success; ++f)
+        {
+            size_t size = reference_encode(expected, raw, len, FORMATS[f]) + 1;
+
+            // Exact size, terminator included, and nothing written past it
+            memset(encoded, 0x5a, sizeof(encoded));
+
+            if (sha_encoded_size(len, FORMATS[f]) != size
+                || sha_encode(encoded, raw, len, FORMATS[f]) != HASH_COMPUTED
+                || memcmp(encoded, expected, size) || encoded[size] != 0x5a)
+            {
+                printf(ENCODING_MISMATCH, FORMAT_STRINGS[f], len, "encode");
+                success = false;
+                break;
+            }
+
+            memset(decoded, 0xa5, sizeof(decoded));
+
+            if (sha_decode(decoded, encoded, len, FORMATS[f]) != HASH_COMPUTED || memcmp(decoded, raw, len))
+            {
+                printf(ENCODING_MISMATCH, FORMAT_STRINGS[f], len, "decode");
+                success = false;
+                break;
+            }
+
+            // Any one character out of the alphabet makes the whole text malformed
+            for (size_t c = 0; c + 1 < size && success; ++c)
+            {
+                uint8_t kept = encoded[c];
+                encoded[c] = '!';
+                success = sha_decode(decoded, encoded, len, FORMATS[f]) == MALFORMED_ENCODING;
+                encoded[c] = kept;
+            }
+
+            // So does a final base64 character with bits set below the last byte
+            // (those bits are zero, so the next character in the alphabet sets one)
+            if (success && (FORMATS[f] == BASE64 || FORMATS[f] == BASE64URL) && len % 3)
+            {
+                size_t last = size - 2 - (FORMATS[f] == BASE64 ? 3 - len % 3 : 0);
+
+                if (encoded[last] == '+' || encoded[last] == '-')
+                    encoded[last] = FORMATS[f] == BASE64 ? '/' : '_';
+                else
+                    ++encoded[last];
+
+                success = sha_decode(decoded, encoded, len, FORMATS[f]) == MALFORMED_ENCODING;
+            }
+
+            if (!success)
+                printf(ENCODING_MISMATCH, FORMAT_STRINGS[f], len, "malformed text accepted");
+        }
+
+        // Hex decodes in either case, whichever hex format is named
+        if (success)
+        {
+            reference_encode(expected, raw, len, HEX_STRING_UPPER);
+            success = sha_decode(decoded, (const uint8_t *)expected, len, HEX_STRING_LOWER) == HASH_COMPUTED
+                && !memcmp(decoded, raw, len);
+        }
+    }
+
+    // Argument validation
+    if (success)
+    {
+        success = sha_encoded_size(1, (ShaDigestFormat)(BASE64URL + 1)) == 0
+            && sha_encode(NULL, raw, 1, BASE64) == NULL_DIGEST_POINTER
+            && sha_encode(encoded, NULL, 1, BASE64) == NULL_MESSAGE_POINTER
+            && sha_encode(encoded, raw, 1, (ShaDigestFormat)(BASE64URL + 1)) == INVALID_DIGEST_FORMAT
+            && sha_decode(NULL, encoded, 1, BASE64) == NULL_DIGEST_POINTER
+            && sha_decode(decoded, NULL, 1, BASE64) == NULL_MESSAGE_POINTER
+            && sha_decode(decoded, encoded, 1, (ShaDigestFormat)(BASE64URL + 1)) == INVALID_DIGEST_FORMAT
+            && sha_encode_batch(NULL, raw, 1, 1, BASE64) == NULL_DIGEST_POINTER
+            && sha_encode_batch(encoded, NULL, 1, 1, BASE64) == NULL_MESSAGE_POINTER
+            && sha_encode_batch(encoded, raw, 1, 1, (ShaDigestFormat)(BASE64URL + 1)) == INVALID_DIGEST_FORMAT
+            && sha_encode_batch(NULL, NULL, 0, 32, BASE64) == HASH_COMPUTED;
+    }
+
+    return success;
+}
+
+bool
+encoded_digests_match(void)
+{
+    // SRI and token strings for "abc" (from an independent implementation)
+    static const struct
+    {
+        ShaType algorithm;
+        ShaDigestFormat format;
+        const char * encoded;
+
+    } VECTORS[4] =
+    {
+        { SHA1,   BASE64,    "qZk+NkcGgWq6PiVxeFDCbJzQ2J0=" },
+        { SHA256, BASE64URL, "ungWv48Bz-pBQUDeXa4iI7ADYaOWF3qctBD_YfIAFa0" },
+        { SHA384, BASE64,    "ywB1P0WjXou1oD1pmsZQBycsMqsO3tFjGotgWkP/W+2AhgcroefMI1i67KE0yCWn" },
+        { SHA512, BASE64URL, "3a81oZNherrMQXNJriBBMRLm-k6JqX6iCp7u5ktV05ohkpkqJ0_BqDa6PCOj_uu9RU1EI2Q86A4qmslPpUyknw" }
+    };
+
+    static const ShaDigestFormat FORMATS[4] = { HEX_STRING_LOWER, HEX_STRING_UPPER, BASE64, BASE64URL };
+
+    static uint8_t data[BATCH_TEST_MESSAGES * 64];
+    static uint8_t raw[BATCH_TEST_MESSAGES * SHA512_DIGEST_LEN];
+    static uint8_t batched[BATCH_TEST_MESSAGES * HEX_DIGEST_BUFFER_LEN];
+    static uint8_t encoded[BATCH_TEST_MESSAGES * HEX_DIGEST_BUFFER_LEN];
+
+    const uint8_t * messages[BATCH_TEST_MESSAGES];
+    uint64_t message_lens[BATCH_TEST_MESSAGES];
+    uint64_t seed = UINT64_C(0xfedcba9876543210);
+    uint8_t digest[HEX_DIGEST_BUFFER_LEN];
+    bool success = true;
+
+    for (int v = 0; v < 4 && success; ++v)
+    {
+        const uint8_t * expected = (const uint8_t *)VECTORS[v].encoded;
+
+        success = sha(VECTORS[v].algorithm, digest, (const uint8_t *)"abc", 3, VECTORS[v].format) == HASH_COMPUTED
+            && !strcmp((const char *)digest, VECTORS[v].encoded)
+            && sha_verify(VECTORS[v].algorithm, (const uint8_t *)"abc", 3, expected, VECTORS[v].format) == HASH_COMPUTED
+            && sha_verify(VECTORS[v].algorithm, (const uint8_t *)"abd", 3, expected, VECTORS[v].format) == DIGEST_MISMATCH;
+
+        if (!success)
+            printf(ENCODING_MISMATCH, ALGORITHM_STRINGS[VECTORS[v].algorithm], 3, VECTORS[v].encoded);
+    }
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    for (int i = 0; i < BATCH_TEST_MESSAGES; ++i)
+    {
+        messages[i] = data + i * 64;
+        message_lens[i] = (uint64_t)i % 65;
+    }
+
+    // Raw batch digests encoded afterwards match the batch's own encoding
+    for (int a = SHA1; a <= SHA512_256 && success; ++a)
+    {
+        success = sha_batch((ShaType)a, raw, messages, message_lens, BATCH_TEST_MESSAGES, OCTET_ARRAY, NULL) == HASH_COMPUTED;
+
+        for (int f = 0; f < 4 && success; ++f)
+        {
+            size_t size = sha_encoded_size(DIGEST_LENS[a], FORMATS[f]);
+
+            success = sha_batch((ShaType)a, batched, messages, message_lens, BATCH_TEST_MESSAGES, FORMATS[f], NULL) == HASH_COMPUTED
+                && sha_encode_batch(encoded, raw, BATCH_TEST_MESSAGES, DIGEST_LENS[a], FORMATS[f]) == HASH_COMPUTED
+                && !memcmp(encoded, batched, BATCH_TEST_MESSAGES * size)
+                && sha_verify_batch((ShaType)a, messages, message_lens, BATCH_TEST_MESSAGES, 
+                    encoded, FORMATS[f], NULL) == HASH_COMPUTED;
+
+            if (!success)
+                printf(ENCODING_MISMATCH, ALGORITHM_STRINGS[a], DIGEST_LENS[a], "batch");
+        }
+    }
+
+    return success;
+}
+
+bool
+short_messages_match_streaming(void)
+{
+    static const ShaBackend BACKENDS[6] =
+    {
+        BACKEND_AUTO, BACKEND_SCALAR, BACKEND_SSSE3, BACKEND_AVX2, BACKEND_AVX512, BACKEND_SHA_NI
+    };
+
+    static uint8_t data[SHORT_TEST_MESSAGES * 257];
+    static uint8_t digests[SHORT_TEST_MESSAGES * SHA512_DIGEST_LEN];
+
+    const uint8_t * messages[SHORT_TEST_MESSAGES];
+    uint64_t message_lens[SHORT_TEST_MESSAGES];
+    uint64_t seed = UINT64_C(0x2545f4914f6cdd1d);
+    uint8_t expected[SHA512_DIGEST_LEN];
+    uint8_t computed[SHA512_DIGEST_LEN];
+    bool success = true;
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    for (int m = 0; m < SHORT_TEST_MESSAGES; ++m)
+        messages[m] = data + m * 257;
+
+    for (int b = 0; b < 6 && success; ++b)
+    {
+        if (sha_set_backend(BACKENDS[b]) != HASH_COMPUTED)
+            continue;
+
+        for (int t = 0; t < 7 && success; ++t)
+        {
+            uint64_t block_len = (t < SHA384) ? 64 : 128;
+
+            // Every length through two blocks, so each fixed-length path and
+            // both of its neighbours are covered
+            for (uint64_t len = 0; len <= 2 * block_len + 1 && success; ++len)
+            {
+                stream_hash((ShaType)t, expected, data, len, OCTET_ARRAY);
+                sha((ShaType)t, computed, data, len, OCTET_ARRAY);
+
+                if (!sequence_equal(expected, computed, DIGEST_LENS[t]))
+                {
+                    printf(SHORT_MISMATCH, "One-shot", ALGORITHM_STRINGS[t], (int)len, BACKENDS[b]);
+                    success = false;
+                    break;
+                }
+
+                // Equal lengths keep every lane of a multi-buffer kernel in step
+                for (int m = 0; m < SHORT_TEST_MESSAGES; ++m)
+                    message_lens[m] = len;
+
+                sha_batch((ShaType)t, digests, messages, message_lens, SHORT_TEST_MESSAGES, 
+                    OCTET_ARRAY, NULL);
+
+                for (int m = 0; m < SHORT_TEST_MESSAGES && success; ++m)
+                {
+                    stream_hash((ShaType)t, expected, messages[m], len, OCTET_ARRAY);
+
+                    if (!sequence_equal(expected, digests + m * DIGEST_LENS[t], DIGEST_LENS[t]))
+                    {
+                        printf(SHORT_MISMATCH, "Batch", ALGORITHM_STRINGS[t], (int)len, BACKENDS[b]);
+                        success = false;
+                    }
+                }
+            }
+        }
+    }
+
+    sha_set_backend(BACKEND_AUTO);
+
+    return success;
+}
+
+bool
+sha256d_matches_double_sha256(void)
+{
+    static const ShaBackend BACKENDS[6] =
+    {
+        BACKEND_AUTO, BACKEND_SCALAR, BACKEND_SSSE3, BACKEND_AVX2, BACKEND_AVX512, BACKEND_SHA_NI
+    };
+
+    // Empty message, "hello", and the Bitcoin genesis block header
+    // (whose digest, byte-reversed, is the well-known block hash)
+    static const char * GENESIS_HEADER =
+        "0100000000000000000000000000000000000000000000000000000000000000"
+        "000000003ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa"
+        "4b1e5e4a29ab5f49ffff001d1dac2b7c";
+
+    static const char * KNOWN_DIGESTS[3] =
+    {
+        "5df6e0e2761359d30a8275058e299fcc0381534545f55cf43e41983f5d4c9456",
+        "9595c9df90075148eb06860365df33584b75bff782a510c6cd4883a419833d50",
+        "6fe28c0ab6f1b372c1a6a246ae63f74f931e8365e15a089c68d6190000000000"
+    };
+
+    static uint8_t data[SHA256D_TEST_MESSAGES * 311];
+    static uint8_t digests[SHA256D_TEST_MESSAGES * (SHA256_DIGEST_LEN * 2 + 1)];
+
+    const uint8_t * messages[SHA256D_TEST_MESSAGES];
+    uint64_t message_lens[SHA256D_TEST_MESSAGES];
+    uint64_t seed = UINT64_C(0x6a09e667f3bcc908);
+    uint8_t header[80];
+    uint8_t first[SHA256_DIGEST_LEN];
+    uint8_t expected[SHA256_DIGEST_LEN * 2 + 1];
+    uint8_t computed[SHA256_DIGEST_LEN * 2 + 1];
+    bool success = true;
+
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)next_random(&seed);
+
+    hex_to_bytes(header, GENESIS_HEADER, sizeof(header));
+
+    for (int b = 0; b < 6 && success; ++b)
+    {
+        if (sha_set_backend(BACKENDS[b]) != HASH_COMPUTED)
+            continue;
+
+        // Published digests
+        success = sha256d(computed, NULL, 0, HEX_STRING_LOWER) == HASH_COMPUTED
+            && !strcmp((const char *)computed, KNOWN_DIGESTS[0])
+            && sha256d(computed, (const uint8_t *)"hello", 5, HEX_STRING_LOWER) == HASH_COMPUTED
+            && !strcmp((const char *)computed, KNOWN_DIGESTS[1])
+            && sha256d(computed, header, sizeof(header), HEX_STRING_LOWER) == HASH_COMPUTED
+            && !strcmp((const char *)computed, KNOWN_DIGESTS[2]);
+
+        if (!success)
+        {
+            printf(DOUBLE_MISMATCH, "of a published vector", 0ULL, BACKENDS[b]);
+            break;
+        }
+
+        // Every length through several blocks, against two sha256() calls
+        for (uint64_t len = 0; len <= 300 && success; ++len)
+        {
+            sha256(first, data, len, OCTET_ARRAY);
+            sha256(expected, first, sizeof(first), HEX_STRING_LOWER);
+            sha256d(computed, data, len, HEX_STRING_LOWER);
+
+            if (strcmp((const char *)expected, (const char *)computed))
+            {
+                printf(DOUBLE_MISMATCH, "one-shot", (unsigned long long)len, BACKENDS[b]);
+                success = false;
+            }
+        }
+
+        // Mixed lengths in every size bucket, more messages than one pass takes
+        // and a partial group of lanes at the end
+        for (int m = 0; m < SHA256D_TEST_MESSAGES; ++m)
+        {
+            messages[m] = data + m * 311;
+            message_lens[m] = (m % 3) ? 80 : (uint64_t)(m * 37) % 311;
+
+            // Every seventh message is long enough for a larger bucket
+            if (m % 7 == 6)
+            {
+                messages[m] = data;
+                message_lens[m] = (m % 2) ? 1000 : 9000;
+            }
+        }
+
+        success = success && sha256d_batch(digests, messages, message_lens, SHA256D_TEST_MESSAGES, 
+            HEX_STRING_LOWER) == HASH_COMPUTED;
+
+        for (int m = 0; m < SHA256D_TEST_MESSAGES && success; ++m)
+        {
+            sha256d(expected, messages[m], message_lens[m], HEX_STRING_LOWER);
+
+            if (strcmp((const char *)expected, (const char *)(digests + m * (SHA256_DIGEST_LEN * 2 + 1))))
+            {
+                printf(DOUBLE_MISMATCH, "batch digest", (unsigned long long)message_lens[m], BACKENDS[b]);
+                success = false;
+            }
+        }
+    }
+
+    sha_set_backend(BACKEND_AUTO);
+
+    // Argument validation
+    if (success)
+    {
+        success = sha256d(NULL, data, 1, OCTET_ARRAY) == NULL_DIGEST_POINTER
+            && sha256d(computed, NULL, 1, OCTET_ARRAY) == NULL_MESSAGE_POINTER
+            && sha256d(computed, data, SHA256_MAX_MSG_LEN + 1, OCTET_ARRAY) == UNSUPPORTED_DATA_SIZE
+            && sha256d(computed, data, 1, (ShaDigestFormat)(BASE64URL + 1)) == INVALID_DIGEST_FORMAT
+            && sha256d_batch(NULL, NULL, NULL, 0, OCTET_ARRAY) == HASH_COMPUTED
+            && sha256d_batch(NULL, messages, message_lens, 1, OCTET_ARRAY) == NULL_DIGEST_POINTER
+            && sha256d_batch(digests, NULL, message_lens, 1, OCTET_ARRAY) == NULL_MESSAGE_POINTER
+            && sha256d_batch(digests, messages, message_lens, 1, (ShaDigestFormat)(BASE64URL + 1)) 
+                == INVALID_DIGEST_FORMAT;
+    }
+
+    return success;
+}
+
+static uint64_t
+next_random(uint64_t * state)
+{
+    // xorshift64* (deterministic, so failures reproduce)
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * UINT64_C(0x2545f4914f6cdd1d);
+}
+
+static void
+hex_to_bytes(uint8_t * dest, const char * hex, uint8_t byte_count)
+{
+    char c;
+    uint8_t byte;
+
+    for (uint8_t i = 0; i < byte_count; ++i)
+    {
+        byte = 0x00;
+
+        for (uint8_t j = 0; j < 2; ++j)
+        {
+            byte *= 16;
+            c = tolower(*hex++);
+            byte += c - (c <= '9' ? '0': 'a' - 10);
+        }
+
+        dest[i] = byte;
+    }
+}
+
+static bool
+sequence_equal(const uint8_t * a, const uint8_t * b, const uint8_t len)
+{
+    for (uint8_t i = 0; i < len; ++i)
+    {
+        if (a[i] != b[i])
+            return false;
+    }
+
+    return true;
+}
+
+static ShaComputationResult
+stream_hash(
+    ShaType algorithm,
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    // Chunk lengths chosen to straddle block boundaries in every possible way
+    static const uint64_t CHUNK_LENS[9] = { 1, 3, 63, 64, 65, 127, 128, 129, 1000 };
+
+    union
+    {
+        sha1_ctx sha1;
+        sha256_ctx sha256;
+        sha512_ctx sha512;
+
+    } ctx;
+
+    ShaComputationResult result;
+    uint64_t offset = 0, chunk_len;
+    int chunk = 0;
+
+    switch (algorithm)
+    {
+        case SHA1:       result = sha1_init(&ctx.sha1);         break;
+        case SHA224:     result = sha224_init(&ctx.sha256);     break;
+        case SHA256:     result = sha256_init(&ctx.sha256);     break;
+        case SHA384:     result = sha384_init(&ctx.sha512);     break;
+        case SHA512:     result = sha512_init(&ctx.sha512);     break;
+        case SHA512_224: result = sha512_224_init(&ctx.sha512); break;
+        case SHA512_256: result = sha512_256_init(&ctx.sha512); break;
+        default:         return INVALID_ALGORITHM;
+    }
+
+    while (result == HASH_COMPUTED && offset < message_len)
+    {
+        chunk_len = CHUNK_LENS[chunk++ % 9];
+
+        if (chunk_len > message_len - offset)
+            chunk_len = message_len - offset;
+
+        switch (algorithm)
+        {
+            case SHA1:
+                result = sha1_update(&ctx.sha1, message + offset, chunk_len);
+                break;
+            case SHA224:
+            case SHA256:
+                result = sha256_update(&ctx.sha256, message + offset, chunk_len);
+                break;
+            default:
+                result = sha512_update(&ctx.sha512, message + offset, chunk_len);
+                break;
+        }
+
+        offset += chunk_len;
+    }
+
+    if (result != HASH_COMPUTED)
+        return result;
+
+    switch (algorithm)
+    {
+        case SHA1:       return sha1_final(&ctx.sha1, digest, format);
+        case SHA224:     return sha224_final(&ctx.sha256, digest, format);
+        case SHA256:     return sha256_final(&ctx.sha256, digest, format);
+        case SHA384:     return sha384_final(&ctx.sha512, digest, format);
+        case SHA512:     return sha512_final(&ctx.sha512, digest, format);
+        case SHA512_224: return sha512_224_final(&ctx.sha512, digest, format);
+        default:         return sha512_256_final(&ctx.sha512, digest, format);
+    }
+}
+
+static void
+digest_all_algorithms(
+    uint8_t * digests,
+    const uint8_t * const * messages,
+    const uint64_t * message_lens
+)
+{
+    static const hasher_t HASHERS[7] = 
+        { sha1, sha224, sha256, sha384, sha512, sha512_224, sha512_256 };
+    static const batch_hasher_t BATCH_HASHERS[7] = 
+        { sha1_batch, sha224_batch, sha256_batch, sha384_batch, 
+          sha512_batch, sha512_224_batch, sha512_256_batch };
+
+    // One-shot digests, then the same messages as a batch, at a fixed stride
+    for (int a = 0; a < 7; ++a)
+    {
+        for (int i = 0; i < BACKEND_TEST_MESSAGES; ++i, digests += SHA512_DIGEST_LEN)
+            HASHERS[a](digests, messages[i], message_lens[i], OCTET_ARRAY);
+
+        BATCH_HASHERS[a](digests, messages, message_lens, BACKEND_TEST_MESSAGES, OCTET_ARRAY);
+        digests += BACKEND_TEST_MESSAGES * SHA512_DIGEST_LEN;
+    }
+}
+
+// Shared by scalar_reference() and matches_reference()
+static uint8_t backend_data[4096];
+static uint8_t backend_expected[14 * BACKEND_TEST_MESSAGES * SHA512_DIGEST_LEN];
+static uint8_t backend_actual[14 * BACKEND_TEST_MESSAGES * SHA512_DIGEST_LEN];
+
+static bool
+scalar_reference(const uint8_t ** messages, uint64_t * message_lens)
+{
+    uint64_t seed = UINT64_C(0x9e3779b97f4a7c15);
+
+    for (size_t i = 0; i < sizeof(backend_data); ++i)
+        backend_data[i] = (uint8_t)next_random(&seed);
+
+    for (int i = 0; i < BACKEND_TEST_MESSAGES; ++i)
+    {
+        messages[i] = backend_data + i;
+        message_lens[i] = (uint64_t)(i * 197) % 4000;
+    }
+
+    memset(backend_expected, 0, sizeof(backend_expected));
+
+    if (sha_set_backend(BACKEND_SCALAR) != HASH_COMPUTED)
+        return false;
+
+    digest_all_algorithms(backend_expected, messages, message_lens);
+
+    return true;
+}
+
+static bool
+matches_reference(const uint8_t * const * messages, const uint64_t * message_lens)
+{
+    memset(backend_actual, 0, sizeof(backend_actual));
+    digest_all_algorithms(backend_actual, messages, message_lens);
+
+    return !memcmp(backend_expected, backend_actual, sizeof(backend_expected));
+}
+
+static ShaComputationResult
+context_init(ShaType algorithm, any_ctx * ctx)
+{
+    switch (algorithm)
+    {
+        case SHA1:       return sha1_init(&ctx->sha1);
+        case SHA224:     return sha224_init(&ctx->sha256);
+        case SHA256:     return sha256_init(&ctx->sha256);
+        case SHA384:     return sha384_init(&ctx->sha512);
+        case SHA512:     return sha512_init(&ctx->sha512);
+        case SHA512_224: return sha512_224_init(&ctx->sha512);
+        case SHA512_256: return sha512_256_init(&ctx->sha512);
+        default:         return INVALID_ALGORITHM;
+    }
+}
+
+static ShaComputationResult
+context_final(ShaType algorithm, any_ctx * ctx, uint8_t * digest, const ShaDigestFormat format)
+{
+    switch (algorithm)
+    {
+        case SHA1:       return sha1_final(&ctx->sha1, digest, format);
+        case SHA224:     return sha224_final(&ctx->sha256, digest, format);
+        case SHA256:     return sha256_final(&ctx->sha256, digest, format);
+        case SHA384:     return sha384_final(&ctx->sha512, digest, format);
+        case SHA512:     return sha512_final(&ctx->sha512, digest, format);
+        case SHA512_224: return sha512_224_final(&ctx->sha512, digest, format);
+        default:         return sha512_256_final(&ctx->sha512, digest, format);
+    }
+}
+
+static ShaComputationResult
+context_suffix(
+    ShaType algorithm,
+    const any_ctx * ctx,
+    uint8_t * digest,
+    const uint8_t * suffix,
+    const uint64_t suffix_len,
+    const ShaDigestFormat format
+)
+{
+    switch (algorithm)
+    {
+        case SHA1:       return sha1_suffix(&ctx->sha1, digest, suffix, suffix_len, format);
+        case SHA224:     return sha224_suffix(&ctx->sha256, digest, suffix, suffix_len, format);
+        case SHA256:     return sha256_suffix(&ctx->sha256, digest, suffix, suffix_len, format);
+        case SHA384:     return sha384_suffix(&ctx->sha512, digest, suffix, suffix_len, format);
+        case SHA512:     return sha512_suffix(&ctx->sha512, digest, suffix, suffix_len, format);
+        case SHA512_224: return sha512_224_suffix(&ctx->sha512, digest, suffix, suffix_len, format);
+        default:         return sha512_256_suffix(&ctx->sha512, digest, suffix, suffix_len, format);
+    }
+}
+
+static ShaComputationResult
+context_suffix_batch(
+    ShaType algorithm,
+    const any_ctx * ctx,
+    uint8_t * digests,
+    const uint8_t * const * suffixes,
+    const uint64_t * suffix_lens,
+    const size_t count,
+    const ShaDigestFormat format
+)
+{
+    switch (algorithm)
+    {
+        case SHA1:
+            return sha1_suffix_batch(&ctx->sha1, digests, suffixes, suffix_lens, count, format);
+        case SHA224:
+            return sha224_suffix_batch(&ctx->sha256, digests, suffixes, suffix_lens, count, format);
+        case SHA256:
+            return sha256_suffix_batch(&ctx->sha256, digests, suffixes, suffix_lens, count, format);
+        case SHA384:
+            return sha384_suffix_batch(&ctx->sha512, digests, suffixes, suffix_lens, count, format);
+        case SHA512:
+            return sha512_suffix_batch(&ctx->sha512, digests, suffixes, suffix_lens, count, format);
+        case SHA512_224:
+            return sha512_224_suffix_batch(&ctx->sha512, digests, suffixes, suffix_lens, count, format);
+        default:
+            return sha512_256_suffix_batch(&ctx->sha512, digests, suffixes, suffix_lens, count, format);
+    }
+}
+
+static ShaComputationResult
+context_update(ShaType algorithm, any_ctx * ctx, const uint8_t * message, const uint64_t message_len)
+{
+    switch (algorithm)
+    {
+        case SHA1:       return sha1_update(&ctx->sha1, message, message_len);
+        case SHA224:     return sha224_update(&ctx->sha256, message, message_len);
+        case SHA256:     return sha256_update(&ctx->sha256, message, message_len);
+        case SHA384:     return sha384_update(&ctx->sha512, message, message_len);
+        case SHA512:     return sha512_update(&ctx->sha512, message, message_len);
+        case SHA512_224: return sha512_224_update(&ctx->sha512, message, message_len);
+        default:         return sha512_256_update(&ctx->sha512, message, message_len);
+    }
+}
+
+static ShaComputationResult
+context_update_copy(
+    ShaType algorithm,
+    any_ctx * ctx,
+    uint8_t * destination,
+    const uint8_t * message,
+    const uint64_t message_len
+)
+{
+    switch (algorithm)
+    {
+        case SHA1:       return sha1_update_copy(&ctx->sha1, destination, message, message_len);
+        case SHA224:     return sha224_update_copy(&ctx->sha256, destination, message, message_len);
+        case SHA256:     return sha256_update_copy(&ctx->sha256, destination, message, message_len);
+        case SHA384:     return sha384_update_copy(&ctx->sha512, destination, message, message_len);
+        case SHA512:     return sha512_update_copy(&ctx->sha512, destination, message, message_len);
+        case SHA512_224: return sha512_224_update_copy(&ctx->sha512, destination, message, message_len);
+        default:         return sha512_256_update_copy(&ctx->sha512, destination, message, message_len);
+    }
+}
+
+static ShaComputationResult
+context_final_verify(ShaType algorithm, any_ctx * ctx, const uint8_t * expected, const ShaDigestFormat format)
+{
+    switch (algorithm)
+    {
+        case SHA1:       return sha1_final_verify(&ctx->sha1, expected, format);
+        case SHA224:     return sha224_final_verify(&ctx->sha256, expected, format);
+        case SHA256:     return sha256_final_verify(&ctx->sha256, expected, format);
+        case SHA384:     return sha384_final_verify(&ctx->sha512, expected, format);
+        case SHA512:     return sha512_final_verify(&ctx->sha512, expected, format);
+        case SHA512_224: return sha512_224_final_verify(&ctx->sha512, expected, format);
+        default:         return sha512_256_final_verify(&ctx->sha512, expected, format);
+    }
+}
+
+static ShaComputationResult
+context_peek(ShaType algorithm, const any_ctx * ctx, uint8_t * digest, const ShaDigestFormat format)
+{
+    switch (algorithm)
+    {
+        case SHA1:       return sha1_peek(&ctx->sha1, digest, format);
+        case SHA224:     return sha224_peek(&ctx->sha256, digest, format);
+        case SHA256:     return sha256_peek(&ctx->sha256, digest, format);
+        case SHA384:     return sha384_peek(&ctx->sha512, digest, format);
+        case SHA512:     return sha512_peek(&ctx->sha512, digest, format);
+        case SHA512_224: return sha512_224_peek(&ctx->sha512, digest, format);
+        default:         return sha512_256_peek(&ctx->sha512, digest, format);
+    }
+}
+
+static ShaComputationResult
+context_export(ShaType algorithm, const any_ctx * ctx, uint8_t * state)
+{
+    switch (algorithm)
+    {
+        case SHA1:       return sha1_export(&ctx->sha1, state);
+        case SHA224:     return sha224_export(&ctx->sha256, state);
+        case SHA256:     return sha256_export(&ctx->sha256, state);
+        case SHA384:     return sha384_export(&ctx->sha512, state);
+        case SHA512:     return sha512_export(&ctx->sha512, state);
+        case SHA512_224: return sha512_224_export(&ctx->sha512, state);
+        default:         return sha512_256_export(&ctx->sha512, state);
+    }
+}
+
+static ShaComputationResult
+context_import(ShaType algorithm, any_ctx * ctx, const uint8_t * state, const size_t state_len)
+{
+    switch (algorithm)
+    {
+        case SHA1:       return sha1_import(&ctx->sha1, state, state_len);
+        case SHA224:     return sha224_import(&ctx->sha256, state, state_len);
+        case SHA256:     return sha256_import(&ctx->sha256, state, state_len);
+        case SHA384:     return sha384_import(&ctx->sha512, state, state_len);
+        case SHA512:     return sha512_import(&ctx->sha512, state, state_len);
+        case SHA512_224: return sha512_224_import(&ctx->sha512, state, state_len);
+        default:         return sha512_256_import(&ctx->sha512, state, state_len);
+    }
+}
+
+static bool
+rejects_corrupted_state(ShaType algorithm, const uint8_t * state, const size_t state_len)
+{
+    // Offsets of the magic, version, algorithm and reserved header bytes
+    static const size_t CORRUPTED_BYTES[4] = { 0, 4, 5, 6 };
+
+    uint8_t corrupted[SHA512_STATE_LEN];
+    any_ctx ctx;
+
+    // Wrong length
+    if (context_import(algorithm, &ctx, state, state_len - 1) != INVALID_CONTEXT_STATE)
+    {
+        printf(STATE_ACCEPTED, 0);
+        return false;
+    }
+
+    // Damaged header fields
+    for (int i = 0; i < 4; ++i)
+    {
+        memcpy(corrupted, state, state_len);
+        corrupted[CORRUPTED_BYTES[i]] ^= 0x01;
+
+        if (context_import(algorithm, &ctx, corrupted, state_len) != INVALID_CONTEXT_STATE)
+        {
+            printf(STATE_ACCEPTED, i + 1);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static ShaComputationResult
+scatter_hash(
+    iov_hasher_t hash_function,
+    ShaType algorithm,
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    // Segment lengths chosen to straddle block boundaries in every possible
+    // way, with empty segments mixed in
+    static const uint64_t SEGMENT_LENS[10] = { 0, 1, 3, 63, 64, 65, 127, 128, 129, 1000 };
+
+    struct iovec * segments = malloc((message_len + 1) * sizeof(struct iovec));
+    uint8_t generic[HEX_DIGEST_BUFFER_LEN];
+    ShaComputationResult result;
+    uint64_t offset = 0, segment_len;
+    int count = 0;
+
+    if (!segments)
+        return NULL_MESSAGE_POINTER;
+
+    while (offset < message_len)
+    {
+        segment_len = SEGMENT_LENS[count % 10];
+
+        if (segment_len > message_len - offset)
+            segment_len = message_len - offset;
+
+        segments[count].iov_base = (void *)(message + offset);
+        segments[count++].iov_len = (size_t)segment_len;
+        offset += segment_len;
+    }
+
+    result = hash_function(digest, segments, count, format);
+
+    // The generic entry point must agree
+    if (result == HASH_COMPUTED)
+    {
+        result = sha_iov(algorithm, generic, segments, count, format);
+
+        if (result == HASH_COMPUTED && memcmp(generic, digest, DIGEST_LENS[algorithm]))
+            result = INVALID_ALGORITHM;
+    }
+
+    free(segments);
+    return result;
+}
+
+static ShaComputationResult
+copy_hash(
+    copy_hasher_t hash_function,
+    ShaType algorithm,
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    // Chunk lengths for the streaming copy, straddling block and copy-run boundaries
+    static const uint64_t CHUNK_LENS[8] = { 0, 1, 63, 64, 65, 128, 4095, 5000 };
+
+    uint8_t * destination = malloc(message_len + 1);
+    uint8_t other[HEX_DIGEST_BUFFER_LEN];
+    ShaComputationResult result;
+    uint64_t offset = 0, chunk_len;
+    any_ctx ctx;
+    int chunk = 0;
+
+    if (!destination)
+        return NULL_MESSAGE_POINTER;
+
+    // Mismatched digests or copies are reported as INVALID_ALGORITHM
+    memset(destination, 0, message_len + 1);
+    result = hash_function(digest, destination, message, message_len, format);
+
+    if (result == HASH_COMPUTED && memcmp(destination, message, message_len))
+        result = INVALID_ALGORITHM;
+
+    // The generic entry point must agree
+    if (result == HASH_COMPUTED)
+    {
+        memset(destination, 0, message_len + 1);
+        result = sha_copy(algorithm, other, destination, message, message_len, format);
+
+        if (result == HASH_COMPUTED && (memcmp(other, digest, DIGEST_LENS[algorithm]) 
+                || memcmp(destination, message, message_len)))
+            result = INVALID_ALGORITHM;
+    }
+
+    // So must the streaming version, fed in chunks of varying length
+    if (result == HASH_COMPUTED)
+    {
+        memset(destination, 0, message_len + 1);
+        context_init(algorithm, &ctx);
+
+        while (offset < message_len && result == HASH_COMPUTED)
+        {
+            chunk_len = CHUNK_LENS[chunk++ % 8];
+
+            if (chunk_len > message_len - offset)
+                chunk_len = message_len - offset;
+
+            result = context_update_copy(algorithm, &ctx, destination + offset, message + offset, chunk_len);
+            offset += chunk_len;
+        }
+
+        if (result == HASH_COMPUTED)
+            result = context_final(algorithm, &ctx, other, format);
+
+        if (result == HASH_COMPUTED && (memcmp(other, digest, DIGEST_LENS[algorithm]) 
+                || memcmp(destination, message, message_len) || destination[message_len]))
+            result = INVALID_ALGORITHM;
+    }
+
+    free(destination);
+    return result;
+}
+
+static ShaComputationResult
+verify_hash(
+    verifier_t verify_function,
+    ShaType algorithm,
+    const uint8_t * expected,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    size_t expected_len = (format == OCTET_ARRAY) ? DIGEST_LENS[algorithm] : DIGEST_LENS[algorithm] * 2;
+    uint8_t wrong[3][HEX_DIGEST_BUFFER_LEN];
+    const uint8_t * messages[3] = { message, message, message };
+    uint64_t message_lens[3] = { message_len, message_len, message_len };
+    ShaComputationResult statuses[3];
+    any_ctx ctx;
+
+    // Mismatched verdicts are reported as INVALID_ALGORITHM
+    ShaComputationResult result = verify_function(message, message_len, expected, format);
+
+    if (result == HASH_COMPUTED && sha_verify(algorithm, message, message_len, expected, format) != HASH_COMPUTED)
+        result = INVALID_ALGORITHM;
+
+    if (result == HASH_COMPUTED)
+    {
+        context_init(algorithm, &ctx);
+        context_update(algorithm, &ctx, message, message_len);
+        result = context_final_verify(algorithm, &ctx, expected, format);
+    }
+
+    // The last digit (or byte) altered, and for hex a non-hex digit, must not match
+    memcpy(wrong[0], expected, expected_len);
+    wrong[0][expected_len - 1] ^= (format == OCTET_ARRAY) ? 0x01 : 0x03;
+    memcpy(wrong[2], expected, expected_len);
+    wrong[2][0] = (format == OCTET_ARRAY) ? (uint8_t)(wrong[2][0] ^ 0x80) : 'g';
+
+    if (result == HASH_COMPUTED && (verify_function(message, message_len, wrong[0], format) != DIGEST_MISMATCH
+            || verify_function(message, message_len, wrong[2], format) != DIGEST_MISMATCH))
+        result = INVALID_ALGORITHM;
+
+    if (result == HASH_COMPUTED)
+    {
+        context_init(algorithm, &ctx);
+        context_update(algorithm, &ctx, message, message_len);
+
+        if (context_final_verify(algorithm, &ctx, wrong[0], format) != DIGEST_MISMATCH)
+            result = INVALID_ALGORITHM;
+    }
+
+    // As a batch, only the middle message's expected digest is wrong
+    memcpy(wrong[1], wrong[0], expected_len);
+    memcpy(wrong[0], expected, expected_len);
+    memcpy(wrong[2], expected, expected_len);
+
+    if (result == HASH_COMPUTED)
+    {
+        uint8_t packed[3 * HEX_DIGEST_BUFFER_LEN];
+        size_t stride = (format == OCTET_ARRAY) ? expected_len : expected_len + 1;
+
+        for (int i = 0; i < 3; ++i)
+            memcpy(packed + i * stride, wrong[i], expected_len);
+
+        if (sha_verify_batch(algorithm, messages, message_lens, 3, packed, format, statuses) != DIGEST_MISMATCH
+                || statuses[0] != HASH_COMPUTED || statuses[1] != DIGEST_MISMATCH || statuses[2] != HASH_COMPUTED)
+            result = INVALID_ALGORITHM;
+    }
+
+    return result;
+}
+
+static ShaComputationResult
+checkpoint_hash(
+    ShaType algorithm,
+    uint8_t * digest,
+    const uint8_t * message,
+    const uint64_t message_len,
+    const ShaDigestFormat format
+)
+{
+    // Chunk lengths chosen to straddle block boundaries in every possible way
+    static const uint64_t CHUNK_LENS[9] = { 1, 3, 63, 64, 65, 127, 128, 129, 1000 };
+
+    // Peeks checked against a one-shot digest of the prefix (bounds run time)
+    static const int CHECKED_PEEKS = 24;
+
+    any_ctx ctx[2];
+    uint8_t state[SHA512_STATE_LEN];
+    uint8_t peeked[SHA512_DIGEST_LEN], expected[SHA512_DIGEST_LEN];
+    ShaComputationResult result;
+    uint64_t offset = 0, chunk_len;
+    int chunk = 0, live = 0;
+
+    result = context_init(algorithm, &ctx[0]);
+
+    do
+    {
+        chunk_len = CHUNK_LENS[chunk % 9];
+
+        if (chunk_len > message_len - offset)
+            chunk_len = message_len - offset;
+
+        if (result == HASH_COMPUTED)
+            result = context_update(algorithm, &ctx[live], message + offset, chunk_len);
+
+        offset += chunk_len;
+
+        // Peeking must not disturb the context
+        if (result == HASH_COMPUTED && chunk < CHECKED_PEEKS)
+        {
+            result = context_peek(algorithm, &ctx[live], peeked, OCTET_ARRAY);
+            sha(algorithm, expected, message, offset, OCTET_ARRAY);
+
+            if (result == HASH_COMPUTED && memcmp(peeked, expected, DIGEST_LENS[algorithm]))
+            {
+                printf(PEEK_MISMATCH, (unsigned long long)offset);
+                return INVALID_CONTEXT_STATE;
+            }
+        }
+
+        // Carry on from an exported copy in the other context
+        if (result == HASH_COMPUTED)
+            result = context_export(algorithm, &ctx[live], state);
+
+        if (result == HASH_COMPUTED && chunk == 0 &&
+            !rejects_corrupted_state(algorithm, state, STATE_LENS[algorithm]))
+            return INVALID_CONTEXT_STATE;
+
+        if (result == HASH_COMPUTED)
+        {
+            memset(&ctx[1 - live], 0xa5, sizeof(any_ctx));
+            live = 1 - live;
+            result = context_import(algorithm, &ctx[live], state, STATE_LENS[algorithm]);
+        }
+
+        ++chunk;
+
+    } while (result == HASH_COMPUTED && offset < message_len);
+
+    if (result != HASH_COMPUTED)
+        return result;
+
+    return context_final(algorithm, &ctx[live], digest, format);
+}
+
+static size_t
+reference_encode(char * encoded, const uint8_t * raw, const size_t raw_len, const ShaDigestFormat format)
+{
+    const char * digits = format == HEX_STRING_UPPER ? "0123456789ABCDEF" : "0123456789abcdef";
+    const char * alphabet = format == BASE64URL
+        ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+        : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    uint32_t bits = 0;
+    int bit_count = 0;
+    size_t n = 0;
+
+    if (format == HEX_STRING_LOWER || format == HEX_STRING_UPPER)
+    {
+        for (size_t i = 0; i < raw_len; ++i)
+        {
+            encoded[n++] = digits[raw[i] / 16];
+            encoded[n++] = digits[raw[i] % 16];
+        }
+    }
+    else
+    {
+        // Six bits at a time off the front of a bit queue, the last sextet zero-filled
+        for (size_t i = 0; i < raw_len; ++i)
+        {
+            bits = (bits << 8) | raw[i];
+            bit_count += 8;
+
+            while (bit_count >= 6)
+            {
+                bit_count -= 6;
+                encoded[n++] = alphabet[(bits >> bit_count) & 0x3f];
+            }
+        }
+
+        if (bit_count)
+            encoded[n++] = alphabet[(bits << (6 - bit_count)) & 0x3f];
+
+        while (format == BASE64 && n % 4)
+            encoded[n++] = '=';
+    }
+
+    encoded[n] = '\0';
+
+    return n;
 }
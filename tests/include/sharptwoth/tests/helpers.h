@@ -5,10 +5,14 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "sharptwoth/sharptwoth.h"
+#include "sharptwoth/internal.h"
 
 #define NUM_TESTS 5
 #define HEX_DIGEST_BUFFER_LEN 129
 
+// Exit code reported when a test does not apply to the host (e.g. missing ISA)
+#define TEST_SKIPPED 77
+
 // HashDigests
 // Structure for capturing multiple formats of a single message digest
 typedef struct HashDigests
@@ -54,6 +58,65 @@ TestContext_Run(TestContext * context, hasher_t hash_function);
 bool
 TestContext_RunGeneric(TestContext * context, ShaType algorithm);
 
+// TestContext_RunStreaming()
+// Executes test instance with an algorithm's init/update/final functions,
+// feeding the message in chunks of varying length
+bool
+TestContext_RunStreaming(TestContext * context, ShaType algorithm);
+
+// iov_hasher_t
+// Function-pointer type that matches the scatter/gather hashing functions' signatures
+typedef ShaComputationResult (* iov_hasher_t)(
+    uint8_t *,
+    const struct iovec *,
+    const int,
+    const ShaDigestFormat
+);
+
+// TestContext_RunScatterGather()
+// Executes test instance with one of the scatter/gather hashing functions, splitting
+// the message into segments of varying length, and checks sha_iov() agrees
+bool
+TestContext_RunScatterGather(TestContext * context, iov_hasher_t hash_function, ShaType algorithm);
+
+// copy_hasher_t
+// Function-pointer type that matches the copy-and-hash functions' signatures
+typedef ShaComputationResult (* copy_hasher_t)(
+    uint8_t *,
+    uint8_t *,
+    const uint8_t *,
+    const uint64_t,
+    const ShaDigestFormat
+);
+
+// TestContext_RunCopy()
+// Executes test instance with one of the copy-and-hash functions, checking the copy
+// as well as the digest, and checks sha_copy() and the streaming version agree
+bool
+TestContext_RunCopy(TestContext * context, copy_hasher_t hash_function, ShaType algorithm);
+
+// verifier_t
+// Function-pointer type that matches the verify functions' signatures
+typedef ShaComputationResult (* verifier_t)(
+    const uint8_t *,
+    const uint64_t,
+    const uint8_t *,
+    const ShaDigestFormat
+);
+
+// TestContext_RunVerify()
+// Executes test instance with one of the verify functions against the expected digest
+// in every format, checks that altered or malformed expected digests are rejected, and
+// checks sha_verify(), the streaming-final version and sha_verify_batch() agree
+bool
+TestContext_RunVerify(TestContext * context, verifier_t verify_function, ShaType algorithm);
+
+// TestContext_RunCheckpointed()
+// Executes test instance like TestContext_RunStreaming(), but peeks after
+// each chunk and carries on from an exported and re-imported copy of the context
+bool
+TestContext_RunCheckpointed(TestContext * context, ShaType algorithm);
+
 // TestContext_Free()
 // Releases RAM used by TestContext instance
 void
@@ -64,4 +127,171 @@ TestContext_Free(TestContext * context);
 bool
 load_expected_digests(char hashes[NUM_TESTS][HEX_DIGEST_BUFFER_LEN], ShaType algorithm);
 
+// kernels_match_32()
+// Checks a 32-bit-word compression kernel against a reference kernel
+// over pseudo-random chaining values and runs of 0..KERNEL_TEST_BLOCKS blocks
+bool
+kernels_match_32(
+    compressor_32_t reference,
+    compressor_32_t candidate,
+    const uint8_t word_count
+);
+
+// kernels_match_64()
+// Checks a 64-bit-word compression kernel against a reference kernel
+// over pseudo-random chaining values and runs of 0..KERNEL_TEST_BLOCKS blocks
+bool
+kernels_match_64(
+    compressor_64_t reference,
+    compressor_64_t candidate
+);
+
+// mb_kernel_matches_32()
+// Checks every lane of a multi-buffer kernel against a single-stream reference
+// kernel, with each lane carrying its own chaining value and message blocks
+bool
+mb_kernel_matches_32(
+    compressor_32_t reference,
+    mb_compressor_32_t candidate,
+    const uint8_t word_count
+);
+
+// mb_engine_matches_32()
+// Runs messages of assorted lengths through the multi-buffer lane scheduler
+// with the given kernel and checks each result against the scalar kernel
+bool
+mb_engine_matches_32(
+    compressor_32_t reference,
+    mb_compressor_32_t candidate,
+    const uint8_t word_count
+);
+
+// mb_kernel_matches_64()
+// Checks every lane of a multi-buffer kernel against a single-stream reference
+// kernel, with each lane carrying its own chaining value and message blocks
+bool
+mb_kernel_matches_64(
+    compressor_64_t reference,
+    mb_compressor_64_t candidate
+);
+
+// mb_engine_matches_64()
+// Runs messages of assorted lengths, each with its own initial hash, through
+// the multi-buffer lane scheduler and checks each result against the scalar kernel
+bool
+mb_engine_matches_64(
+    compressor_64_t reference,
+    mb_compressor_64_t candidate
+);
+
+// batch_hasher_t
+// Function-pointer type that matches the batch hashing functions' signatures
+typedef ShaComputationResult (* batch_hasher_t)(
+    uint8_t *,
+    const uint8_t * const *,
+    const uint64_t *,
+    const size_t,
+    const ShaDigestFormat
+);
+
+// batch_matches_single()
+// Hashes a batch of pseudo-random messages of assorted lengths and checks
+// every digest, in every format, against the one-shot hashing function
+bool
+batch_matches_single(
+    batch_hasher_t batch_function,
+    hasher_t hash_function,
+    const uint8_t digest_len
+);
+
+// backend_matches_scalar()
+// Hashes pseudo-random messages with every algorithm, one-shot and batched,
+// under the portable kernels and again under the given backend, and checks
+// that the digests agree (leaves the library on BACKEND_AUTO)
+bool
+backend_matches_scalar(const ShaBackend backend);
+
+// tuning_matches_scalar()
+// Runs the autotuner with the given cache file and checks that the kernels it
+// binds produce the same digests as the portable ones (leaves the library on BACKEND_AUTO)
+bool
+tuning_matches_scalar(const char * cache_path);
+
+// generic_batch_matches_single()
+// Runs a batch mixing every size bucket and some invalid messages through sha_batch()
+// and checks each status, each digest against sha(), and that rejected messages
+// leave their digest slots untouched
+bool
+generic_batch_matches_single(ShaType algorithm);
+
+// midstate_matches_single()
+// Absorbs prefixes of assorted lengths into a context, hashes many suffixes from it
+// one at a time and as a batch, under the default and AVX2 backends, and checks every
+// digest, in every format, against streaming prefix and suffix through a copy
+// (leaves the library on BACKEND_AUTO)
+bool
+midstate_matches_single(ShaType algorithm);
+
+// manager_matches_streaming()
+// Interleaves many streams through a sha_manager, in chunks of assorted lengths with
+// some streams submitting back to back, under the default and multi-buffer backends,
+// and checks each stream's digest against the one-shot function
+// (leaves the library on BACKEND_AUTO)
+bool
+manager_matches_streaming(ShaType algorithm);
+
+// job_matches_single()
+// Hashes messages of assorted lengths as jobs stepped under assorted block budgets,
+// checking that no step exceeds its budget and every digest matches sha()
+bool
+job_matches_single(ShaType algorithm);
+
+// multi_matches_single()
+// Hashes messages of assorted lengths with sets of algorithms in one pass, under the
+// portable, default and multi-buffer backends, and checks every digest against sha()
+// (leaves the library on BACKEND_AUTO)
+bool
+multi_matches_single(void);
+
+// encoding_matches_reference()
+// Encodes pseudo-random bytes of every length up to ENCODING_TEST_MAX_LEN in each text
+// format, checks size, text and terminator against a bit-at-a-time reference, decodes
+// them back, and checks that malformed and non-canonical text is rejected
+bool
+encoding_matches_reference(void);
+
+// encoded_digests_match()
+// Checks base64 and base64url digests of a known message against published strings,
+// verifies against them, and checks that encoding a raw batch afterwards matches the
+// batch functions' own encoding in every text format
+bool
+encoded_digests_match(void);
+
+// short_messages_match_streaming()
+// Hashes messages of every length up to two blocks, one at a time and as equal-length
+// batches, under every backend the host supports, and checks each digest against the
+// streaming interface (which never takes the fixed-length paths)
+// (leaves the library on BACKEND_AUTO)
+bool
+short_messages_match_streaming(void);
+
+// sha256d_matches_double_sha256()
+// Checks sha256d() against published digests and against two sha256() calls for every
+// length up to 300 bytes, and sha256d_batch() against sha256d() for a batch of mixed
+// lengths, under every backend the host supports, then checks argument validation
+// (leaves the library on BACKEND_AUTO)
+bool
+sha256d_matches_double_sha256(void);
+
+#define KERNEL_TEST_BLOCKS 37
+#define BATCH_TEST_MESSAGES 150
+#define BACKEND_TEST_MESSAGES 20
+#define MIDSTATE_TEST_SUFFIXES 40
+#define GENERIC_BATCH_MESSAGES 200
+#define MANAGER_TEST_STREAMS 40
+#define MANAGER_TEST_ROUNDS 12
+#define ENCODING_TEST_MAX_LEN 100
+#define SHORT_TEST_MESSAGES 19
+#define SHA256D_TEST_MESSAGES 75
+
 #endif // SHARP2TH_TESTS_HELPERS_H
@@ -0,0 +1,43 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include "sharptwoth/tests/helpers.h"
+
+static const char * CACHE_PATH = "./autotune_cache.txt";
+
+static int
+cache_lines(void)
+{
+    FILE * cache = fopen(CACHE_PATH, "r");
+    int lines = 0, c;
+
+    if (!cache)
+        return 0;
+
+    while ((c = fgetc(cache)) != EOF)
+        lines += (c == '\n');
+
+    fclose(cache);
+    return lines;
+}
+
+int main()
+{
+    bool success = true;
+
+    remove(CACHE_PATH);
+
+    // First run measures and writes one line for this CPU model
+    success = success && tuning_matches_scalar(CACHE_PATH);
+    success = success && cache_lines() == 1;
+
+    // Second run reuses the cached decisions instead of appending
+    success = success && tuning_matches_scalar(CACHE_PATH);
+    success = success && cache_lines() == 1;
+
+    // Without a cache path nothing is written
+    success = success && tuning_matches_scalar(NULL);
+
+    remove(CACHE_PATH);
+
+    return success ? 0 : -1;
+}
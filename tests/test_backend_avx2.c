@@ -0,0 +1,22 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+#ifdef SHARP2TH_X86
+    if (!(cpu_features() & CPU_FEATURE_AVX2))
+        return TEST_SKIPPED;
+
+    bool success = true;
+
+    success = success && kernels_match_64(compress_512_scalar, compress_512_avx2);
+    success = success && mb_kernel_matches_32(compress_160_scalar, compress_160x8_avx2, 5);
+    success = success && mb_engine_matches_32(compress_160_scalar, compress_160x8_avx2, 5);
+    success = success && mb_kernel_matches_32(compress_256_scalar, compress_256x8_avx2, 8);
+    success = success && mb_engine_matches_32(compress_256_scalar, compress_256x8_avx2, 8);
+
+    return success ? 0 : -1;
+#else
+    return TEST_SKIPPED;
+#endif
+}
@@ -0,0 +1,19 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+#ifdef SHARP2TH_X86
+    if (!(cpu_features() & CPU_FEATURE_AVX512))
+        return TEST_SKIPPED;
+
+    bool success = true;
+
+    success = success && mb_kernel_matches_64(compress_512_scalar, compress_512x8_avx512);
+    success = success && mb_engine_matches_64(compress_512_scalar, compress_512x8_avx512);
+
+    return success ? 0 : -1;
+#else
+    return TEST_SKIPPED;
+#endif
+}
@@ -0,0 +1,26 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    static const ShaBackend BACKENDS[5] = 
+        { BACKEND_SSSE3, BACKEND_AVX2, BACKEND_AVX512, BACKEND_SHA_NI, BACKEND_AUTO };
+
+    // Start from automatic selection whatever SHARPTWOTH_BACKEND says
+    bool success = sha_set_backend(BACKEND_AUTO) == HASH_COMPUTED;
+
+    // Unknown backends are refused
+    success = success && sha_set_backend((ShaBackend)99) == UNSUPPORTED_BACKEND;
+    success = success && sha_get_backend() == BACKEND_AUTO;
+
+    for (int b = 0; b < 5 && success; ++b)
+    {
+        // Backends the host cannot run are refused and leave the binding alone
+        if (sha_set_backend(BACKENDS[b]) != HASH_COMPUTED)
+            continue;
+
+        success = backend_matches_scalar(BACKENDS[b]);
+    }
+
+    return success ? 0 : -1;
+}
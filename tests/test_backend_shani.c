@@ -0,0 +1,21 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+#ifdef SHARP2TH_X86
+    uint32_t shani = CPU_FEATURE_SHA | CPU_FEATURE_SSSE3 | CPU_FEATURE_SSE41;
+
+    if ((cpu_features() & shani) != shani)
+        return TEST_SKIPPED;
+
+    bool success = true;
+
+    success = success && kernels_match_32(compress_160_scalar, compress_160_shani, 5);
+    success = success && kernels_match_32(compress_256_scalar, compress_256_shani, 8);
+
+    return success ? 0 : -1;
+#else
+    return TEST_SKIPPED;
+#endif
+}
@@ -0,0 +1,19 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+#ifdef SHARP2TH_X86
+    if (!(cpu_features() & CPU_FEATURE_SSSE3))
+        return TEST_SKIPPED;
+
+    bool success = true;
+
+    success = success && kernels_match_32(compress_160_scalar, compress_160_ssse3, 5);
+    success = success && kernels_match_32(compress_256_scalar, compress_256_ssse3, 8);
+
+    return success ? 0 : -1;
+#else
+    return TEST_SKIPPED;
+#endif
+}
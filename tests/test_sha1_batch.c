@@ -0,0 +1,9 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    bool success = batch_matches_single(sha1_batch, sha1, SHA1_DIGEST_LEN);
+
+    return success ? 0 : -1;
+}
@@ -0,0 +1,9 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    bool success = midstate_matches_single(SHA1);
+
+    return success ? 0 : -1;
+}
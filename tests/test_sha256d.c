@@ -0,0 +1,11 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    bool success = true;
+
+    success = success && sha256d_matches_double_sha256();
+
+    return success ? 0 : -1;
+}
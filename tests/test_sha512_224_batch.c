@@ -0,0 +1,9 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    bool success = batch_matches_single(sha512_224_batch, sha512_224, SHA512_224_DIGEST_LEN);
+
+    return success ? 0 : -1;
+}
@@ -0,0 +1,9 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    bool success = batch_matches_single(sha512_256_batch, sha512_256, SHA512_256_DIGEST_LEN);
+
+    return success ? 0 : -1;
+}
@@ -0,0 +1,9 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    bool success = batch_matches_single(sha512_batch, sha512, SHA512_DIGEST_LEN);
+
+    return success ? 0 : -1;
+}
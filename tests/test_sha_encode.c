@@ -0,0 +1,12 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    bool success = true;
+
+    success = success && encoding_matches_reference();
+    success = success && encoded_digests_match();
+
+    return success ? 0 : -1;
+}
@@ -0,0 +1,12 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    bool success = true;
+
+    for (int a = SHA1; a <= SHA512_256; ++a)
+        success = job_matches_single((ShaType)a) && success;
+
+    return success ? 0 : -1;
+}
@@ -0,0 +1,7 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    return multi_matches_single() ? 0 : -1;
+}
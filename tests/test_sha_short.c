@@ -0,0 +1,11 @@
+#include <stdbool.h>
+#include "sharptwoth/tests/helpers.h"
+
+int main()
+{
+    bool success = true;
+
+    success = success && short_messages_match_streaming();
+
+    return success ? 0 : -1;
+}